@@ -45,21 +45,187 @@ TERMINATION OF THIS AGREEMENT.
 
 #include "Daidalus.h"
 #include "WCV_tvar.h"
-#include "DaidalusFileWalker.h"
+#include "DaidalusStreamWalker.h"
+#include "DaidalusPipeline.h"
+#include "WorkerPool.h"
+#include <fstream>
+#include <sstream>
+#include <mutex>
 
 using namespace larcfm;
 
+/**
+ * Write alerting information of input_file into CSV file output_file. The Daidalus object
+ * is a copy of the configured one, so that files are independent of each other. Messages
+ * and echoed states are written to log. When pipelined is true, time steps are read, computed,
+ * and written by different threads.
+ */
+static void processFile(Daidalus daa, const std::string& input_file, const std::string& output_file,
+    bool echo, bool pipelined, std::ostream& log) {
+  log << "Processing DAIDALUS file " << input_file << std::endl;
+  log << "Generating CSV file " << output_file << std::endl;
+  DaidalusStreamWalker walker(input_file);
+  int max_alert_level = daa.maxAlertLevel();
+  if (max_alert_level <= 0) {
+    return;
+  }
+  int corrective_level = daa.correctiveAlertLevel(1);
+  Detection3D* detector = daa.getAlerterAt(1).getDetectorPtr(corrective_level);
+  std::string uhor = daa.getUnitsOf("min_horizontal_recovery");
+  std::string uver = daa.getUnitsOf("min_vertical_recovery");
+  std::string uhs = daa.getUnitsOf("step_hs");
+  std::string uvs = daa.getUnitsOf("step_vs");
+
+  std::ofstream csv(output_file.c_str(), std::ios_base::out);
+
+  csv << " Time, Ownship, Traffic, Alerter, Alert Level";
+  if (!daa.isDisabledDTALogic()) {
+    csv << ", DTA Active, DTA Guidance, Distance to DTA";
+  }
+  std::string line_units = "[s],,,,";
+  if (!daa.isDisabledDTALogic()) {
+    line_units += ",,, [nmi]";
+  }
+  for (int level=1; level <= max_alert_level;++level) {
+    csv << ", Time to Volume of Alert(" << level << ")";
+    line_units += ", [s]";
+  }
+  csv << ", Horizontal Separation, Vertical Separation, Horizontal Closure Rate, Vertical Closure Rate, Projected HMD, Projected VMD, Projected TCPA, Projected DCPA, Projected TCOA";
+  line_units += ", ["+uhor+"], ["+uver+"], ["+uhs+"], ["+uvs+"], ["+uhor+"], ["+uver+"], [s], ["+uhor+"], [s]";
+  if (detector != NULL && detector->getSimpleSuperClassName() == "WCV_tvar") {
+    csv << ", Projected TAUMOD (WCV*)";
+    line_units += ", [s]";
+  }
+  csv << std::endl;
+  csv << line_units << std::endl;
+
+  DaidalusPipeline pipeline;
+  if (pipelined) {
+    pipeline.start(walker);
+  }
+  while (pipelined ? pipeline.readState(daa) : !walker.atEnd()) {
+    if (!pipelined) {
+      walker.readState(daa);
+    }
+    if (echo) {
+      pipeline.write(log,daa.toString()+"\n");
+    }
+    std::ostringstream out;
+    // At this point, daa has the state information of ownhsip and traffic for a given time
+    for (int ac=1; ac <= daa.lastTrafficIndex(); ++ac) {
+      int alerter_idx = daa.alerterIndexBasedOnAlertingLogic(ac);
+      const Alerter& alerter = daa.getAlerterAt(alerter_idx);
+      if (!alerter.isValid()) {
+        continue;
+      }
+      out << FmPrecision(daa.getCurrentTime());
+      out << ", " << daa.getOwnshipState().getId();
+      out << ", " << daa.getAircraftStateAt(ac).getId();
+      out << ", " << alerter_idx;
+      int alert = daa.alertLevel(ac);
+      out << ", " << Fmi(alert);
+      if (!daa.isDisabledDTALogic()) {
+        out << ", " << Fmb(daa.isActiveDTALogic());
+        out << ", " << Fmb(daa.isActiveDTASpecialManeuverGuidance());
+        if (daa.getDTARadius() == 0 && daa.getDTAHeight() == 0) {
+          out << ", ";
+        } else {
+          double dh = (daa.isAlertingLogicOwnshipCentric()?
+              daa.getOwnshipState():daa.getAircraftStateAt(ac)).getPosition().distanceH(daa.getDTAPosition());
+          out << ", " << FmPrecision(Units::to("nmi",dh));
+        }
+      }
+      for (int level=1; level <= max_alert_level; ++level) {
+        out << ", ";
+        if (level <= alerter.mostSevereAlertLevel()) {
+          ConflictData det = daa.violationOfAlertThresholds(ac,level);
+          out << FmPrecision(det.getTimeIn());
+        }
+      }
+      out << ", " << FmPrecision(daa.currentHorizontalSeparation(ac,uhor));
+      out << ", " << FmPrecision(daa.currentVerticalSeparation(ac,uver));
+      out << ", " << FmPrecision(daa.horizontalClosureRate(ac,uhs));
+      out << ", " << FmPrecision(daa.verticalClosureRate(ac,uvs));
+      out << ", " << FmPrecision(daa.predictedHorizontalMissDistance(ac,uhor));
+      out << ", " << FmPrecision(daa.predictedVerticalMissDistance(ac,uver));
+      out << ", " << FmPrecision(daa.timeToHorizontalClosestPointOfApproach(ac));
+      out << ", " << FmPrecision(daa.distanceAtHorizontalClosestPointOfApproach(ac,uhor));
+      double tcoa = daa.timeToCoAltitude(ac);
+      out << ", ";
+      if (tcoa >= 0) {
+        out << FmPrecision(tcoa);
+      }
+      out << ", ";
+      if (detector != NULL && detector->getSimpleSuperClassName() == "WCV_tvar") {
+        double tau_mod  = daa.modifiedTau(ac,((WCV_tvar*)detector)->getDTHR());
+        if (tau_mod >= 0) {
+          out << FmPrecision(tau_mod);
+        }
+      }
+      out << std::endl;
+    }
+    pipeline.write(csv,out.str());
+  }
+  pipeline.finish();
+  csv.close();
+}
+
+/**
+ * Processing of input files. When files are processed concurrently, the messages of each
+ * file are buffered and written in the order of the files, as soon as the messages of all
+ * previous files have been written.
+ */
+class AlertingTask : public WorkerTask {
+
+  private:
+  const Daidalus& daa_;
+  const std::vector<std::string>& input_files_;
+  const std::vector<std::string>& output_files_;
+  bool echo_;
+  bool pipelined_;
+  bool buffered_;
+  std::vector<std::string> logs_;
+  std::vector<bool> done_;
+  unsigned int next_;
+  std::mutex mutex_;
+
+  public:
+  AlertingTask(const Daidalus& daa, const std::vector<std::string>& input_files,
+      const std::vector<std::string>& output_files, bool echo, bool pipelined, bool buffered) :
+        daa_(daa), input_files_(input_files), output_files_(output_files), echo_(echo),
+        pipelined_(pipelined), buffered_(buffered), logs_(input_files.size()), done_(input_files.size(),false), next_(0) {}
+
+  void execute(int i) {
+    if (!buffered_) {
+      processFile(daa_,input_files_[i],output_files_[i],echo_,pipelined_,std::cout);
+      return;
+    }
+    std::ostringstream log;
+    processFile(daa_,input_files_[i],output_files_[i],echo_,pipelined_,log);
+    std::lock_guard<std::mutex> lock(mutex_);
+    logs_[i] = log.str();
+    done_[i] = true;
+    for (; next_ < input_files_.size() && done_[next_]; ++next_) {
+      std::cout << logs_[next_] << std::flush;
+      std::string().swap(logs_[next_]);
+    }
+  }
+
+};
+
 int main(int argc, char* argv[]) {
 
   // Declare an empty Daidalus object
   Daidalus daa;
 
-  std::string input_file = "";
+  std::vector<std::string> input_files;
   std::string output_file = "";
   ParameterData params;
   std::string conf = "";
   bool echo = false;
   int precision = 6;
+  int jobs = 1;
+  bool pipelined = false;
 
   for (int a=1;a < argc; ++a) {
     std::string arga = argv[a];
@@ -98,33 +264,36 @@ int main(int argc, char* argv[]) {
       }
     } else if (arga == "--echo" || arga == "-echo") {
       echo = true;
+    } else if (arga == "--pipeline" || arga == "-pipeline") {
+      pipelined = true;
     } else if ((startsWith(arga,"--o") || startsWith(arga,"-o")) && a+1 < argc) {
       output_file = argv[++a];
     } else if (startsWith(arga,"--prec") || startsWith(arga,"-prec")) {
       ++a;
       std::istringstream(argv[a]) >> precision;
+    } else if ((startsWith(arga,"--j") || startsWith(arga,"-j")) && a+1 < argc) {
+      std::istringstream(argv[++a]) >> jobs;
     } else if (startsWith(arga,"-") && arga.find('=') != std::string::npos) {
       std::string keyval = arga.substr(arga.find_last_of('-')+1);
       params.set(keyval);
     } else if (startsWith(arga,"--h") || startsWith(arga,"-h")) {
       std::cerr << "Usage:" << std::endl;
-      std::cerr << "  DaidalusAlerting [<option>] <daa_file>" << std::endl;
+      std::cerr << "  DaidalusAlerting [<option>] <daa_file> ..." << std::endl;
       std::cerr << "  <option> can be" << std::endl;
       std::cerr << "  --config <configuration-file> | no_sum | nom_a | nom_b | cd3d | tcasii\n\tLoad <configuration-file>" << std::endl;
       std::cerr << "  --<var>=<val>\n\t<key> is any configuration variable and val is its value (including units, if any), e.g., --lookahead_time=5[min]" << std::endl;
       std::cerr << "  --output <output_file>\n\tOutput information to <output_file>" << std::endl;
       std::cerr << "  --echo\n\tEcho configuration and traffic list in standard outoput" << std::endl;
       std::cout << "  --precision <n>\n\tOutput decimal precision" << std::endl;
+      std::cerr << "  --jobs <n>\n\tProcess up to <n> files concurrently. Output is the same as with 1 job (default)" << std::endl;
+      std::cerr << "  --pipeline\n\tRead, compute, and write time steps of a file in different threads. Output is the same" << std::endl;
       std::cerr << "  --help\n\tPrint this message" << std::endl;
       exit(0);
     } else if (startsWith(arga,"-")){
       std::cerr << "** Error: Unknown option " << arga << std::endl;
       exit(1);
-    } else if (input_file == "") {
-      input_file = arga;
     } else {
-      std::cerr << "** Error: Only one input file can be provided (" << a << ")" << std::endl;
-      exit(1);
+      input_files.push_back(arga);
     }
   }
   if (daa.numberOfAlerters()==0) {
@@ -135,127 +304,49 @@ int main(int argc, char* argv[]) {
   if (params.size() > 0) {
     daa.setParameterData(params);
   }
-  if (input_file == "") {
+  if (input_files.empty()) {
     if (echo) {
       std::cout << daa.toString() << std::endl;
       exit(0);
     } else {
-      std::cerr << "** Error: One input file must be provided" << std::endl;
+      std::cerr << "** Error: At least one input file must be provided" << std::endl;
       exit(1);
     }
   }
-  std::ifstream file(input_file.c_str());
-  if (!file.good()) {
-    std::cerr << "** Error: File " << input_file << " cannot be read" << std::endl;
-    exit(0);
-  }
-  file.close();
-  std::string name = input_file.substr(input_file.find_last_of("/\\") + 1);
-  std::string scenario = name.substr(0,name.find_last_of("."));
-  if (output_file == "") {
-    output_file = scenario;
-    if (conf != "") {
-      output_file += "_"+conf;
-    }
-    output_file += ".csv";
-  }
-
-  DaidalusParameters::setDefaultOutputPrecision(precision);
-  std::cout << "Processing DAIDALUS file " << input_file << std::endl;
-  std::cout << "Generating CSV file " << output_file << std::endl;
-  DaidalusFileWalker walker(input_file);
-  int max_alert_level = daa.maxAlertLevel();
-  if (max_alert_level <= 0) {
-    return 0;
-  }
-  int corrective_level = daa.correctiveAlertLevel(1);
-  Detection3D* detector = daa.getAlerterAt(1).getDetectorPtr(corrective_level);
-  std::string uhor = daa.getUnitsOf("min_horizontal_recovery");
-  std::string uver = daa.getUnitsOf("min_vertical_recovery");
-  std::string uhs = daa.getUnitsOf("step_hs");
-  std::string uvs = daa.getUnitsOf("step_vs");
-
-  std::ofstream out(output_file.c_str(), std::ios_base::out);
-
-  out << " Time, Ownship, Traffic, Alerter, Alert Level";
-  if (!daa.isDisabledDTALogic()) {
-    out << ", DTA Active, DTA Guidance, Distance to DTA";
-  }
-  std::string line_units = "[s],,,,";
-  if (!daa.isDisabledDTALogic()) {
-    line_units += ",,, [nmi]";
-  }
-  for (int level=1; level <= max_alert_level;++level) {
-    out << ", Time to Volume of Alert(" << level << ")";
-    line_units += ", [s]";
-  }
-  out << ", Horizontal Separation, Vertical Separation, Horizontal Closure Rate, Vertical Closure Rate, Projected HMD, Projected VMD, Projected TCPA, Projected DCPA, Projected TCOA";
-  line_units += ", ["+uhor+"], ["+uver+"], ["+uhs+"], ["+uvs+"], ["+uhor+"], ["+uver+"], [s], ["+uhor+"], [s]";
-  if (detector != NULL && detector->getSimpleSuperClassName() == "WCV_tvar") {
-    out << ", Projected TAUMOD (WCV*)";
-    line_units += ", [s]";
+  if (output_file != "" && input_files.size() > 1) {
+    std::cerr << "** Error: Option --output requires a single input file" << std::endl;
+    exit(1);
   }
-  out << std::endl;
-  out << line_units << std::endl;
-
-  while (!walker.atEnd()) {
-    walker.readState(daa);
-    if (echo) {
-      std::cout << daa.toString() << std::endl;
+  std::vector<std::string> output_files;
+  for (unsigned int i = 0; i < input_files.size(); ++i) {
+    std::string input_file = input_files[i];
+    std::ifstream file(input_file.c_str());
+    if (!file.good()) {
+      std::cerr << "** Error: File " << input_file << " cannot be read" << std::endl;
+      exit(0);
     }
-    // At this point, daa has the state information of ownhsip and traffic for a given time
-    for (int ac=1; ac <= daa.lastTrafficIndex(); ++ac) {
-      int alerter_idx = daa.alerterIndexBasedOnAlertingLogic(ac);
-      const Alerter& alerter = daa.getAlerterAt(alerter_idx);
-      if (!alerter.isValid()) {
-        continue;
-      }
-      out << FmPrecision(daa.getCurrentTime());
-      out << ", " << daa.getOwnshipState().getId();
-      out << ", " << daa.getAircraftStateAt(ac).getId();
-      out << ", " << alerter_idx;
-      int alert = daa.alertLevel(ac);
-      out << ", " << Fmi(alert);
-      if (!daa.isDisabledDTALogic()) {
-        out << ", " << Fmb(daa.isActiveDTALogic());
-        out << ", " << Fmb(daa.isActiveDTASpecialManeuverGuidance());
-        if (daa.getDTARadius() == 0 && daa.getDTAHeight() == 0) {
-          out << ", ";
-        } else {
-          double dh = (daa.isAlertingLogicOwnshipCentric()?
-              daa.getOwnshipState():daa.getAircraftStateAt(ac)).getPosition().distanceH(daa.getDTAPosition());
-          out << ", " << FmPrecision(Units::to("nmi",dh));
-        }
-      }
-      for (int level=1; level <= max_alert_level; ++level) {
-        out << ", ";
-        if (level <= alerter.mostSevereAlertLevel()) {
-          ConflictData det = daa.violationOfAlertThresholds(ac,level);
-          out << FmPrecision(det.getTimeIn());
-        }
-      }
-      out << ", " << FmPrecision(daa.currentHorizontalSeparation(ac,uhor));
-      out << ", " << FmPrecision(daa.currentVerticalSeparation(ac,uver));
-      out << ", " << FmPrecision(daa.horizontalClosureRate(ac,uhs));
-      out << ", " << FmPrecision(daa.verticalClosureRate(ac,uvs));
-      out << ", " << FmPrecision(daa.predictedHorizontalMissDistance(ac,uhor));
-      out << ", " << FmPrecision(daa.predictedVerticalMissDistance(ac,uver));
-      out << ", " << FmPrecision(daa.timeToHorizontalClosestPointOfApproach(ac));
-      out << ", " << FmPrecision(daa.distanceAtHorizontalClosestPointOfApproach(ac,uhor));
-      double tcoa = daa.timeToCoAltitude(ac);
-      out << ", ";
-      if (tcoa >= 0) {
-        out << FmPrecision(tcoa);
+    file.close();
+    if (output_file == "") {
+      std::string name = input_file.substr(input_file.find_last_of("/\\") + 1);
+      std::string scenario = name.substr(0,name.find_last_of("."));
+      output_files.push_back(scenario);
+      if (conf != "") {
+        output_files.back() += "_"+conf;
       }
-      out << ", ";
-      if (detector != NULL && detector->getSimpleSuperClassName() == "WCV_tvar") {
-        double tau_mod  = daa.modifiedTau(ac,((WCV_tvar*)detector)->getDTHR());
-        if (tau_mod >= 0) {
-          out << FmPrecision(tau_mod);
-        }
+      output_files.back() += ".csv";
+    } else {
+      output_files.push_back(output_file);
+    }
+    for (unsigned int j = 0; j < i; ++j) {
+      if (output_files[j] == output_files[i]) {
+        std::cerr << "** Error: Files " << input_files[j] << " and " << input_file << " have the same output file " << output_files[i] << std::endl;
+        exit(1);
       }
-      out << std::endl;
     }
   }
-  out.close();
+
+  DaidalusParameters::setDefaultOutputPrecision(precision);
+  WorkerPool pool(jobs);
+  AlertingTask task(daa,input_files,output_files,echo,pipelined,pool.isParallel());
+  pool.run(task,input_files.size());
 }
@@ -6,9 +6,12 @@
  */
 
 #include "Daidalus.h"
+#include "WorkerPool.h"
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
+#include <mutex>
 #include "DaidalusProcessor.h"
 
 using namespace larcfm;
@@ -47,6 +50,8 @@ public:
 		std::cout << "  --project t\n\tLinearly project all aircraft t seconds for computing bands and alerting" << std::endl;
 		std::cout << "  --<var>=<val>\n\t<key> is any configuration variable and val is its value (including units, if any), e.g., --lookahead_time=5[min]" << std::endl;
 		std::cout << "  --precision <n>\n\tOutput decimal precision" << std::endl;
+		std::cout << "  --jobs <n>\n\tProcess up to <n> files concurrently, each one from the configured parameters. With 1 job (default), parameters set by a file carry over to the next one" << std::endl;
+		std::cout << "  --pipeline\n\tRead, compute, and write time steps of a file in different threads. Output is the same" << std::endl;
 		std::cout << getHelpString() << std::endl;
 		exit(0);
 	}
@@ -71,6 +76,20 @@ public:
 		return s;
 	}
 
+	void fileHeader(Daidalus& daa, const std::string& filename) {
+		switch (format) {
+		case STANDARD:
+			(*out) << "# File: "<< filename << std::endl;
+			break;
+		case PVS:
+			(*out) << "%%% File:\n" << filename << std::endl;
+			(*out) << "%%% Parameters:\n" << daa.getCore().parameters.toPVS() << std::endl;
+			break;
+		default:
+			break;
+		}
+	}
+
 	void header(Daidalus& daa, const std::string& filename) {
 		switch (format) {
 		case STANDARD:
@@ -84,14 +103,16 @@ public:
 
 	void printOutput(Daidalus& daa) {
 		switch (format) {
-		case STANDARD:
-			(*out) << daa.outputString();
+		case STANDARD: {
+			std::string output = daa.outputString();
 			if (raw) {
-				(*out) << daa.rawString();
+				output += daa.rawString();
 			}
+			write(*out,output);
 			break;
+		}
 		case PVS:
-			(*out) << daa.toPVS(false);
+			write(*out,daa.toPVS(false));
 			break;
 		}
 	}
@@ -106,6 +127,47 @@ public:
 
 };
 
+/**
+ * Concurrent processing of input files, where each file is processed by a copy of the configured
+ * Daidalus object, so that files are independent of each other. The output of each file is
+ * buffered and written in the order of the files, as soon as the outputs of all previous files
+ * have been written. Serial processing (1 job) uses a single Daidalus object for all files.
+ */
+class DaidalusBatchTask : public WorkerTask {
+
+private:
+	const DaidalusBatch& walker_;
+	const Daidalus& daa_;
+	const std::vector<std::string>& files_;
+	std::vector<std::string> outputs_;
+	std::vector<bool> done_;
+	unsigned int next_;
+	std::mutex mutex_;
+
+public:
+
+	DaidalusBatchTask(const DaidalusBatch& walker, const Daidalus& daa, const std::vector<std::string>& files) :
+		walker_(walker), daa_(daa), files_(files),
+		outputs_(files.size()), done_(files.size(),false), next_(0) {}
+
+	void execute(int i) {
+		DaidalusBatch walker = walker_;
+		Daidalus daa = daa_;
+		std::ostringstream buffer;
+		walker.out = &buffer;
+		walker.fileHeader(daa,files_[i]);
+		walker.processFile(files_[i],daa);
+		std::lock_guard<std::mutex> lock(mutex_);
+		outputs_[i] = buffer.str();
+		done_[i] = true;
+		for (; next_ < files_.size() && done_[next_]; ++next_) {
+			(*walker_.out) << outputs_[next_];
+			std::string().swap(outputs_[next_]);
+		}
+	}
+
+};
+
 int main(int argc, const char* argv[]) {
 	DaidalusBatch walker;
 	int a;
@@ -114,6 +176,7 @@ int main(int argc, const char* argv[]) {
 	std::string options = "";
 	ParameterData params;
 	int precision = 6;
+	int jobs = 1;
 	for (a=1;a < argc && argv[a][0]=='-'; ++a) {
 		std::string arga = argv[a];
 		options += arga + " ";
@@ -143,6 +206,14 @@ int main(int argc, const char* argv[]) {
 			++a;
 			std::istringstream(argv[a]) >> precision;
 			options += arga+" ";
+		} else if (startsWith(arga,"--jobs") || startsWith(arga,"-jobs") || arga == "-j") {
+			++a;
+			std::istringstream(argv[a]) >> jobs;
+			// Number of jobs doesn't change the output, so it isn't listed in the options
+			options.erase(options.size()-arga.size()-1);
+		} else if (arga == "--pipeline" || arga == "-pipeline") {
+			walker.setPipelined(true);
+			options.erase(options.size()-arga.size()-1);
 		} else if (startsWith(arga,"-") && arga.find('=') != std::string::npos) {
 			std::string keyval = arga.substr(arga.find_last_of('-')+1);
 			params.set(keyval);
@@ -210,20 +281,16 @@ int main(int argc, const char* argv[]) {
 	default:
 		break;
 	}
-	for (unsigned int i=0; i < txtFiles.size(); ++i) {
-		std::string filename(txtFiles[i]);
-		switch (walker.format) {
-		case STANDARD:
-			(*walker.out) << "# File: "<< filename << std::endl;
-			break;
-		case PVS:
-			(*walker.out) << "%%% File:\n" << filename << std::endl;
-			(*walker.out) << "%%% Parameters:\n" << daa.getCore().parameters.toPVS() << std::endl;
-			break;
-		default:
-			break;
+	WorkerPool pool(jobs);
+	if (pool.isParallel()) {
+		DaidalusBatchTask task(walker,daa,txtFiles);
+		pool.run(task,txtFiles.size());
+	} else {
+		for (unsigned int i=0; i < txtFiles.size(); ++i) {
+			std::string filename(txtFiles[i]);
+			walker.fileHeader(daa,filename);
+			walker.processFile(filename,daa);
 		}
-		walker.processFile(filename,daa);
 	}
 	if (output != "") {
 		fout.close();
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2019-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+/**
+ * Round-trip test of DAIDALUS binary files (.daab). Every text file (.daa) is converted into a binary file,
+ * which is walked by a DaidalusFileWalker side by side with a walker of the text file. Times, ownship, and
+ * traffic aircraft read by both walkers must be the same at every time step. Binary files with a truncated
+ * content, a bad header, a bad offset, or a bad block must be rejected.
+ */
+
+#include "Daidalus.h"
+#include "DaidalusFileWalker.h"
+#include "DaidalusBinaryReader.h"
+#include "DaidalusBinaryWriter.h"
+#include "string_util.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+
+using namespace larcfm;
+
+static void printHelpMsg() {
+  std::cout << "Usage:" << std::endl;
+  std::cout << "  DaidalusBinaryTest [flags] files" << std::endl;
+  std::cout << "  flags include:" << std::endl;
+  std::cout << "  --help\n\tPrint this message" << std::endl;
+  std::cout << "  --conf <configuration-file>\n\tLoad <configuration-file>" << std::endl;
+  std::cout << "  --dir <directory>\n\tWrite temporary binary files in <directory>. By default, they are written in the current directory" << std::endl;
+  exit(0);
+}
+
+static bool sameDouble(double a, double b) {
+  return a == b || (a != a && b != b);
+}
+
+static bool sameVect3(const Vect3& a, const Vect3& b) {
+  return sameDouble(a.x,b.x) && sameDouble(a.y,b.y) && sameDouble(a.z,b.z);
+}
+
+static bool samePosition(const Position& a, const Position& b) {
+  return a.isLatLon() == b.isLatLon() && sameDouble(a.x(),b.x()) && sameDouble(a.y(),b.y()) && sameDouble(a.z(),b.z());
+}
+
+static bool sameAircraft(const TrafficState& a, const TrafficState& b) {
+  const SUMData& sa = a.sum();
+  const SUMData& sb = b.sum();
+  return a.getId() == b.getId() && a.isValid() == b.isValid() && a.getAlerterIndex() == b.getAlerterIndex() &&
+      samePosition(a.getPosition(),b.getPosition()) && sameVect3(a.getAirVelocity(),b.getAirVelocity()) &&
+      sameVect3(a.getGroundVelocity(),b.getGroundVelocity()) && sameVect3(a.get_s(),b.get_s()) && sameVect3(a.get_v(),b.get_v()) &&
+      sameDouble(sa.get_s_EW_std(),sb.get_s_EW_std()) && sameDouble(sa.get_s_NS_std(),sb.get_s_NS_std()) &&
+      sameDouble(sa.get_s_EN_std(),sb.get_s_EN_std()) && sameDouble(sa.get_sz_std(),sb.get_sz_std()) &&
+      sameDouble(sa.get_v_EW_std(),sb.get_v_EW_std()) && sameDouble(sa.get_v_NS_std(),sb.get_v_NS_std()) &&
+      sameDouble(sa.get_v_EN_std(),sb.get_v_EN_std()) && sameDouble(sa.get_vz_std(),sb.get_vz_std());
+}
+
+/**
+ * Walk text file and binary file side by side, comparing times, ownship, and traffic aircraft at every time step.
+ * @return number of time steps that differ
+ */
+static int roundTrip(const Daidalus& daa, const std::string& daa_file, const std::string& bin_file) {
+  Daidalus daa_txt(daa);
+  Daidalus daa_bin(daa);
+  DaidalusFileWalker walker_txt(daa_file);
+  DaidalusFileWalker walker_bin(bin_file);
+  if (walker_bin.hasError()) {
+    std::cerr << "** Error: " << walker_bin.getMessage() << std::endl;
+    return 1;
+  }
+  int diffs = 0;
+  int step = 0;
+  for (; !walker_txt.atEnd() && !walker_bin.atEnd(); ++step) {
+    if (walker_txt.getTime() != walker_bin.getTime() || walker_txt.getIndex() != walker_bin.getIndex()) {
+      std::cerr << "** Error: time step " << step << " of " << bin_file << " is at time " << walker_bin.getTime() <<
+          " instead of " << walker_txt.getTime() << std::endl;
+      return diffs+1;
+    }
+    walker_txt.readState(daa_txt);
+    walker_bin.readState(daa_bin);
+    bool same = daa_txt.getCurrentTime() == daa_bin.getCurrentTime() &&
+        daa_txt.numberOfAircraft() == daa_bin.numberOfAircraft() &&
+        sameVect3(daa_txt.getWindVelocityTo(),daa_bin.getWindVelocityTo()) &&
+        daa_txt.getParameterData().toString() == daa_bin.getParameterData().toString();
+    for (int ac = 0; same && ac <= daa_txt.lastTrafficIndex(); ++ac) {
+      same = sameAircraft(daa_txt.getAircraftStateAt(ac),daa_bin.getAircraftStateAt(ac));
+    }
+    if (!same) {
+      std::cerr << "** Error: time step " << step << " of " << bin_file << " differs from " << daa_file << std::endl;
+      ++diffs;
+    }
+  }
+  if (!walker_txt.atEnd() || !walker_bin.atEnd()) {
+    std::cerr << "** Error: " << bin_file << " and " << daa_file << " have a different number of time steps" << std::endl;
+    ++diffs;
+  }
+  return diffs;
+}
+
+static bool readBytes(const std::string& filename, std::string& bytes) {
+  std::ifstream in(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  std::ostringstream content;
+  content << in.rdbuf();
+  bytes = content.str();
+  return true;
+}
+
+static bool writeBytes(const std::string& filename, const std::string& bytes) {
+  std::ofstream out(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  out.write(bytes.data(),bytes.size());
+  return out.good();
+}
+
+template<typename T> T getAt(const std::string& bytes, size_t offset) {
+  T value;
+  std::memcpy(&value,bytes.data()+offset,sizeof(T));
+  return value;
+}
+
+template<typename T> void setAt(std::string& bytes, size_t offset, T value) {
+  std::memcpy(&bytes[offset],&value,sizeof(T));
+}
+
+/**
+ * Check that a corrupted copy of a binary file is rejected, both by DaidalusBinaryReader and by DaidalusFileWalker
+ * @return 1 if the corrupted copy is accepted, 0 otherwise
+ */
+static int reject(const std::string& what, const std::string& bytes, const std::string& bad_file) {
+  if (!writeBytes(bad_file,bytes)) {
+    std::cerr << "** Error: Can't write " << bad_file << std::endl;
+    return 1;
+  }
+  DaidalusBinaryReader reader(bad_file);
+  bool rejected = reader.hasError() && reader.numberOfSteps() == 0;
+  // Files without the magic number are not binary files for DaidalusFileWalker
+  if (rejected && DaidalusBinaryReader::isBinaryFile(bad_file)) {
+    DaidalusFileWalker walker(bad_file);
+    rejected = walker.hasError() && walker.atEnd();
+  }
+  std::remove(bad_file.c_str());
+  if (!rejected) {
+    std::cerr << "** Error: binary file with " << what << " wasn't rejected" << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+/**
+ * Corrupt copies of a valid binary file with at least one time step and check that they are rejected
+ * @return number of corrupted files that are accepted
+ */
+static int negativeCases(const std::string& bin_file, const std::string& bad_file) {
+  std::string bytes;
+  if (!readBytes(bin_file,bytes) || bytes.size() < 88) {
+    std::cerr << "** Error: Can't read " << bin_file << std::endl;
+    return 1;
+  }
+  int errors = 0;
+  // Header: magic number (0), byte order mark (8), version (12), flags (16), counts (20-32), and offsets (40-80)
+  errors += reject("an empty content",bytes.substr(0,0),bad_file);
+  errors += reject("a truncated header",bytes.substr(0,40),bad_file);
+  errors += reject("a truncated content",bytes.substr(0,bytes.size()/2),bad_file);
+  errors += reject("a truncated last byte",bytes.substr(0,bytes.size()-1),bad_file);
+  std::string bad = bytes;
+  bad[0] = 'X';
+  errors += reject("a bad magic number",bad,bad_file);
+  bad = bytes;
+  setAt<uint32_t>(bad,8,getAt<uint32_t>(bytes,8)+1);
+  errors += reject("a bad byte order mark",bad,bad_file);
+  bad = bytes;
+  setAt<uint32_t>(bad,12,getAt<uint32_t>(bytes,12)+1);
+  errors += reject("a bad version",bad,bad_file);
+  bad = bytes;
+  setAt<uint32_t>(bad,20,getAt<uint32_t>(bytes,20)+1000000);
+  errors += reject("a bad number of time steps",bad,bad_file);
+  for (size_t offset = 40; offset <= 80; offset += 8) {
+    bad = bytes;
+    setAt<uint64_t>(bad,offset,bytes.size()+8);
+    errors += reject("a bad offset at byte "+Fmi(offset),bad,bad_file);
+  }
+  // Blocks of time steps
+  uint64_t blocks_offset = getAt<uint64_t>(bytes,48);
+  if (getAt<uint32_t>(bytes,20) == 0 || blocks_offset+16 > bytes.size()) {
+    std::cerr << "** Error: " << bin_file << " has no time step to corrupt" << std::endl;
+    return errors+1;
+  }
+  bad = bytes;
+  setAt<uint64_t>(bad,blocks_offset,0);
+  errors += reject("a block before the header",bad,bad_file);
+  bad = bytes;
+  setAt<uint64_t>(bad,blocks_offset,getAt<uint64_t>(bytes,blocks_offset)+8);
+  errors += reject("a block of bad size",bad,bad_file);
+  bad = bytes;
+  setAt<uint64_t>(bad,blocks_offset+8,bytes.size()+8);
+  errors += reject("a block beyond the end of the file",bad,bad_file);
+  bad = bytes;
+  setAt<uint32_t>(bad,getAt<uint64_t>(bytes,blocks_offset),0xFFFFFFFF);
+  errors += reject("a bad number of aircraft in a block",bad,bad_file);
+  return errors;
+}
+
+int main(int argc, char* argv[]) {
+  Daidalus daa;
+  std::string dir = ".";
+  int a;
+  for (a=1; a < argc && argv[a][0] == '-'; ++a) {
+    std::string arga = argv[a];
+    if (arga == "--help" || arga == "-help" || arga == "-h") {
+      printHelpMsg();
+    } else if ((startsWith(arga,"--c") || startsWith(arga,"-c")) && a+1 < argc) {
+      std::string conf = argv[++a];
+      if (!daa.loadFromFile(conf)) {
+        std::cerr << "** Error: File " << conf << " not found" << std::endl;
+        exit(1);
+      }
+    } else if ((startsWith(arga,"--d") || startsWith(arga,"-d")) && a+1 < argc) {
+      dir = argv[++a];
+    } else {
+      std::cerr << "** Error: Invalid option (" << arga << ")" << std::endl;
+      exit(1);
+    }
+  }
+  if (a == argc) {
+    printHelpMsg();
+  }
+  std::string bin_file = dir+"/DaidalusBinaryTest.daab";
+  std::string bad_file = dir+"/DaidalusBinaryTest_bad.daab";
+  DaidalusBinaryWriter writer;
+  int failures = 0;
+  bool negative = false;
+  for (; a < argc; ++a) {
+    std::string input = argv[a];
+    if (!writer.convert(input,bin_file)) {
+      std::cerr << "** Error: " << writer.getMessage() << std::endl;
+      ++failures;
+      continue;
+    }
+    int diffs = roundTrip(daa,input,bin_file);
+    std::cout << input << ": " << (diffs == 0 ? "OK" : "FAILED") << std::endl;
+    if (diffs > 0) {
+      ++failures;
+    }
+    if (!negative && DaidalusBinaryReader(bin_file).numberOfSteps() > 0) {
+      // Corrupted copies of the first binary file with time steps
+      negative = true;
+      int errors = negativeCases(bin_file,bad_file);
+      std::cout << "Corrupted copies of " << input << ": " << (errors == 0 ? "OK" : "FAILED") << std::endl;
+      if (errors > 0) {
+        ++failures;
+      }
+    }
+    std::remove(bin_file.c_str());
+  }
+  return failures > 0 ? 1 : 0;
+}
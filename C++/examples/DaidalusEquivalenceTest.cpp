@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2019-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+/**
+ * Equivalence test of the optional optimizations of the computation of bands and alerting. Every scenario
+ * is walked by a reference Daidalus object, which is loaded with the given configuration and computes
+ * alerting and bands serially, one kind of bands at a time. Every variant is a copy of the reference
+ * object with one optimization enabled. At every time step, the alert levels, bands, recovery information,
+ * and resolutions of every variant must be exactly the same as the ones of the reference object.
+ */
+
+#include "Daidalus.h"
+#include "DaidalusFileWalker.h"
+#include "string_util.h"
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace larcfm;
+
+static void printHelpMsg() {
+  std::cout << "Usage:" << std::endl;
+  std::cout << "  DaidalusEquivalenceTest [flags] files" << std::endl;
+  std::cout << "  flags include:" << std::endl;
+  std::cout << "  --help\n\tPrint this message" << std::endl;
+  std::cout << "  --conf <configuration-file>\n\tLoad <configuration-file>" << std::endl;
+  std::cout << "  --threads <n>\n\tUse <n> threads in multi-threaded variants (default: 4)" << std::endl;
+  exit(0);
+}
+
+/* Labeled values output by a Daidalus object at a time step */
+typedef std::vector<std::pair<std::string,double> > Output;
+
+static void add(Output& out, const std::string& label, double value) {
+  out.push_back(std::pair<std::string,double>(label,value));
+}
+
+/* Accessors of one kind of bands */
+struct BandsKind {
+  std::string name;
+  int (Daidalus::*length)();
+  Interval (Daidalus::*interval)(int);
+  BandsRegion::Region (Daidalus::*region)(int);
+  RecoveryInformation (Daidalus::*recovery)();
+  double (Daidalus::*resolution)(bool);
+  bool (Daidalus::*preferred)();
+};
+
+static const BandsKind KINDS[4] = {
+    {"Horizontal Direction",&Daidalus::horizontalDirectionBandsLength,&Daidalus::horizontalDirectionIntervalAt,
+        &Daidalus::horizontalDirectionRegionAt,&Daidalus::horizontalDirectionRecoveryInformation,
+        &Daidalus::horizontalDirectionResolution,&Daidalus::preferredHorizontalDirectionRightOrLeft},
+    {"Horizontal Speed",&Daidalus::horizontalSpeedBandsLength,&Daidalus::horizontalSpeedIntervalAt,
+        &Daidalus::horizontalSpeedRegionAt,&Daidalus::horizontalSpeedRecoveryInformation,
+        &Daidalus::horizontalSpeedResolution,&Daidalus::preferredHorizontalSpeedUpOrDown},
+    {"Vertical Speed",&Daidalus::verticalSpeedBandsLength,&Daidalus::verticalSpeedIntervalAt,
+        &Daidalus::verticalSpeedRegionAt,&Daidalus::verticalSpeedRecoveryInformation,
+        &Daidalus::verticalSpeedResolution,&Daidalus::preferredVerticalSpeedUpOrDown},
+    {"Altitude",&Daidalus::altitudeBandsLength,&Daidalus::altitudeIntervalAt,
+        &Daidalus::altitudeRegionAt,&Daidalus::altitudeRecoveryInformation,
+        &Daidalus::altitudeResolution,&Daidalus::preferredAltitudeUpOrDown}
+};
+
+/**
+ * Output alert levels of all traffic aircraft, followed by the bands of every kind
+ */
+static void output(Output& out, Daidalus& daa) {
+  out.clear();
+  add(out,"Time",daa.getCurrentTime());
+  for (int ac = 1; ac <= daa.lastTrafficIndex(); ++ac) {
+    add(out,"Alert Level "+daa.getAircraftStateAt(ac).getId(),daa.alertLevel(ac));
+  }
+  for (int k = 0; k < 4; ++k) {
+    const BandsKind& kind = KINDS[k];
+    int length = (daa.*kind.length)();
+    add(out,kind.name+" Bands",length);
+    for (int i = 0; i < length; ++i) {
+      Interval ii = (daa.*kind.interval)(i);
+      std::string band = kind.name+" Band "+Fmi(i);
+      add(out,band+" Low",ii.low);
+      add(out,band+" Up",ii.up);
+      add(out,band+" Region",BandsRegion::orderOfRegion((daa.*kind.region)(i)));
+    }
+    RecoveryInformation recovery = (daa.*kind.recovery)();
+    add(out,kind.name+" Time to Recovery",recovery.timeToRecovery());
+    add(out,kind.name+" Recovery N Factor",recovery.nFactor());
+    add(out,kind.name+" Recovery Horizontal Distance",recovery.recoveryHorizontalDistance());
+    add(out,kind.name+" Recovery Vertical Distance",recovery.recoveryVerticalDistance());
+    add(out,kind.name+" Resolution Up",(daa.*kind.resolution)(true));
+    add(out,kind.name+" Resolution Down",(daa.*kind.resolution)(false));
+    add(out,kind.name+" Preferred Direction",(daa.*kind.preferred)());
+  }
+}
+
+static bool sameDouble(double a, double b) {
+  return a == b || (a != a && b != b);
+}
+
+/**
+ * Returns the empty string if a and b are the same. Otherwise, returns a description of the first difference.
+ */
+static std::string difference(const Output& a, const Output& b) {
+  for (unsigned int i = 0; i < a.size() && i < b.size(); ++i) {
+    if (a[i].first != b[i].first || !sameDouble(a[i].second,b[i].second)) {
+      std::ostringstream diff;
+      diff << std::setprecision(17) << a[i].first << " = " << a[i].second << " instead of " <<
+          b[i].first << " = " << b[i].second;
+      return diff.str();
+    }
+  }
+  if (a.size() != b.size()) {
+    return "different number of values";
+  }
+  return "";
+}
+
+/**
+ * A copy of the reference object with one optimization enabled
+ */
+class Variant {
+public:
+  virtual ~Variant() {}
+
+  /* Name of the optimization */
+  virtual std::string name() const = 0;
+
+  /* Enable the optimization in daa */
+  virtual void configure(Daidalus& daa) const = 0;
+
+  /* Read the current time step of walker into daa and move walker to the next time step */
+  virtual void read(DaidalusFileWalker& walker, Daidalus& daa) const {
+    walker.readState(daa);
+  }
+
+  /* Compute bands and alerting ahead of their output */
+  virtual void compute(Daidalus& daa) const {}
+};
+
+/* Per-intruder none bands and alert levels are computed concurrently */
+class ThreadsVariant : public Variant {
+  int threads_;
+public:
+  explicit ThreadsVariant(int threads) : threads_(threads) {}
+  std::string name() const { return "Threads ("+Fmi(threads_)+")"; }
+  void configure(Daidalus& daa) const { daa.setNumberOfThreads(threads_); }
+};
+
+/* The four kinds of bands are computed concurrently by computeAllBands before they are output */
+class AllBandsVariant : public Variant {
+  int threads_;
+public:
+  explicit AllBandsVariant(int threads) : threads_(threads) {}
+  std::string name() const { return "All Bands ("+Fmi(threads_)+")"; }
+  void configure(Daidalus& daa) const { daa.setNumberOfThreads(threads_); }
+  void compute(Daidalus& daa) const { daa.computeAllBands(); }
+};
+
+/* Kinematic bands are searched coarse-to-fine, skipping strides where conflict status doesn't change */
+class StrideVariant : public Variant {
+  int stride_;
+public:
+  explicit StrideVariant(int stride) : stride_(stride) {}
+  std::string name() const { return "Search Stride ("+Fmi(stride_)+")"; }
+  void configure(Daidalus& daa) const { daa.setBandsSearchStride(stride_); }
+};
+
+/* Detectors are not evaluated on traffic aircraft that are too far to be in conflict within lookahead time */
+class PreFilterVariant : public Variant {
+public:
+  std::string name() const { return "Traffic Pre-Filter"; }
+  void configure(Daidalus& daa) const { daa.setTrafficPreFilter(true); }
+};
+
+/* Traffic aircraft are set in bulk from tracks, instead of one at a time */
+class BulkVariant : public Variant {
+public:
+  std::string name() const { return "Bulk Traffic States"; }
+  void configure(Daidalus& daa) const {}
+  void read(DaidalusFileWalker& walker, Daidalus& daa) const {
+    // Aircraft states of the time step, as read by the reference object
+    Daidalus scratch(daa);
+    walker.readState(scratch);
+    if (scratch.getParameterData().toString() != daa.getParameterData().toString()) {
+      daa.setParameterData(scratch.getParameterData());
+      daa.reset();
+    }
+    const TrafficState& own = scratch.getOwnshipState();
+    daa.setOwnshipState(own.getId(),own.getPosition(),own.getGroundVelocity(),scratch.getCurrentTime());
+    daa.setAlerterIndex(0,own.getAlerterIndex());
+    setUncertainty(daa,0,own.sum());
+    daa.setWindVelocityTo(scratch.getWindVelocityTo());
+    std::vector<TrafficTrack> tracks;
+    for (int ac = 1; ac <= scratch.lastTrafficIndex(); ++ac) {
+      const TrafficState& traffic = scratch.getAircraftStateAt(ac);
+      tracks.push_back(TrafficTrack(traffic.getId(),traffic.getPosition(),traffic.getGroundVelocity(),
+          scratch.getCurrentTime(),traffic.getAlerterIndex(),traffic.sum()));
+    }
+    daa.setTrafficStates(tracks);
+  }
+private:
+  static void setUncertainty(Daidalus& daa, int ac_idx, const SUMData& sum) {
+    daa.setHorizontalPositionUncertainty(ac_idx,sum.get_s_EW_std(),sum.get_s_NS_std(),sum.get_s_EN_std());
+    daa.setVerticalPositionUncertainty(ac_idx,sum.get_sz_std());
+    daa.setHorizontalVelocityUncertainty(ac_idx,sum.get_v_EW_std(),sum.get_v_NS_std(),sum.get_v_EN_std());
+    daa.setVerticalSpeedUncertainty(ac_idx,sum.get_vz_std());
+  }
+};
+
+/*
+ * Samples of kinematic turn trajectories are computed by rotation between exact samples. Rounding errors
+ * of rotations are orders of magnitude smaller than a step of the bands, which are expected to be the same.
+ */
+class AnchorPeriodVariant : public Variant {
+  int period_;
+public:
+  explicit AnchorPeriodVariant(int period) : period_(period) {}
+  std::string name() const { return "Trajectory Anchor Period ("+Fmi(period_)+")"; }
+  void configure(Daidalus& daa) const { daa.setBandsTrajectoryAnchorPeriod(period_); }
+};
+
+/**
+ * Walk input_file with the reference object and with every variant, comparing their outputs at every time step.
+ * @return number of variants that differ from the reference object
+ */
+static int equivalence(const Daidalus& daa, const std::vector<Variant*>& variants, const std::string& input_file) {
+  Daidalus reference(daa);
+  DaidalusFileWalker walker(input_file);
+  if (walker.hasError()) {
+    std::cerr << "** Error: " << walker.getMessage() << std::endl;
+    return static_cast<int>(variants.size());
+  }
+  std::vector<Daidalus> objects(variants.size(),daa);
+  std::vector<DaidalusFileWalker> walkers(variants.size(),walker);
+  std::vector<int> diffs(variants.size(),0);
+  for (unsigned int v = 0; v < variants.size(); ++v) {
+    variants[v]->configure(objects[v]);
+  }
+  Output ref_out;
+  Output var_out;
+  int step = 0;
+  for (; !walker.atEnd(); ++step) {
+    walker.readState(reference);
+    output(ref_out,reference);
+    for (unsigned int v = 0; v < variants.size(); ++v) {
+      variants[v]->read(walkers[v],objects[v]);
+      variants[v]->compute(objects[v]);
+      output(var_out,objects[v]);
+      std::string diff = difference(var_out,ref_out);
+      if (diff != "" && diffs[v]++ == 0) {
+        std::cerr << "** Error: " << variants[v]->name() << " at time step " << step << " of " << input_file << ": " << diff << std::endl;
+      }
+    }
+  }
+  int failures = 0;
+  for (unsigned int v = 0; v < variants.size(); ++v) {
+    std::cout << input_file << ": " << variants[v]->name() << ": " <<
+        (diffs[v] == 0 ? "OK" : "FAILED ("+Fmi(diffs[v])+" of "+Fmi(step)+" time steps differ)") << std::endl;
+    if (diffs[v] > 0) {
+      ++failures;
+    }
+  }
+  return failures;
+}
+
+int main(int argc, char* argv[]) {
+  Daidalus daa;
+  int threads = 4;
+  int a;
+  for (a=1; a < argc && argv[a][0] == '-'; ++a) {
+    std::string arga = argv[a];
+    if (arga == "--help" || arga == "-help" || arga == "-h") {
+      printHelpMsg();
+    } else if ((startsWith(arga,"--c") || startsWith(arga,"-c")) && a+1 < argc) {
+      std::string conf = argv[++a];
+      if (!daa.loadFromFile(conf)) {
+        std::cerr << "** Error: File " << conf << " not found" << std::endl;
+        exit(1);
+      }
+    } else if ((startsWith(arga,"--t") || startsWith(arga,"-t")) && a+1 < argc) {
+      threads = std::atoi(argv[++a]);
+    } else {
+      std::cerr << "** Error: Invalid option (" << arga << ")" << std::endl;
+      exit(1);
+    }
+  }
+  if (a == argc) {
+    printHelpMsg();
+  }
+  // The reference object computes everything serially and exhaustively
+  daa.setNumberOfThreads(1);
+  daa.setBandsSearchStride(1);
+  daa.setBandsTrajectoryAnchorPeriod(1);
+  daa.setTrafficPreFilter(false);
+  std::vector<Variant*> variants;
+  variants.push_back(new ThreadsVariant(threads));
+  variants.push_back(new AllBandsVariant(threads));
+  variants.push_back(new StrideVariant(2));
+  variants.push_back(new StrideVariant(8));
+  variants.push_back(new PreFilterVariant());
+  variants.push_back(new BulkVariant());
+  variants.push_back(new AnchorPeriodVariant(4));
+  variants.push_back(new AnchorPeriodVariant(16));
+  int failures = 0;
+  for (; a < argc; ++a) {
+    failures += equivalence(daa,variants,argv[a]);
+  }
+  for (unsigned int v = 0; v < variants.size(); ++v) {
+    delete variants[v];
+  }
+  return failures > 0 ? 1 : 0;
+}
@@ -1,6 +1,7 @@
 #include "DaidalusProcessor.h"
 #include "Daidalus.h"
 #include "DaidalusFileWalker.h"
+#include "DaidalusPipeline.h"
 #include "Position.h"
 #include "SequenceReader.h"
 #include "Velocity.h"
@@ -15,6 +16,8 @@ DaidalusProcessor::DaidalusProcessor() {
 	relative_ = 0;
 	options_ = "";
 	ownship_ = "";
+	pipelined_ = false;
+	pipeline_ = NULL;
 }
 
 DaidalusProcessor::DaidalusProcessor(const std::string& own) {
@@ -23,6 +26,8 @@ DaidalusProcessor::DaidalusProcessor(const std::string& own) {
 	relative_ = 0;
 	options_ = "";
 	ownship_ = own;
+	pipelined_ = false;
+	pipeline_ = NULL;
 }
 
 double DaidalusProcessor::getFrom() const {
@@ -41,6 +46,18 @@ std::string DaidalusProcessor::getOwnship() const {
 	return ownship_;
 }
 
+/**
+ * When pipelined is true, time steps of a file are read, computed, and written by
+ * different threads. The output is the same.
+ */
+void DaidalusProcessor::setPipelined(bool pipelined) {
+	pipelined_ = pipelined;
+}
+
+bool DaidalusProcessor::isPipelined() const {
+	return pipelined_;
+}
+
 std::string DaidalusProcessor::getHelpString() {
 	std::string s = "";
 	s += "  --ownship <id>\n\tSet ownship to aircraft with identifier <id>\n";
@@ -108,6 +125,38 @@ std::string DaidalusProcessor::getOptionsString() {
 	return options_;
 }
 
+/**
+ * Time steps of a file walker up to a given time
+ */
+class FileWalkerSource : public DaidalusTimeStepSource {
+private:
+	DaidalusFileWalker& dw_;
+	double to_;
+
+public:
+	FileWalkerSource(DaidalusFileWalker& dw, double to) : dw_(dw), to_(to) {}
+
+	bool readTimeStep(DaidalusTimeStep& step) {
+		return !dw_.atEnd() && dw_.getTime() <= to_ && dw_.readTimeStep(step);
+	}
+};
+
+/**
+ * Reset ownship, if one was given as option.
+ * @return false if there is no state for ownship at time t
+ */
+bool DaidalusProcessor::resetOwnship(Daidalus& daa, double t) {
+	if (ownship_ != "") {
+		daa.resetOwnship(ownship_);
+		if (daa.hasError()) {
+			std::cerr << "** Warning: State for ownship aircraft ("<< ownship_ <<
+					") not found at time. Skipping time " << t << " [s]" << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
 void DaidalusProcessor::processFile(const std::string& filename, Daidalus &daa) {
 	DaidalusFileWalker dw = DaidalusFileWalker(filename);
 	double from = from_;
@@ -125,22 +174,37 @@ void DaidalusProcessor::processFile(const std::string& filename, Daidalus &daa)
 		from = to + relative_;
 	}
 	if (dw.goToTime(from) && from <= to) {
-		while (!dw.atEnd() && dw.getTime() <= to) {
-			double t = dw.getTime();
-			dw.readState(daa);
-			if (ownship_ != "") {
-				daa.resetOwnship(ownship_);
-				if (daa.hasError()) {
-					std::cerr << "** Warning: State for ownship aircraft ("<< ownship_ <<
-							") not found at time. Skipping time " << t << " [s]" << std::endl;
-					continue;
+		if (pipelined_) {
+			FileWalkerSource source(dw,to);
+			DaidalusPipeline pipeline;
+			pipeline_ = &pipeline;
+			pipeline.start(source);
+			while (pipeline.readState(daa)) {
+				if (resetOwnship(daa,daa.getCurrentTime())) {
+					processTime(daa,filename);
+				}
+			}
+			pipeline.finish();
+			pipeline_ = NULL;
+		} else {
+			while (!dw.atEnd() && dw.getTime() <= to) {
+				double t = dw.getTime();
+				dw.readState(daa);
+				if (resetOwnship(daa,t)) {
+					processTime(daa,filename);
 				}
 			}
-			processTime(daa,filename);
 		}
 	}
 }
 
-
-
-
+/**
+ * Write str into out. When time steps are pipelined, str is written by the writer thread.
+ */
+void DaidalusProcessor::write(std::ostream& out, const std::string& str) {
+	if (pipeline_ != NULL) {
+		pipeline_->write(out,str);
+	} else {
+		out << str;
+	}
+}
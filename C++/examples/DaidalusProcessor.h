@@ -9,6 +9,7 @@
 #define DAIDALUSPROCESSOR_H_
 
 #include "Daidalus.h"
+#include "DaidalusPipeline.h"
 #include <vector>
 
 class DaidalusProcessor {
@@ -18,6 +19,10 @@ private:
 	double relative_;
 	std::string options_;
 	std::string ownship_;
+	bool pipelined_;
+	larcfm::DaidalusPipeline* pipeline_;
+
+	bool resetOwnship(larcfm::Daidalus& daa, double t);
 
 public:
 	DaidalusProcessor(const std::string& own);
@@ -26,12 +31,15 @@ public:
 	double getFrom() const;
 	double getTo() const;
 	std::string getOwnship() const;
+	void setPipelined(bool pipelined);
+	bool isPipelined() const;
 	virtual ~DaidalusProcessor() { }
 	static void getFileNames(std::vector<std::string>& txtFiles, const std::vector<std::string>& names, const std::string& ext, int i);
 	static std::string getHelpString();
 	bool processOptions(const char* args[], int i);
 	std::string getOptionsString();
 	void processFile(const std::string& filename, larcfm::Daidalus& daa);
+	void write(std::ostream& out, const std::string& str);
 	virtual void processTime(larcfm::Daidalus& daa, const std::string& filename) = 0;
 };
 
@@ -0,0 +1,869 @@
+/*
+ * Copyright (c) 2019-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+/**
+ * Unit tests of the building blocks of the computation of bands and alerting that can be tested
+ * without a scenario, e.g., the worker pool. Each test prints its name followed by OK or FAILED.
+ * The exit status is the number of failed tests.
+ */
+
+#include "WorkerPool.h"
+#include "IntervalSet.h"
+#include "NoneSetCache.h"
+#include "CDCylinder.h"
+#include "WCV_TAUMOD.h"
+#include "ConflictProbeMemo.h"
+#include "WCV_TCPA.h"
+#include "WCV_TAUMOD_SUM.h"
+#include "DetectionBatch.h"
+#include "AircraftIds.h"
+#include "MofN.h"
+#include "string_util.h"
+#include "Util.h"
+#include "Daidalus.h"
+#include "DaidalusFileWalker.h"
+#include "DaidalusStreamWalker.h"
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <deque>
+#include <stdexcept>
+#include <atomic>
+#include <random>
+
+using namespace larcfm;
+
+// Checks may fail in jobs of a worker pool
+static std::atomic<int> checks_failed(0);
+
+static void check(bool cond, const std::string& what) {
+  if (!cond) {
+    std::cerr << "** Error: " << what << std::endl;
+    ++checks_failed;
+  }
+}
+
+/**** WorkerPool ****/
+
+/* Counts the number of times each job is executed. If fail is non-negative, job fail throws an exception */
+class CountingTask : public WorkerTask {
+public:
+  std::vector<std::atomic<int> > count;
+  int fail;
+  WorkerPool* nested;
+  std::atomic<int> nested_jobs;
+  CountingTask(int n, int f, WorkerPool* pool) : count(n), fail(f), nested(pool), nested_jobs(0) {
+    for (int i = 0; i < n; ++i) {
+      count[i] = 0;
+    }
+  }
+  void execute(int i) {
+    ++count[i];
+    if (i == fail) {
+      throw std::runtime_error("job "+std::to_string(i));
+    }
+    if (nested != NULL) {
+      // A parallel pool that is running executes nested runs serially in the calling thread
+      check(!nested->isParallel() || nested->isRunning(),"parallel pool isn't running during a job");
+      CountingTask inner(3,-1,NULL);
+      nested->run(inner,3);
+      bool once = true;
+      for (int k = 0; k < 3; ++k) {
+        once = once && inner.count[k] == 1;
+      }
+      check(once,"nested jobs aren't executed exactly once");
+      ++nested_jobs;
+    }
+  }
+  bool once() const {
+    for (size_t i = 0; i < count.size(); ++i) {
+      if (count[i] != 1) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+static void testWorkerPool() {
+  for (int threads = 0; threads <= 4; ++threads) {
+    WorkerPool pool(threads);
+    check(pool.getNumberOfThreads() == (threads < 1 ? 1 : threads),"number of threads");
+    check(pool.isParallel() == (threads > 1),"parallel flag");
+    int sizes[] = {0,1,2,7,100};
+    for (int s = 0; s < 5; ++s) {
+      CountingTask task(sizes[s],-1,NULL);
+      pool.run(task,sizes[s]);
+      check(task.once(),"jobs aren't executed exactly once with "+std::to_string(threads)+" threads");
+    }
+    check(!pool.isRunning(),"pool is running after run");
+    // The first exception is rethrown and the pool remains usable
+    CountingTask failing(50,10,NULL);
+    bool thrown = false;
+    try {
+      pool.run(failing,50);
+    } catch (std::runtime_error& e) {
+      thrown = std::string(e.what()) == "job 10";
+    }
+    check(thrown,"exception of a job isn't rethrown by run");
+    check(failing.count[10] == 1,"failing job isn't executed exactly once");
+    for (int i = 0; i < 50; ++i) {
+      check(failing.count[i] <= 1,"job executed more than once after an exception");
+    }
+    CountingTask after(20,-1,NULL);
+    pool.run(after,20);
+    check(after.once(),"pool isn't usable after an exception");
+    // Nested runs
+    CountingTask outer(8,-1,&pool);
+    pool.run(outer,8);
+    check(outer.once() && outer.nested_jobs == 8,"outer jobs of nested runs aren't executed exactly once");
+    // Copies have their own threads
+    WorkerPool copy(pool);
+    CountingTask copied(30,-1,NULL);
+    copy.run(copied,30);
+    check(copy.getNumberOfThreads() == pool.getNumberOfThreads() && copied.once(),"copy of pool");
+  }
+  WorkerPool pool(2);
+  pool.setNumberOfThreads(3);
+  CountingTask task(40,-1,NULL);
+  pool.run(task,40);
+  check(pool.getNumberOfThreads() == 3 && task.once(),"pool after change of number of threads");
+}
+
+/**** IntervalSet ****/
+
+/* Intervals of a set must be ordered and disjoint */
+static bool wellFormed(const IntervalSet& set) {
+  for (int i = 0; i < set.size(); ++i) {
+    if (set.getInterval(i).low > set.getInterval(i).up ||
+        (i > 0 && set.getInterval(i-1).up >= set.getInterval(i).low)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Random set of up to 30 intervals with integer bounds in [0,200], which spills out of the inline buffer */
+static IntervalSet randomSet(std::mt19937& gen, std::vector<bool>& member) {
+  std::uniform_int_distribution<int> count(0,30);
+  std::uniform_int_distribution<int> bound(0,200);
+  IntervalSet set;
+  member.assign(200,false);
+  int n = count(gen);
+  for (int i = 0; i < n; ++i) {
+    int low = bound(gen);
+    int up = std::min(200,low+bound(gen)/10);
+    set.unions(Interval(low,up));
+    for (int k = low; k < up; ++k) {
+      member[k] = true;
+    }
+  }
+  return set;
+}
+
+/* Membership of points k+0.5, which are never bounds of intervals, must be the one of the model */
+static bool sameMembers(const IntervalSet& set, const std::vector<bool>& member) {
+  for (int k = 0; k < 200; ++k) {
+    if (set.in(k+0.5) != member[k]) {
+      return false;
+    }
+  }
+  return wellFormed(set);
+}
+
+/* Set operations must agree with a model of the membership of points */
+static void testIntervalSet() {
+  std::mt19937 gen(2022);
+  for (int n = 0; n < 500; ++n) {
+    std::vector<bool> a, b;
+    IntervalSet sa = randomSet(gen,a);
+    IntervalSet sb = randomSet(gen,b);
+    check(sameMembers(sa,a) && sameMembers(sb,b),"unions of intervals");
+    std::vector<bool> expected(200);
+    IntervalSet set(sa);
+    set.unions(sb);
+    for (int k = 0; k < 200; ++k) {
+      expected[k] = a[k] || b[k];
+    }
+    check(sameMembers(set,expected),"unions of sets");
+    set = sa;
+    set.almost_unions(sb,PRECISION_DEFAULT);
+    check(sameMembers(set,expected),"almost_unions of sets");
+    set = sa;
+    set.almost_intersect(sb);
+    for (int k = 0; k < 200; ++k) {
+      expected[k] = a[k] && b[k];
+    }
+    check(sameMembers(set,expected),"almost_intersect of sets");
+    set = sa;
+    set.diff(sb);
+    for (int k = 0; k < 200; ++k) {
+      expected[k] = a[k] && !b[k];
+    }
+    check(sameMembers(set,expected),"diff of sets");
+    // Sets in the heap are copied and assigned to sets in the inline buffer and vice versa
+    IntervalSet small;
+    small.unions(Interval(1,2));
+    small = sa;
+    check(sameMembers(small,a) && sameMembers(sa,a),"assignment of sets");
+    IntervalSet copy(sb);
+    copy.almost_intersect(small);
+    check(sameMembers(sb,b),"copy of sets");
+    check(IntervalSet(sa.toVector()).toString() == sa.toString(),"vector of intervals");
+  }
+}
+
+/**** parse_double ****/
+
+/* Parser of doubles with a stream, which is the reference behavior of parse_double */
+static double streamDouble(const std::string& str) {
+  std::istringstream stream(str);
+  double d;
+  stream >> d;
+  return stream.fail() ? 0.0 : d;
+}
+
+/* Both versions of parse_double must return the bits of the stream parser */
+static void checkParseDouble(const std::string& str) {
+  double expected = streamDouble(str);
+  double d = Util::parse_double(str);
+  double p = Util::parse_double(str.data(),str.data()+str.size());
+  check(std::memcmp(&expected,&d,sizeof(double)) == 0 && std::memcmp(&expected,&p,sizeof(double)) == 0,
+      "parse_double(\""+str+"\")");
+}
+
+static void testParseDouble() {
+  const char* cases[] = {"","0","-0","+1","1.","1.5e3","1E3","1e-400","1e400","4.9e-324","1.7976931348623157e308",
+      "abc","12abc","-","+",".5","5.",".","-.5e-2","1e","1e+","1e-","0x1p3","nan","inf"," 3","3 ","00012.5000",
+      "123456789012345678901234","9007199254740993","18446744073709551615","0.1","4.35","33.814939600000000",
+      "-117.000000000000000","0.0000000000000000000000001","1234567890123456789.5e-3"};
+  for (unsigned int i = 0; i < sizeof(cases)/sizeof(cases[0]); ++i) {
+    checkParseDouble(cases[i]);
+  }
+  std::mt19937 gen(2025);
+  std::uniform_real_distribution<double> mantissa(-0.5,0.5);
+  std::uniform_int_distribution<int> exponent(-15,15);
+  std::uniform_int_distribution<int> precision(0,17);
+  std::uniform_int_distribution<int> kind(0,3);
+  char buffer[64];
+  for (int n = 0; n < 200000; ++n) {
+    double value = mantissa(gen)*std::pow(10.0,exponent(gen));
+    switch (kind(gen)) {
+    case 0: std::snprintf(buffer,sizeof(buffer),"%.*f",precision(gen)%12,value); break;
+    case 1: std::snprintf(buffer,sizeof(buffer),"%.*e",precision(gen),value); break;
+    case 2: std::snprintf(buffer,sizeof(buffer),"%.17g",value); break;
+    default: std::snprintf(buffer,sizeof(buffer),"%d",static_cast<int>(gen()%2000001)-1000000); break;
+    }
+    checkParseDouble(buffer);
+  }
+}
+
+/**** AircraftIds ****/
+
+/* Handles of ids must be the ones of a map from ids to their order of interning, across rehashing */
+static void testAircraftIds() {
+  AircraftIds ids;
+  std::map<std::string,int> handles;
+  check(ids.size() == 0 && ids.find("AC1") == -1,"empty table");
+  for (int round = 0; round < 2; ++round) {
+    for (int i = 0; i < 1000; ++i) {
+      // Similar ids, the empty id, and ids that are interned again
+      std::string id = i % 7 == 0 ? "AC"+std::to_string(i/7) : i % 101 == 0 ? "" : "N"+std::to_string(i*31 % 500);
+      check(ids.find(id) == (handles.count(id) > 0 ? handles[id] : -1),"find before intern");
+      if (handles.count(id) == 0) {
+        int handle = static_cast<int>(handles.size());
+        handles[id] = handle;
+      }
+      check(ids.intern(id) == handles[id],"handle of interned id");
+      check(ids.find(id) == handles[id] && ids.id(handles[id]) == id,"find after intern");
+    }
+    check(ids.size() == static_cast<int>(handles.size()),"number of ids");
+    AircraftIds copy(ids);
+    std::map<std::string,int>::const_iterator ptr;
+    for (ptr = handles.begin(); ptr != handles.end(); ++ptr) {
+      check(copy.find(ptr->first) == ptr->second && copy.id(ptr->second) == ptr->first,"find in copy");
+    }
+    check(copy.find("unknown") == -1,"find of unknown id");
+    // Handles are not valid after clear
+    ids.clear();
+    handles.clear();
+    check(ids.size() == 0 && ids.find("AC1") == -1,"table after clear");
+  }
+}
+
+/**** MofN ****/
+
+/* M of N logic on a queue of the last N values */
+class MofNModel {
+  int m_;
+  int n_;
+  int max_;
+  std::deque<int> queue_;
+public:
+  MofNModel(int m, int n, int val) : m_(m), n_(n) {
+    reset(val);
+  }
+  void reset(int val) {
+    queue_.clear();
+    max_ = val;
+    for (int i = 0; i < n_; ++i) {
+      queue_.push_back(i < m_ ? val : -1);
+    }
+  }
+  int m_of_n(int value) {
+    if (queue_.empty() || m_ <= 0 || m_ > n_) {
+      return value;
+    }
+    max_ = std::max(max_,value);
+    queue_.pop_front();
+    queue_.push_back(value);
+    for (int i = max_; i >= 0; --i) {
+      int count = 0;
+      for (size_t k = 0; k < queue_.size(); ++k) {
+        if (queue_[k] >= i) {
+          ++count;
+        }
+      }
+      if (count >= m_) {
+        return i;
+      }
+    }
+    return max_ < 0 ? max_ : -1;
+  }
+};
+
+/* Values beyond the levels counted with bit masks, invalid M and N, and resets must follow the model */
+static void testMofN() {
+  std::mt19937 gen(2023);
+  std::uniform_int_distribution<int> value(-2,2*MofN::LEVELS);
+  std::uniform_int_distribution<int> size(0,MofN::MAX_N);
+  std::uniform_int_distribution<int> percent(0,99);
+  for (int t = 0; t < 2000; ++t) {
+    int n = t % 10 == 0 ? MofN::MAX_N : size(gen) % 12;
+    int m = size(gen) % (n+2);
+    int val = value(gen);
+    MofN mofn(m,n,val);
+    MofNModel model(m,n,val);
+    check(mofn.isValid() == (m > 0 && m <= n),"valid M of N");
+    for (int s = 0; s < 100; ++s) {
+      int v = value(gen);
+      if (percent(gen) < 5) {
+        mofn.reset(v);
+        model.reset(v);
+      } else {
+        check(mofn.m_of_n(v) == model.m_of_n(v),"M of N value");
+      }
+    }
+    MofN copy(mofn);
+    check(copy.sameAs(mofn) && copy.toString() == mofn.toString(),"copy of M of N");
+  }
+}
+
+/**** NoneSetCache ****/
+
+static IntervalSet noneSet(double low, double up) {
+  IntervalSet noneset;
+  noneset.unions(Interval(low,up));
+  return noneset;
+}
+
+static void testNoneSetCache() {
+  CDCylinder det;
+  CDCylinder other(det);
+  TrafficState own = TrafficState::makeOwnship("own",Position::makeLatLonAlt(33.8,"deg",-117.0,"deg",17000,"ft"),
+      Velocity::makeTrkGsVs(0,"deg",0,"knot",0,"fpm"));
+  TrafficState ac1 = own.makeIntruder("ac1",Position::makeLatLonAlt(33.9,"deg",-117.0,"deg",17000,"ft"),
+      Velocity::makeTrkGsVs(180,"deg",200,"knot",0,"fpm"));
+  TrafficState ac2 = own.makeIntruder("ac2",Position::makeLatLonAlt(33.8,"deg",-116.9,"deg",17500,"ft"),
+      Velocity::makeTrkGsVs(270,"deg",150,"knot",0,"fpm"));
+  TrafficState ac1_moved = own.makeIntruder("ac1",Position::makeLatLonAlt(33.89,"deg",-117.0,"deg",17000,"ft"),
+      Velocity::makeTrkGsVs(180,"deg",200,"knot",0,"fpm"));
+  NoneSetCache cache;
+  IntervalSet noneset;
+  check(!cache.lookup(noneset,ac1,&det,NULL,0,0,0,300),"lookup before begin");
+  cache.begin(own,0,360,0,0,true);
+  check(!cache.lookup(noneset,ac1,&det,NULL,0,0,0,300),"lookup of empty cache");
+  cache.store(noneSet(10,20),ac1,&det,NULL,0,0,0,300);
+  cache.store(noneSet(30,40),ac2,&det,NULL,0,0,0,300);
+  check(cache.lookup(noneset,ac1,&det,NULL,0,0,0,300) && noneset.toString() == noneSet(10,20).toString(),
+      "lookup of stored entry");
+  // Every input of the computation is part of the key
+  check(!cache.lookup(noneset,ac1_moved,&det,NULL,0,0,0,300),"lookup of moved aircraft");
+  check(!cache.lookup(noneset,ac1,&other,NULL,0,0,0,300),"lookup with copied detector");
+  check(!cache.lookup(noneset,ac1,&det,&det,0,0,0,300),"lookup with another recovery detector");
+  check(!cache.lookup(noneset,ac1,&det,NULL,1,0,0,300),"lookup with another horizontal epsilon");
+  check(!cache.lookup(noneset,ac1,&det,NULL,0,-1,0,300),"lookup with another vertical epsilon");
+  check(!cache.lookup(noneset,ac1,&det,NULL,0,0,10,300),"lookup with another time B");
+  check(!cache.lookup(noneset,ac1,&det,NULL,0,0,0,200),"lookup with another time T");
+  cache.end();
+  // Same ownship and range: entries are kept across computations
+  cache.begin(own,0,360,0,0,true);
+  check(cache.lookup(noneset,ac1,&det,NULL,0,0,0,300) && noneset.toString() == noneSet(10,20).toString(),
+      "entry isn't kept for the same ownship");
+  cache.end();
+  // Entries that are not used by a computation are removed
+  cache.begin(own,0,360,0,0,true);
+  check(!cache.lookup(noneset,ac2,&det,NULL,0,0,0,300),"unused entry isn't removed");
+  check(cache.lookup(noneset,ac1,&det,NULL,0,0,0,300),"used entry is removed");
+  cache.end();
+  // A change of range or ownship state removes every entry
+  cache.begin(own,0,360,0,0,false);
+  check(!cache.lookup(noneset,ac1,&det,NULL,0,0,0,300),"entry is kept for another range");
+  cache.store(noneSet(10,20),ac1,&det,NULL,0,0,0,300);
+  cache.end();
+  TrafficState own_moved = TrafficState::makeOwnship("own",Position::makeLatLonAlt(33.8,"deg",-117.0,"deg",17100,"ft"),
+      Velocity::makeTrkGsVs(0,"deg",0,"knot",0,"fpm"));
+  cache.begin(own_moved,0,360,0,0,false);
+  check(!cache.lookup(noneset,ac1,&det,NULL,0,0,0,300),"entry is kept for another ownship state");
+  cache.store(noneSet(10,20),ac1,&det,NULL,0,0,0,300);
+  cache.end();
+  // Entries are neither copied nor kept by clear
+  NoneSetCache copy(cache);
+  copy.begin(own_moved,0,360,0,0,false);
+  check(!copy.lookup(noneset,ac1,&det,NULL,0,0,0,300),"entry is copied");
+  copy.end();
+  cache.clear();
+  cache.begin(own_moved,0,360,0,0,false);
+  check(!cache.lookup(noneset,ac1,&det,NULL,0,0,0,300),"entry is kept by clear");
+  cache.end();
+}
+
+/**** ConflictProbeMemo ****/
+
+/* Random relative state of a pair of aircraft that are close enough to be in conflict within 300 s */
+static void randomStates(std::mt19937& gen, Vect3& so, Velocity& vo, Vect3& si, Velocity& vi) {
+  std::uniform_real_distribution<double> pos(-20000,20000);
+  std::uniform_real_distribution<double> alt(-600,600);
+  std::uniform_real_distribution<double> vel(-150,150);
+  std::uniform_real_distribution<double> vz(-10,10);
+  so = Vect3(pos(gen),pos(gen),alt(gen));
+  vo = Velocity::makeVxyz(vel(gen),vel(gen),vz(gen));
+  si = Vect3(pos(gen),pos(gen),alt(gen));
+  vi = Velocity::makeVxyz(vel(gen),vel(gen),vz(gen));
+}
+
+/*
+ * Probes answered from the loss profile of the recovery cylinder must be the ones of conflictSUM, in particular,
+ * for intervals reduced to a point and for bounds at the times of loss. Probes answered from stored probes of
+ * other detectors must be consistent with conflictSUM.
+ */
+static void testConflictProbeMemo() {
+  std::mt19937 gen(2020);
+  std::uniform_real_distribution<double> time(0,300);
+  std::uniform_int_distribution<int> pick(0,3);
+  CDCylinder cyl;
+  WCV_TAUMOD wcv;
+  SUMData sum;
+  Vect3 so, si;
+  Velocity vo, vi;
+  int profiles = 0;
+  int lookups = 0;
+  for (int n = 0; n < 200; ++n) {
+    randomStates(gen,so,vo,si,vi);
+    ConflictProbeMemo::Probes probes;
+    check(probes.store_profile(&cyl,so,vo,si,vi,sum,sum),"cylinder has no loss interval");
+    LossData loss;
+    if (cyl.lossIntervalSUM(loss,so,vo,si,vi,sum,sum) && loss.conflict()) {
+      ++profiles;
+    }
+    for (int p = 0; p < 50; ++p) {
+      // Bounds are random times, times of loss, or the same time
+      double bounds[2];
+      for (int i = 0; i < 2; ++i) {
+        int kind = pick(gen);
+        bounds[i] = kind == 0 ? loss.getTimeIn() : kind == 1 ? loss.getTimeOut() : time(gen);
+      }
+      double B = Util::min(bounds[0],bounds[1]);
+      double T = p % 5 == 0 ? B : Util::max(bounds[0],bounds[1]);
+      if (B < 0 || T < 0) {
+        continue;
+      }
+      bool conflict;
+      check(probes.lookup(conflict,B,T) && conflict == cyl.conflictSUM(so,vo,si,vi,B,T,sum,sum),
+          "probe of loss profile differs from conflictSUM");
+      bool los;
+      check(probes.lookup_los(los,B) && los == cyl.violationAtSUM(so,vo,si,vi,B,sum,sum),
+          "violation of loss profile differs from violationAtSUM");
+    }
+    ConflictProbeMemo::Probes stored;
+    check(!stored.store_profile(&wcv,so,vo,si,vi,sum,sum),"WCV_TAUMOD has a loss interval");
+    for (int p = 0; p < 50; ++p) {
+      double B = time(gen);
+      double T = p % 5 == 0 ? B : time(gen);
+      if (T < B) {
+        std::swap(B,T);
+      }
+      bool expected = wcv.conflictSUM(so,vo,si,vi,B,T,sum,sum);
+      bool conflict;
+      if (stored.lookup(conflict,B,T)) {
+        ++lookups;
+        check(conflict == expected,"stored probe differs from conflictSUM");
+      } else {
+        stored.store(expected,B,T);
+      }
+    }
+  }
+  check(profiles > 0 && lookups > 0,"random states don't exercise the memo");
+}
+
+/**** DetectionBatch ****/
+
+/* Every element of a batch probe must be the conflictSUM of that element */
+static void checkBatch(const Detection3D& det, const SUMData& own_sum, const SUMData& ac_sum, std::mt19937& gen) {
+  std::uniform_real_distribution<double> time(0,300);
+  DetectionBatch batch;
+  std::vector<bool> conflicts;
+  Vect3 so, si;
+  Velocity vo, vi;
+  for (int n = 0; n < 20; ++n) {
+    // The batch is reused, as in the search of kinematic bands
+    batch.clear();
+    for (int i = 0; i < 50; ++i) {
+      randomStates(gen,so,vo,si,vi);
+      double B = time(gen);
+      double T = i % 5 == 0 ? B : time(gen);
+      batch.add(so,vo,B,T);
+    }
+    det.conflictBatchSUM(conflicts,batch,si,vi,own_sum,ac_sum);
+    check(static_cast<int>(conflicts.size()) == batch.size(),det.getCanonicalClassName()+" batch size");
+    for (int i = 0; i < batch.size() && i < static_cast<int>(conflicts.size()); ++i) {
+      check(conflicts[i] == det.conflictSUM(batch.so(i),batch.vo(i),si,vi,batch.B(i),batch.T(i),own_sum,ac_sum),
+          det.getCanonicalClassName()+" batch probe differs from conflictSUM");
+    }
+  }
+}
+
+static void testDetectionBatch() {
+  std::mt19937 gen(2021);
+  SUMData none;
+  SUMData sum;
+  sum.setHorizontalPositionUncertainty(50,50,0);
+  sum.setVerticalPositionUncertainty(10);
+  sum.setHorizontalVelocityUncertainty(2,2,0);
+  sum.setVerticalSpeedUncertainty(1);
+  checkBatch(CDCylinder(),none,none,gen);
+  checkBatch(WCV_TAUMOD(),none,none,gen);
+  checkBatch(WCV_TCPA(),none,none,gen);
+  checkBatch(WCV_TAUMOD_SUM(),none,none,gen);
+  checkBatch(WCV_TAUMOD_SUM(),sum,sum,gen);
+}
+
+/* Alert levels, bands, recovery times, and resolutions computed by daa, with full precision */
+static std::string bandsString(Daidalus& daa) {
+  std::ostringstream out;
+  out << std::setprecision(17);
+  for (int ac = 1; ac <= daa.lastTrafficIndex(); ++ac) {
+    out << daa.alertLevel(ac) << " ";
+  }
+  for (int i = 0; i < daa.horizontalDirectionBandsLength(); ++i) {
+    out << daa.horizontalDirectionIntervalAt(i).toString(17) << daa.horizontalDirectionRegionAt(i) << " ";
+  }
+  out << daa.horizontalDirectionRecoveryInformation().timeToRecovery() << " " <<
+      daa.horizontalDirectionResolution(true) << " " << daa.horizontalDirectionResolution(false) << " ";
+  for (int i = 0; i < daa.horizontalSpeedBandsLength(); ++i) {
+    out << daa.horizontalSpeedIntervalAt(i).toString(17) << daa.horizontalSpeedRegionAt(i) << " ";
+  }
+  out << daa.horizontalSpeedRecoveryInformation().timeToRecovery() << " " <<
+      daa.horizontalSpeedResolution(true) << " " << daa.horizontalSpeedResolution(false) << " ";
+  for (int i = 0; i < daa.verticalSpeedBandsLength(); ++i) {
+    out << daa.verticalSpeedIntervalAt(i).toString(17) << daa.verticalSpeedRegionAt(i) << " ";
+  }
+  out << daa.verticalSpeedRecoveryInformation().timeToRecovery() << " " <<
+      daa.verticalSpeedResolution(true) << " " << daa.verticalSpeedResolution(false) << " ";
+  for (int i = 0; i < daa.altitudeBandsLength(); ++i) {
+    out << daa.altitudeIntervalAt(i).toString(17) << daa.altitudeRegionAt(i) << " ";
+  }
+  out << daa.altitudeRecoveryInformation().timeToRecovery() << " " <<
+      daa.altitudeResolution(true) << " " << daa.altitudeResolution(false);
+  return out.str();
+}
+
+/*
+ * A hovering ownship keeps none sets across time steps. Bands must be the same as the ones computed by a
+ * fresh copy of the object, which doesn't have cached none sets. Some traffic aircraft hover too, others move.
+ * Copies don't keep the state of hysteresis. Therefore, hysteresis is disabled.
+ */
+static void testNoneSetCacheAcrossTimeSteps() {
+  Daidalus daa;
+  daa.set_DO_365A();
+  daa.disableHysteresis();
+  Position so = Position::makeLatLonAlt(33.8,"deg",-117.0,"deg",17000,"ft");
+  Velocity hover = Velocity::makeTrkGsVs(0,"deg",0,"knot",0,"fpm");
+  for (int t = 0; t < 20; ++t) {
+    daa.setOwnshipState("own",so,hover,t);
+    daa.addTrafficState("hover1",Position::makeLatLonAlt(33.82,"deg",-117.0,"deg",17000,"ft"),hover);
+    if (t % 5 != 4) {
+      // Drop a hovering aircraft once in a while
+      daa.addTrafficState("hover2",Position::makeLatLonAlt(33.8,"deg",-117.03,"deg",17300,"ft"),hover);
+    }
+    daa.addTrafficState("mover",Position::makeLatLonAlt(33.9-0.002*t,"deg",-117.0,"deg",17000,"ft"),
+        Velocity::makeTrkGsVs(180,"deg",150,"knot",0,"fpm"));
+    // Copies of an object whose bands are stale compute bands from scratch
+    Daidalus fresh(daa);
+    check(bandsString(daa) == bandsString(fresh),"bands at time "+std::to_string(t)+" differ from the ones of a fresh copy");
+    // Adding an aircraft within a time step reuses the none sets of the others
+    daa.addTrafficState("late",Position::makeLatLonAlt(33.8,"deg",-116.95,"deg",17000,"ft"),
+        Velocity::makeTrkGsVs(270,"deg",100,"knot",0,"fpm"));
+    Daidalus fresh_late(daa);
+    check(bandsString(daa) == bandsString(fresh_late),"bands at time "+std::to_string(t)+
+        " with a late aircraft differ from the ones of a fresh copy");
+  }
+}
+
+/**** Parameter dependencies ****/
+
+/* Change of a parameter of a Daidalus object */
+struct ParameterChange {
+  std::string name;
+  void (*change)(Daidalus& daa);
+};
+
+static const ParameterChange CHANGES[] = {
+    {"lookahead_time",[](Daidalus& daa) { daa.setLookaheadTime(0.8*daa.getLookaheadTime()); }},
+    {"left_hdir",[](Daidalus& daa) { daa.setLeftHorizontalDirection(0.5*daa.getLeftHorizontalDirection()); }},
+    {"max_hs",[](Daidalus& daa) { daa.setMaxHorizontalSpeed(0.8*daa.getMaxHorizontalSpeed()); }},
+    {"max_vs",[](Daidalus& daa) { daa.setMaxVerticalSpeed(0.5*daa.getMaxVerticalSpeed()); }},
+    {"max_alt",[](Daidalus& daa) { daa.setMaxAltitude(0.5*daa.getMaxAltitude()); }},
+    {"below_relative_alt",[](Daidalus& daa) { daa.setBelowRelativeAltitude(1000); }},
+    {"step_hdir",[](Daidalus& daa) { daa.setHorizontalDirectionStep(2*daa.getHorizontalDirectionStep()); }},
+    {"step_hs",[](Daidalus& daa) { daa.setHorizontalSpeedStep(2*daa.getHorizontalSpeedStep()); }},
+    {"step_vs",[](Daidalus& daa) { daa.setVerticalSpeedStep(2*daa.getVerticalSpeedStep()); }},
+    {"step_alt",[](Daidalus& daa) { daa.setAltitudeStep(2*daa.getAltitudeStep()); }},
+    {"horizontal_accel",[](Daidalus& daa) { daa.setHorizontalAcceleration(1.5*daa.getHorizontalAcceleration()); }},
+    {"vertical_accel",[](Daidalus& daa) { daa.setVerticalAcceleration(1.5*daa.getVerticalAcceleration()); }},
+    {"turn_rate",[](Daidalus& daa) { daa.setTurnRate(1.5*daa.getTurnRate()); }},
+    {"bank_angle",[](Daidalus& daa) { daa.setBankAngle(0.5*daa.getBankAngle()); }},
+    {"vertical_rate",[](Daidalus& daa) { daa.setVerticalRate(2*daa.getVerticalRate()); }},
+    {"horizontal_nmac",[](Daidalus& daa) { daa.setHorizontalNMAC(2*daa.getHorizontalNMAC()); }},
+    {"min_horizontal_recovery",[](Daidalus& daa) { daa.setMinHorizontalRecovery(2000+daa.getMinHorizontalRecovery()); }},
+    {"min_vertical_recovery",[](Daidalus& daa) { daa.setMinVerticalRecovery(200+daa.getMinVerticalRecovery()); }},
+    {"recovery_stability_time",[](Daidalus& daa) { daa.setRecoveryStabilityTime(5+daa.getRecoveryStabilityTime()); }},
+    {"conflict_crit",[](Daidalus& daa) { daa.setConflictCriteria(!daa.isEnabledConflictCriteria()); }},
+    {"recovery_crit",[](Daidalus& daa) { daa.setRecoveryCriteria(!daa.isEnabledRecoveryCriteria()); }},
+    {"recovery_hdir",[](Daidalus& daa) {
+      daa.setRecoveryHorizontalDirectionBands(!daa.isEnabledRecoveryHorizontalDirectionBands()); }},
+    {"recovery_alt",[](Daidalus& daa) { daa.setRecoveryAltitudeBands(!daa.isEnabledRecoveryAltitudeBands()); }},
+    {"ca_bands",[](Daidalus& daa) { daa.setCollisionAvoidanceBands(!daa.isEnabledCollisionAvoidanceBands()); }},
+    {"ca_factor",[](Daidalus& daa) { daa.setCollisionAvoidanceBandsFactor(0.5*daa.getCollisionAvoidanceBandsFactor()); }},
+    {"h_pos_z_score",[](Daidalus& daa) { daa.setHorizontalPositionZScore(1+daa.getHorizontalPositionZScore()); }},
+    {"ownship_centric_alerting",[](Daidalus& daa) { daa.setAlertingLogic(!daa.isAlertingLogicOwnshipCentric()); }},
+    {"traffic pre-filter",[](Daidalus& daa) { daa.setTrafficPreFilter(!daa.isEnabledTrafficPreFilter()); }},
+    {"parameter data",[](Daidalus& daa) {
+      ParameterData p = daa.getParameterData();
+      p.set("turn_rate = 2 [deg/s]");
+      p.set("step_vs = 20 [fpm]");
+      daa.setParameterData(p); }}
+};
+
+/* Configuration whose alert levels use spreads, so that alerting depends on bands */
+static void setSpreads(Daidalus& daa) {
+  ParameterData p = daa.getParameterData();
+  std::vector<std::string> keys = p.getKeyList();
+  for (unsigned int i = 0; i < keys.size(); ++i) {
+    if (keys[i].find("spread_hdir") != std::string::npos) {
+      p.set(keys[i]+" = 15 [deg]");
+    } else if (keys[i].find("spread_vs") != std::string::npos) {
+      p.set(keys[i]+" = 500 [fpm]");
+    }
+  }
+  daa.setParameterData(p);
+}
+
+/*
+ * Parameter changes only invalidate the values that depend on them. After every change, alerting and bands
+ * must be the same as the ones of a copy of the object whose cached values are all reset. Copies don't keep
+ * the state of hysteresis. Therefore, hysteresis is disabled.
+ */
+static void testParameterDependencies() {
+  int n = static_cast<int>(sizeof(CHANGES)/sizeof(CHANGES[0]));
+  for (int config = 0; config < 4; ++config) {
+    Daidalus daa;
+    if (config == 0) {
+      daa.set_DO_365A();
+    } else if (config == 1) {
+      daa.set_DO_365B();
+    } else if (config == 2) {
+      daa.set_Buffered_WC_DO_365(true);
+    } else {
+      daa.set_DO_365B();
+      setSpreads(daa);
+    }
+    daa.disableHysteresis();
+    Position so = Position::makeLatLonAlt(33.8,"deg",-117.0,"deg",10000,"ft");
+    Velocity vo = Velocity::makeTrkGsVs(0,"deg",200,"knot",0,"fpm");
+    Position si1 = Position::makeLatLonAlt(33.92,"deg",-117.0,"deg",10300,"ft");
+    Velocity vi1 = Velocity::makeTrkGsVs(180,"deg",150,"knot",-300,"fpm");
+    Position si2 = Position::makeLatLonAlt(33.85,"deg",-116.92,"deg",9800,"ft");
+    Velocity vi2 = Velocity::makeTrkGsVs(270,"deg",180,"knot",0,"fpm");
+    for (int t = 0; t < 2*n; ++t) {
+      daa.setOwnshipState("own",so.linear(vo,t),vo,t);
+      daa.addTrafficState("ac1",si1.linear(vi1,t),vi1);
+      daa.addTrafficState("ac2",si2.linear(vi2,t),vi2);
+      bandsString(daa);
+      const ParameterChange& change = CHANGES[t % n];
+      change.change(daa);
+      Daidalus fresh(daa);
+      fresh.reset();
+      check(bandsString(daa) == bandsString(fresh),"bands of configuration "+std::to_string(config)+" at time "+
+          std::to_string(t)+" after a change of "+change.name+" differ from the ones of a reset copy");
+    }
+  }
+}
+
+/**** Concurrent alerting ****/
+
+/*
+ * Alert levels of traffic aircraft that are computed concurrently must be the same as the serial ones, in
+ * particular, when alert levels use spreads and therefore band probes. Six traffic aircraft converge on ownship
+ * from every direction.
+ */
+static void testConcurrentAlerting() {
+  for (int config = 0; config < 2; ++config) {
+    Daidalus serial;
+    if (config == 0) {
+      serial.set_DO_365A();
+    } else {
+      serial.set_DO_365B();
+    }
+    Daidalus no_spreads(serial);
+    setSpreads(serial);
+    Daidalus concurrent(serial);
+    concurrent.setNumberOfThreads(4);
+    Position so = Position::makeLatLonAlt(33.8,"deg",-117.0,"deg",10000,"ft");
+    Velocity vo = Velocity::makeTrkGsVs(30,"deg",180,"knot",0,"fpm");
+    bool spreads_matter = false;
+    for (int t = 0; t < 48; t += 4) {
+      Daidalus* objects[] = {&serial,&concurrent,&no_spreads};
+      for (int k = 0; k < 3; ++k) {
+        objects[k]->setOwnshipState("own",so.linear(vo,t),vo,t);
+        for (int ac = 0; ac < 6; ++ac) {
+          // Aircraft ac reaches ownship around time 40+5*ac
+          double trk = 60*ac;
+          Velocity vi = Velocity::makeTrkGsVs(trk+180,"deg",150,"knot",ac%2 == 0 ? 0 : -200,"fpm");
+          Position si = so.linear(vo,40+5*ac).linear(vi,-(40+5*ac)).mkZ(Units::from("ft",9800+100*ac));
+          objects[k]->addTrafficState("ac"+std::to_string(ac),si.linear(vi,t),vi);
+        }
+      }
+      std::string serial_bands = bandsString(serial);
+      check(serial_bands == bandsString(concurrent),"concurrent alerting of configuration "+std::to_string(config)+
+          " at time "+std::to_string(t)+" differs from the serial one");
+      spreads_matter = spreads_matter || serial_bands != bandsString(no_spreads);
+    }
+    check(spreads_matter,"spreads of configuration "+std::to_string(config)+" don't change alerting");
+  }
+}
+
+/**** DaidalusStreamWalker ****/
+
+/*
+ * Write a scenario where traffic aircraft appear, disappear, and reappear. Most aircraft are only present
+ * for a few time steps, so that the streaming reader evicts their names.
+ */
+static void writeGapScenario(const std::string& filename, std::mt19937& gen) {
+  std::uniform_real_distribution<double> offset(-0.2,0.2);
+  std::uniform_real_distribution<double> speed(-250,250);
+  std::uniform_int_distribution<int> percent(0,99);
+  std::ofstream out(filename.c_str());
+  out << "NAME, lat, lon, alt, vx, vy, vz, time, alerter, s_EW_std" << std::endl;
+  out << "unitless, [deg], [deg], [ft], [knot], [knot], [fpm], [s], unitless, [m]" << std::endl;
+  out << std::setprecision(17);
+  for (int t = 0; t < 100; ++t) {
+    out << "Ownship, 33.8, -117.0, 17000, 0, 200, 0, " << t << ", 1, 0" << std::endl;
+    for (int ac = 0; ac < 200; ++ac) {
+      // Aircraft GAP0,...,GAP4 are present all the time with gaps, other aircraft ac are present around time ac/2
+      bool present = ac < 5 ? percent(gen) < 70 : t-ac/2 >= 0 && t-ac/2 < 3;
+      if (present) {
+        out << (ac < 5 ? "GAP" : "AC") << ac << ", " << 33.8+offset(gen) << ", " << -117.0+offset(gen) << ", " << 17000+1000*offset(gen) <<
+            ", " << speed(gen) << ", " << speed(gen) << ", 0, " << t << ", " << 1+percent(gen)%2 << ", " <<
+            percent(gen) << std::endl;
+      }
+    }
+  }
+}
+
+/* Streaming walkers must load the same time steps as a walker of the whole file, for any window size */
+static void testDaidalusStreamWalker() {
+  std::mt19937 gen(2024);
+  std::string filename = "DaidalusUnitTest.daa";
+  writeGapScenario(filename,gen);
+  int windows[] = {1,2,5};
+  for (int w = 0; w < 3; ++w) {
+    DaidalusFileWalker file_walker(filename);
+    DaidalusStreamWalker stream_walker(filename,windows[w]);
+    check(!file_walker.hasError() && !stream_walker.hasError(),"walkers of "+filename);
+    Daidalus file_daa;
+    Daidalus stream_daa;
+    int steps = 0;
+    for (; !file_walker.atEnd() && !stream_walker.atEnd(); ++steps) {
+      std::string step = " at time step "+std::to_string(steps)+" with window "+std::to_string(windows[w]);
+      check(file_walker.getTime() == stream_walker.getTime() && file_walker.getIndex() == stream_walker.getIndex(),
+          "time"+step);
+      file_walker.readState(file_daa);
+      stream_walker.readState(stream_daa);
+      // Aircraft that reappear after leaving the window of the streaming reader are ordered as new aircraft
+      bool same = file_daa.numberOfAircraft() == stream_daa.numberOfAircraft();
+      std::vector<std::string> file_order;
+      std::vector<std::string> stream_order;
+      for (int ac = 0; same && ac <= file_daa.lastTrafficIndex(); ++ac) {
+        const TrafficState& a = file_daa.getAircraftStateAt(ac);
+        int idx = ac == 0 ? 0 : stream_daa.aircraftIndex(a.getId());
+        same = idx >= 0;
+        if (same) {
+          const TrafficState& b = stream_daa.getAircraftStateAt(idx);
+          same = a.getId() == b.getId() && a.getPosition() == b.getPosition() &&
+              a.getGroundVelocity() == b.getGroundVelocity() && a.getAlerterIndex() == b.getAlerterIndex() &&
+              a.sum().get_s_EW_std() == b.sum().get_s_EW_std();
+        }
+        if (!startsWith(a.getId(),"GAP")) {
+          file_order.push_back(a.getId());
+        }
+        const std::string& id = stream_daa.getAircraftStateAt(ac).getId();
+        if (!startsWith(id,"GAP")) {
+          stream_order.push_back(id);
+        }
+      }
+      same = same && file_order == stream_order;
+      check(same,"aircraft"+step);
+    }
+    check(file_walker.atEnd() && stream_walker.atEnd() && steps == 100,"number of time steps");
+    check(stream_walker.getReader().size() <= 5*windows[w]+8,"active aircraft of streaming reader");
+  }
+  std::remove(filename.c_str());
+}
+
+static int failures = 0;
+
+static void run(const std::string& name, void (*test)()) {
+  checks_failed = 0;
+  test();
+  std::cout << name << ": " << (checks_failed == 0 ? "OK" : "FAILED") << std::endl;
+  if (checks_failed > 0) {
+    ++failures;
+  }
+}
+
+int main(int argc, char* argv[]) {
+  run("WorkerPool",testWorkerPool);
+  run("IntervalSet",testIntervalSet);
+  run("parse_double",testParseDouble);
+  run("AircraftIds",testAircraftIds);
+  run("MofN",testMofN);
+  run("NoneSetCache",testNoneSetCache);
+  run("NoneSetCache Across Time Steps",testNoneSetCacheAcrossTimeSteps);
+  run("ConflictProbeMemo",testConflictProbeMemo);
+  run("DetectionBatch",testDetectionBatch);
+  run("Parameter Dependencies",testParameterDependencies);
+  run("Concurrent Alerting",testConcurrentAlerting);
+  run("DaidalusStreamWalker",testDaidalusStreamWalker);
+  return failures;
+}
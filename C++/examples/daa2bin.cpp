@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2019-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+/**
+ * Converter of DAIDALUS text files (.daa) into DAIDALUS binary files (.daab), which are read by
+ * DaidalusFileWalker, e.g., in DaidalusBatch, without parsing.
+ */
+
+#include "DaidalusBinaryReader.h"
+#include "DaidalusBinaryWriter.h"
+#include "SequenceReader.h"
+#include "string_util.h"
+#include <iostream>
+#include <cstdlib>
+
+using namespace larcfm;
+
+static void printHelpMsg() {
+  std::cout << "Usage:" << std::endl;
+  std::cout << "  daa2bin [flags] files" << std::endl;
+  std::cout << "  flags include:" << std::endl;
+  std::cout << "  --help\n\tPrint this message" << std::endl;
+  std::cout << "  --out <file>\n\tWrite binary file <file>. By default, the binary file of <name>.daa is <name>.daab" << std::endl;
+  std::cout << "  --check\n\tCheck that the binary file has the same time steps as the text file" << std::endl;
+  exit(0);
+}
+
+static bool sameDouble(double a, double b) {
+  return a == b || (a != a && b != b);
+}
+
+/**
+ * Compare time steps of text file, as walked by DaidalusFileWalker, with the ones of binary file
+ * @return number of differences
+ */
+static int check(const std::string& daa_file, const std::string& bin_file) {
+  SequenceReader sr(daa_file);
+  sr.setWindowSize(1);
+  DaidalusBinaryReader bin(bin_file);
+  std::vector<double> times = sr.sequenceKeys();
+  if (bin.hasError() || (int)times.size() != bin.numberOfSteps()) {
+    std::cerr << "** Error: " << bin_file << " has " << bin.numberOfSteps() << " time steps instead of " << times.size() << std::endl;
+    return 1;
+  }
+  int diffs = 0;
+  for (int step = 0; step < (int)times.size(); ++step) {
+    sr.setActive(times[step]);
+    bool same = bin.getTime(step) == times[step] && bin.size(step) == sr.size();
+    for (int ac = 0; same && ac < sr.size(); ++ac) {
+      Position s = sr.getPosition(ac);
+      Position s_bin = bin.getPosition(step,ac);
+      Velocity v = sr.getVelocity(ac);
+      Velocity v_bin = bin.getVelocity(step,ac);
+      same = bin.getName(step,ac) == sr.getName(ac) &&
+          sameDouble(s.x(),s_bin.x()) && sameDouble(s.y(),s_bin.y()) && sameDouble(s.z(),s_bin.z()) &&
+          sameDouble(s.lat(),s_bin.lat()) && sameDouble(s.lon(),s_bin.lon()) && sameDouble(s.alt(),s_bin.alt()) &&
+          sameDouble(v.x,v_bin.x) && sameDouble(v.y,v_bin.y) && sameDouble(v.z,v_bin.z);
+      std::vector<std::string> columns = sr.getExtraColumnList();
+      ParameterData pd = bin.getExtraColumns(step,ac);
+      for (unsigned int col = 0; same && col < columns.size(); ++col) {
+        if (sr.hasExtraColumnData(times[step],sr.getName(ac),columns[col])) {
+          std::string units = sr.getExtraColumnUnits(columns[col]);
+          if (units == "unitless" || units == "unspecified") {
+            same = pd.contains(columns[col]) && pd.getString(columns[col]) == sr.getExtraColumnString(times[step],sr.getName(ac),columns[col]);
+          } else {
+            same = pd.contains(columns[col]) && sameDouble(pd.getValue(columns[col]),sr.getExtraColumnValue(times[step],sr.getName(ac),columns[col]));
+          }
+        } else {
+          same = !pd.contains(columns[col]);
+        }
+      }
+    }
+    if (!same) {
+      std::cerr << "** Error: time step " << step << " of " << bin_file << " differs from " << daa_file << std::endl;
+      ++diffs;
+    }
+  }
+  return diffs;
+}
+
+int main(int argc, char* argv[]) {
+  std::string output = "";
+  bool do_check = false;
+  int a;
+  for (a=1; a < argc && argv[a][0] == '-'; ++a) {
+    std::string arga = argv[a];
+    if (arga == "--help" || arga == "-help" || arga == "-h") {
+      printHelpMsg();
+    } else if ((startsWith(arga,"--out") || startsWith(arga,"-out") || arga == "-o") && a+1 < argc) {
+      output = argv[++a];
+    } else if (startsWith(arga,"--check") || startsWith(arga,"-check")) {
+      do_check = true;
+    } else {
+      std::cerr << "** Error: Invalid option (" << arga << ")" << std::endl;
+      exit(1);
+    }
+  }
+  if (a == argc) {
+    printHelpMsg();
+  }
+  if (output != "" && a+1 < argc) {
+    std::cerr << "** Error: Option --out requires a single input file" << std::endl;
+    exit(1);
+  }
+  int errors = 0;
+  DaidalusBinaryWriter writer;
+  for (; a < argc; ++a) {
+    std::string input = argv[a];
+    std::string bin_file = output;
+    if (bin_file == "") {
+      std::string::size_type dot = input.find_last_of('.');
+      std::string::size_type dir = input.find_last_of("/\\");
+      if (dot == std::string::npos || (dir != std::string::npos && dot < dir)) {
+        dot = input.size();
+      }
+      bin_file = input.substr(0,dot)+".daab";
+    }
+    if (DaidalusBinaryReader::isBinaryFile(input)) {
+      std::cerr << "** Error: " << input << " is already a binary file" << std::endl;
+      ++errors;
+      continue;
+    }
+    if (!writer.convert(input,bin_file)) {
+      std::cerr << "** Error: " << writer.getMessage() << std::endl;
+      ++errors;
+      continue;
+    }
+    std::cout << "Writing " << bin_file << std::endl;
+    if (do_check && check(input,bin_file) > 0) {
+      ++errors;
+    }
+  }
+  return errors > 0 ? 1 : 0;
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2015-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#ifndef AIRCRAFTIDS_H_
+#define AIRCRAFTIDS_H_
+
+#include <string>
+#include <vector>
+
+namespace larcfm {
+
+/**
+ * Table of interned aircraft identifiers. Every identifier added to the table is assigned a handle,
+ * i.e., a compact integer 0,1,2,... in order of insertion, that remains valid until the table is cleared.
+ * Handles can be used to index dense arrays of per-aircraft data. Identifiers are looked up in constant
+ * expected time through an open addressing hash table.
+ */
+class AircraftIds {
+
+private:
+  // Identifier of every handle
+  std::vector<std::string> ids_;
+  // Hash value of every handle
+  std::vector<unsigned int> hashes_;
+  // Hash table of handles (-1 means empty slot). Size is a power of 2 and at least twice the number of handles
+  std::vector<int> slots_;
+
+  static unsigned int hash(const std::string& id);
+  int slot(const std::string& id, unsigned int h) const;
+  void rehash(int capacity);
+
+public:
+
+  AircraftIds();
+
+  /**
+   * Remove all identifiers. Previous handles are no longer valid.
+   */
+  void clear();
+
+  /**
+   * @return number of interned identifiers. Handles are the integers 0,...,size()-1.
+   */
+  int size() const;
+
+  /**
+   * @return handle of identifier id or -1 if id has not been interned
+   */
+  int find(const std::string& id) const;
+
+  /**
+   * @return handle of identifier id. The identifier is interned if it's not already in the table.
+   */
+  int intern(const std::string& id);
+
+  /**
+   * @return identifier of given handle. Requires 0 <= handle < size().
+   */
+  const std::string& id(int handle) const;
+
+};
+
+}
+
+#endif
@@ -179,6 +179,26 @@ public:
   // treatment of border cases in the generic bands algorithms
 
   virtual ConflictData conflictDetection(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T) const;
+
+  virtual LossData conflictIntervalSUM(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T,
+      const SUMData& own_sum, const SUMData& ac_sum) const;
+
+  /**
+   * Computes the conflicts of a batch with the cylinder in a single loop (SUM data is ignored).
+   */
+  virtual void conflictBatchSUM(std::vector<bool>& conflicts, const DetectionBatch& batch, const Vect3& si, const Velocity& vi,
+      const SUMData& own_sum, const SUMData& ac_sum) const;
+
+  /**
+   * Loss interval with the cylinder, not bounded in time (SUM data is ignored).
+   */
+  virtual bool lossIntervalSUM(LossData& interval, const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi,
+      const SUMData& own_sum, const SUMData& ac_sum) const;
+
+  /**
+   * Conflicts of this detector are exactly the conflicts with the cylinder.
+   */
+  virtual bool criticalCylinder(double& D, double& H, double& TH, double& TV, bool& exact) const;
   double timeOfClosestApproach(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T) const;
 
   /** This returns a pointer to a new instance of this type of Detector3D.  You are responsible for destroying this instance when it is no longer needed. */
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2015-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#ifndef CONFLICTPROBEMEMO_H_
+#define CONFLICTPROBEMEMO_H_
+
+#include "TrafficState.h"
+#include "Detection3D.h"
+#include "LossData.h"
+#include <map>
+#include <vector>
+
+namespace larcfm {
+
+/**
+ * Memo of conflict probes of ownship trajectory steps against traffic aircraft. A probe asks whether
+ * there is a conflict with a detector in a time interval [B,T] for the linear projection of a trajectory
+ * step. Violations at the time of the step are also memoized.
+ *
+ * When the detector characterizes its conflicts by a loss interval (see Detection3D::lossIntervalSUM),
+ * e.g., the recovery cylinder, the memo keeps the loss profile of the step, i.e., its first and last times of
+ * loss, and every probe of the step is answered by comparing the bounds of the probe with those times. Otherwise,
+ * since a conflict in [B,T] is also a conflict in any interval that contains [B,T], and no conflict in [B,T]
+ * means no conflict in any interval contained in [B,T], a probe can be answered from probes of the same step
+ * with different intervals.
+ *
+ * This is useful when the same steps are repeatedly probed with intervals that only differ in one
+ * end point, e.g., in the search of the recovery time of recovery bands.
+ *
+ * Steps are identified by a trajectory index and either a sample index k, e.g., the indices of the ownship
+ * trajectory cache in DaidalusIntegerBands, or a time. The memo is only valid as long as ownship, traffic
+ * aircraft, parameters, and detectors do not change. Aircraft must be added before the memo is used. Probes
+ * of different aircraft can be concurrently looked up and stored, but probes of the same aircraft cannot.
+ */
+class ConflictProbeMemo {
+
+public:
+
+  /* Probes of one step with one detector */
+  class Probes {
+  private:
+    // Intervals with conflict
+    std::vector<std::pair<double,double> > conflict_;
+    // Intervals without conflict
+    std::vector<std::pair<double,double> > free_;
+    // -1: unknown, 0: no violation at time of step, 1: violation at time of step
+    int los_;
+    // -1: unknown, 0: detector has no loss interval, 1: loss interval is known
+    int profile_;
+    LossData loss_;
+
+    /* Conflict status in [B,T] of the loss interval clipped to [B,T], as in Detection3D::conflictSUM */
+    bool loss_conflict(double B, double T) const;
+
+  public:
+    Probes();
+
+    /**
+     * If the conflict status in [B,T] follows from stored probes, set conflict to that status and return true.
+     * Otherwise, return false.
+     */
+    bool lookup(bool& conflict, double B, double T) const;
+
+    /**
+     * Store the conflict status in [B,T].
+     */
+    void store(bool conflict, double B, double T);
+
+    /**
+     * If the violation status at time t of the step is known, set los to that status and return true.
+     * Otherwise, return false.
+     */
+    bool lookup_los(bool& los, double t) const;
+
+    /**
+     * Store the violation status at the time of the step.
+     */
+    void store_los(bool los);
+
+    /**
+     * Store the loss interval of det for the linear projection so,vo of the step against si,vi, unless it is
+     * already known. Return true if det has a loss interval. In this case, every probe of the step can be
+     * looked up.
+     */
+    bool store_profile(const Detection3D* det, const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi,
+        const SUMData& own_sum, const SUMData& ac_sum);
+  };
+
+private:
+
+  /* Probes of the samples of a trajectory. Samples at times k*tstep, where tstep is a fixed time step, are
+   * indexed by k. Other samples are indexed by time */
+  struct Samples {
+    std::vector<Probes> steps;
+    std::vector<std::pair<double,Probes> > others;
+  };
+
+  /* Probes of a traffic aircraft with a detector, indexed by trajectory */
+  struct Table {
+    const Detection3D* det;
+    std::vector<Samples> samples;
+  };
+
+  /* Probes of a traffic aircraft. Aircraft that are added more than once are not memoized */
+  struct Aircraft {
+    bool unique;
+    std::vector<Table> tables;
+    Aircraft() : unique(true) {}
+  };
+
+  std::map<const TrafficState*,Aircraft> aircraft_;
+
+public:
+
+  /**
+   * Remove all aircraft and probes.
+   */
+  void clear();
+
+  /**
+   * Add traffic aircraft to the memo. Probes are only memoized for added aircraft.
+   */
+  void add(const TrafficState& traffic);
+
+  /**
+   * Return probes of traffic with detector det at sample k of trajectory idx, where idx >= 0. If k < 0, the
+   * sample is identified by its time. Return NULL if probes of traffic are not memoized.
+   */
+  Probes* probes(const TrafficState& traffic, const Detection3D* det, int idx, int k, double time);
+
+};
+
+}
+
+#endif
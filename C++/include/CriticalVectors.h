@@ -39,6 +39,9 @@ namespace larcfm {
 
     static std::list<double> verticalSpeeds(const Vect3& s, const Vect3& vo, const Vect3& vi,
                      const double D, const double H, const double T);
+
+    static std::list<double> verticalSpeeds1D(const double sz, const double viz,
+                     const double H, const double B, const double T);
   };
 
 //std::list<Vect2> tracks(const Vect3& s, const Vect3& vo, const Vect3& vi,
@@ -19,6 +19,7 @@
 #include "ErrorLog.h"
 #include "ErrorReporter.h"
 #include "TrafficState.h"
+#include "TrafficTrack.h"
 #include "BandsRegion.h"
 #include "Alerter.h"
 #include "Detection3D.h"
@@ -103,6 +104,35 @@ private:
 
   void stale_bands();
 
+  /*
+   * Cached values that depend on parameters. Ownship trajectories of a dimension are the
+   * kinematic maneuvers used to compute its bands. When they change, the none sets cached
+   * by the bands object of that dimension are cleared. Recovery and resolutions of a dimension
+   * are computed after its none sets, which are kept when only these values change.
+   */
+  enum ParameterDependency {
+    ALERTING_DEP = 1,   // Alerting logic, i.e., detectors, lookahead time, and everything computed by the core
+    HDIR_TRAJ_DEP = 2,  // Ownship trajectories of horizontal direction bands
+    HS_TRAJ_DEP = 4,    // Ownship trajectories of horizontal speed bands
+    VS_TRAJ_DEP = 8,    // Ownship trajectories of vertical speed bands
+    ALT_TRAJ_DEP = 16,  // Ownship trajectories of altitude bands
+    HDIR_RES_DEP = 32,  // Recovery and resolutions of horizontal direction bands
+    HS_RES_DEP = 64,    // Recovery and resolutions of horizontal speed bands
+    VS_RES_DEP = 128,   // Recovery and resolutions of vertical speed bands
+    ALT_RES_DEP = 256,  // Recovery and resolutions of altitude bands
+    HYSTERESIS_DEP = 512, // Hysteresis and persistence logic. Hysteresis data is cleared
+    TRAJ_DEP = 30,      // Ownship trajectories of all bands
+    RES_DEP = 480       // Recovery and resolutions of all bands
+  };
+
+  void invalidate(int deps);
+
+  bool spread_alerting(int deps) const;
+
+  int max_hs_dependency() const;
+
+  int parameter_dependencies(const DaidalusParameters& parameters) const;
+
 public:
   /* Constructors */
 
@@ -231,6 +261,23 @@ public:
    */
   int addTrafficState(const std::string& id, const Position& pos, const Velocity& vel);
 
+  /**
+   * Add or update traffic states in bulk from n tracks. This is the same as calling addTrafficState,
+   * setAlerterIndex, and SUM setters for every track, but cached values are invalidated only once.
+   * Requires ownship to be set. Tracks whose identifier is the same as ownship's are ignored.
+   * @param tracks Array of traffic tracks
+   * @param n Number of tracks
+   * @return Number of traffic states that were set
+   */
+  int setTrafficStates(const TrafficTrack* tracks, int n);
+
+  /**
+   * Add or update traffic states in bulk from a list of tracks.
+   * @param tracks List of traffic tracks
+   * @return Number of traffic states that were set
+   */
+  int setTrafficStates(const std::vector<TrafficTrack>& tracks);
+
   /**
    * Get index of aircraft with given name. Return -1 if no such index exists
    */
@@ -430,6 +477,66 @@ public:
    */
   TrafficState mostUrgentAircraft();
 
+  /* Multi-threaded computation of alerting and bands */
+
+  /**
+   * Set number of threads, including the calling thread, used to compute alerting and bands.
+   * When threads > 1, alert levels and bands contributed by different aircraft are computed
+   * concurrently. Results are identical to the ones computed serially. Default is 1.
+   */
+  void setNumberOfThreads(int threads);
+
+  /**
+   * @return number of threads used to compute bands.
+   */
+  int getNumberOfThreads() const;
+
+  /* Coarse-to-fine search of kinematic bands */
+
+  /**
+   * Set stride, in number of steps, of the coarse-to-fine search of kinematic bands. When stride > 1,
+   * a whole stride is skipped when a bound shows that conflict status doesn't change within it, e.g.,
+   * when traffic is out of horizontal reach of ownship. Other strides are refined down to every step.
+   * Therefore, bands are the same as in the exhaustive search. Default is 1, i.e., every step is checked.
+   */
+  void setBandsSearchStride(int stride);
+
+  /**
+   * @return stride, in number of steps, of the coarse-to-fine search of kinematic bands.
+   */
+  int getBandsSearchStride() const;
+
+  /* Incremental kinematic trajectories */
+
+  /**
+   * Set period, in number of time steps, at which samples of kinematic turn trajectories are computed
+   * exactly. Samples in between are computed by rotating the velocity of the previous sample, which
+   * avoids trigonometric functions but accumulates rounding errors between exact samples. Default is 1,
+   * i.e., every sample is computed exactly.
+   */
+  void setBandsTrajectoryAnchorPeriod(int period);
+
+  /**
+   * @return period, in number of time steps, at which samples of kinematic turn trajectories are computed exactly.
+   */
+  int getBandsTrajectoryAnchorPeriod() const;
+
+  /* Pre-filter of traffic aircraft */
+
+  /**
+   * Enable/disable a conservative pre-filter of traffic aircraft. When enabled, detectors are not
+   * evaluated on aircraft that are horizontally too far from ownship to be in conflict within lookahead
+   * time, assuming that ownship horizontal speed doesn't exceed the largest of its current speed
+   * and the maximum horizontal speed. This saves computation time on large traffic pictures,
+   * where most aircraft are irrelevant. Alerting and bands are not affected. Default is disabled.
+   */
+  void setTrafficPreFilter(bool flag);
+
+  /**
+   * @return true if the conservative pre-filter of traffic aircraft is enabled.
+   */
+  bool isEnabledTrafficPreFilter() const;
+
   /* Computation of contours, a.k.a. blobs, and hazard zones */
 
   /**
@@ -1796,6 +1903,10 @@ public:
    */
   void setDaidalusParameters(const DaidalusParameters& parameters);
 
+  /**
+   * Set parameters from ParameterData. Only cached values that depend on changed parameters
+   * are invalidated.
+   */
   void setParameterData(const ParameterData& p);
 
   const ParameterData getParameterData();
@@ -1869,6 +1980,14 @@ public:
    */
   Interval timeIntervalOfConflict(BandsRegion::Region region);
 
+  /**
+   * Compute horizontal direction, horizontal speed, vertical speed, and altitude bands.
+   * Usually, bands are only computed when needed. This method computes all bands that are
+   * not up to date. When the number of threads is greater than 1, the four kinds of bands
+   * are computed concurrently.
+   */
+  void computeAllBands();
+
   /**
    * @return the number of horizontal direction bands negative if the ownship has not been set
    */
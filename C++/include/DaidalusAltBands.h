@@ -49,10 +49,33 @@ public:
 
   virtual std::pair<Vect3, Velocity> trajectory(const DaidalusParameters& parameters, const TrafficState& ownship, double time, bool dir, int target_step, bool instantaneous) const;
 
-  // In PVS: alt_bands@conflict_free_traj_step
 private:
+  /*
+   * Climb, or descent, profile shared by the target altitudes in one direction. Level-off maneuvers towards
+   * these targets have the same acceleration and constant-rate segments as long as their acceleration segments
+   * are the same. Therefore, loss of separation during the acceleration segment is checked once per profile.
+   * Furthermore, targets that are not reached within the lookahead time only differ beyond the lookahead time,
+   * so they all have the same status.
+   */
+  struct ClimbProfile {
+    bool valid;   // True if t1, a1, and los are set
+    double t1;    // End time of acceleration segment
+    double a1;    // Acceleration of acceleration segment
+    bool los;     // Loss of separation during acceleration segment
+    bool unreachable_valid; // True if unreachable_free is set
+    bool unreachable_free;  // Status of targets that are not reached within the lookahead time
+    ClimbProfile() : valid(false), t1(0), a1(0), los(false), unreachable_valid(false), unreachable_free(false) {}
+  };
+
+  // True if there is a loss of separation at time i*tstep, for some from <= i <= to
+  bool LOS_at_steps(const Detection3D* conflict_det, const Detection3D* recovery_det, double B, double tstep, int from, double to,
+      const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic, int target_step, bool instantaneous) const;
+
+  // In PVS: alt_bands@conflict_free_traj_step
+  // When profiles is not NULL, profiles[0] and profiles[1] are the descent and climb profiles shared by target altitudes
   bool conflict_free_traj_step(const Detection3D* conflict_det, const Detection3D* recovery_det, double B, double T,
-      const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic, int target_step, bool instantaneous) const ;
+      const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic, int target_step, bool instantaneous,
+      ClimbProfile* profiles) const ;
 
   // In PVS: alt_bands@alt_bands_generic
   void alt_bands_generic(std::vector<Integerval>& l,
@@ -60,7 +83,8 @@ private:
       int maxup, const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic, bool instantaneous) const;
 
   int first_nat(int mini, int maxi, bool dir, const Detection3D* conflict_det, const Detection3D* recovery_det,
-      double B, double T,  const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic, bool green, bool instantaneous) const;
+      double B, double T,  const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic, bool green, bool instantaneous,
+      ClimbProfile* profiles) const;
 
   int first_band_alt_generic(const Detection3D* conflict_det, const Detection3D* recovery_det, double B, double T,
       const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic, bool dir, bool green, bool instantaneous) const;
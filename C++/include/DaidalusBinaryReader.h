@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2015-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+/*
+ * DaidalusBinaryReader.h
+ *
+ */
+
+#ifndef DAIDALUSBINARYREADER_H_
+#define DAIDALUSBINARYREADER_H_
+
+#include "MappedFile.h"
+#include "ErrorLog.h"
+#include "ErrorReporter.h"
+#include "ParameterData.h"
+#include "Position.h"
+#include "Velocity.h"
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace larcfm {
+
+/**
+ * Reader of DAIDALUS binary files, as written by DaidalusBinaryWriter. A binary file holds the same
+ * time steps that DaidalusFileWalker reads from a text file, already parsed and in internal units:
+ * <ul>
+ * <li> A block per time step, where aircraft are in the order of the text file. The columns of a block
+ * are aircraft ids, the position and velocity components, and one typed column per extra column.
+ * <li> A table of aircraft ids, a table of extra columns (name, units, and type), and a table of
+ * interned strings.
+ * <li> An index of times and block offsets, which provides random access by time step.
+ * </ul>
+ * The file is memory mapped and values are read in place. Numbers are stored in the byte order of the
+ * machine that wrote the file, which is checked when the file is opened.
+ */
+class DaidalusBinaryReader : public ErrorReporter {
+
+  public:
+  /** Magic number at the beginning of DAIDALUS binary files */
+  static const char MAGIC[8];
+  static const uint32_t VERSION;
+  static const uint32_t BYTE_ORDER_MARK;
+  /** Types of extra columns. Values of real columns are in internal units. */
+  enum ColumnType { REAL_COLUMN = 0, STRING_COLUMN = 1 };
+  /** Header flag of files with geodesic coordinates */
+  static const uint32_t LATLON_FLAG = 1;
+
+  private:
+  std::string filename_;
+  MappedFile file_;
+  mutable ErrorLog error;
+  bool latlon_;
+  uint32_t num_steps_;
+  uint32_t num_ids_;
+  uint32_t num_columns_;
+  uint32_t num_strings_;
+  uint64_t times_offset_;
+  uint64_t blocks_offset_;
+  uint64_t ids_offset_;
+  uint64_t columns_offset_;
+  uint64_t strings_offset_;
+  uint64_t chars_offset_;
+  std::vector<std::string> column_names_;
+  std::vector<std::string> column_units_;
+  std::vector<int> column_types_;
+
+  template<typename T> T at(uint64_t offset) const;
+  bool validate();
+  uint64_t block(int step) const;
+  uint64_t blockSize(uint32_t n) const;
+  std::string stringAt(uint32_t idx) const;
+
+  public:
+  DaidalusBinaryReader();
+
+  explicit DaidalusBinaryReader(const std::string& filename);
+
+  /** Copies of a reader map the file again */
+  DaidalusBinaryReader(const DaidalusBinaryReader& reader);
+
+  DaidalusBinaryReader& operator=(const DaidalusBinaryReader& reader);
+
+  /**
+   * @return true if filename starts with the magic number of DAIDALUS binary files
+   */
+  static bool isBinaryFile(const std::string& filename);
+
+  /**
+   * Open binary file. Any previously opened file is closed.
+   * @return true if the file was successfully opened
+   */
+  bool open(const std::string& filename);
+
+  void close();
+
+  bool isLatLon() const;
+
+  /**
+   * @return number of time steps
+   */
+  int numberOfSteps() const;
+
+  /**
+   * @return time of time step, which is assumed to be valid
+   */
+  double getTime(int step) const;
+
+  /**
+   * @return times of all time steps, in increasing order
+   */
+  std::vector<double> getTimes() const;
+
+  /**
+   * @return number of aircraft in time step
+   */
+  int size(int step) const;
+
+  std::string getName(int step, int ac) const;
+
+  /** Position of aircraft ac in time step, in internal units */
+  Position getPosition(int step, int ac) const;
+
+  /** Velocity of aircraft ac in time step, in internal units */
+  Velocity getVelocity(int step, int ac) const;
+
+  std::vector<std::string> getExtraColumnList() const;
+
+  /**
+   * Values of extra columns of aircraft ac in time step, as DaidalusFileWalker sets them from a text file
+   */
+  ParameterData getExtraColumns(int step, int ac) const;
+
+  bool hasError() const;
+
+  bool hasMessage() const;
+
+  std::string getMessage();
+
+  std::string getMessageNoClear() const;
+
+};
+
+}
+
+#endif /* DAIDALUSBINARYREADER_H_ */
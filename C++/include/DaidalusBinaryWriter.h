@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2015-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+/*
+ * DaidalusBinaryWriter.h
+ *
+ */
+
+#ifndef DAIDALUSBINARYWRITER_H_
+#define DAIDALUSBINARYWRITER_H_
+
+#include "SequenceReader.h"
+#include "ErrorLog.h"
+#include "ErrorReporter.h"
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <fstream>
+
+namespace larcfm {
+
+/**
+ * Writer of DAIDALUS binary files, which are read by DaidalusBinaryReader. The time steps of the binary
+ * file are the ones that DaidalusFileWalker reads from the text file, so that walking either file
+ * yields the same aircraft states and extra column values.
+ */
+class DaidalusBinaryWriter : public ErrorReporter {
+
+  private:
+  mutable ErrorLog error;
+  std::ofstream out_;
+  uint64_t offset_;
+  std::vector<std::string> strings_;
+  std::map<std::string,uint32_t> string_idx_;
+  std::vector<uint32_t> ids_;
+  std::map<std::string,uint32_t> id_idx_;
+
+  uint32_t intern(const std::string& str);
+  uint32_t internId(const std::string& name);
+  void write(const void* data, uint64_t size);
+  void pad();
+  template<typename T> void write(const std::vector<T>& values);
+
+  DaidalusBinaryWriter(const DaidalusBinaryWriter& writer);
+  DaidalusBinaryWriter& operator=(const DaidalusBinaryWriter& writer);
+
+  public:
+  DaidalusBinaryWriter();
+
+  /**
+   * Write the time steps of sr, whose window size is set to 1, into binary file filename.
+   * @return true if the file was successfully written
+   */
+  bool write(SequenceReader& sr, const std::string& filename);
+
+  /**
+   * Convert text file daa_file into binary file filename.
+   * @return true if the file was successfully converted
+   */
+  bool convert(const std::string& daa_file, const std::string& filename);
+
+  bool hasError() const;
+
+  bool hasMessage() const;
+
+  std::string getMessage();
+
+  std::string getMessageNoClear() const;
+
+};
+
+}
+
+#endif /* DAIDALUSBINARYWRITER_H_ */
@@ -16,7 +16,10 @@
 #include "Constants.h"
 #include "NoneUrgencyStrategy.h"
 #include "TrafficState.h"
+#include "TrafficTrack.h"
 #include "DaidalusParameters.h"
+#include "WorkerPool.h"
+#include "AircraftIds.h"
 #include <map>
 #include <vector>
 #include <string>
@@ -26,6 +29,8 @@
 
 namespace larcfm {
 
+class DaidalusSpreadAlerting;
+
 class DaidalusCore {
 
 public:
@@ -44,11 +49,39 @@ public:
   const UrgencyStrategy* get_urgency_strategy() const;
   bool set_urgency_strategy(const UrgencyStrategy* strat);
 
+  /* Pool of threads used to compute bands. The pool is not part of the state of the core, so that it can
+   * be used by computations that only read the core */
+  WorkerPool& worker_pool() const;
+
+  /* Stride of the coarse-to-fine search of kinematic bands (1 means exhaustive search) */
+  int search_stride() const;
+  void set_search_stride(int stride);
+
+  /* Period of exact samples of incrementally computed kinematic trajectories (1 means every sample is exact) */
+  int trajectory_anchor_period() const;
+  void set_trajectory_anchor_period(int period);
+
+  /* Conservative pre-filter of traffic aircraft that are out of reach of ownship (disabled by default) */
+  bool traffic_prefilter() const;
+  void set_traffic_prefilter(bool flag);
+
 private:
 
   /* Strategy for most urgent aircraft */
   const UrgencyStrategy* urgency_strategy_;
 
+  /* Pool of threads used to compute bands */
+  mutable WorkerPool worker_pool_;
+
+  /* Stride of the coarse-to-fine search of kinematic bands */
+  int search_stride_;
+
+  /* Period of exact samples of incrementally computed kinematic trajectories */
+  int trajectory_anchor_period_;
+
+  /* Conservative pre-filter of traffic aircraft */
+  bool traffic_prefilter_;
+
   /**** CACHED VARIABLES ****/
 
   /* Variable to control re-computation of cached values */
@@ -74,18 +107,72 @@ private:
    * NaN means that bands are not computed for that region*/
   bool bands4region_[BandsRegion::NUMBER_OF_CONFLICT_BANDS];
 
+  /**** AIRCRAFT IDENTIFIERS ****/
+
+  /* Interned aircraft identifiers. Handles index traffic_index_ and hysteresis data */
+  AircraftIds aircraft_ids_;
+  /* Index in traffic list per aircraft's handle. It's only meaningful when the aircraft at that index has that id */
+  std::vector<int> traffic_index_;
+
   /**** HYSTERESIS VARIABLES ****/
 
-  // Alerting and DTA hysteresis per aircraft's ids
-  std::map<std::string,HysteresisData> alerting_hysteresis_acs_;
-  std::map<std::string,HysteresisData> dta_hysteresis_acs_;
+  /* Hysteresis data of an aircraft, only meaningful when valid is true */
+  struct AircraftHysteresis {
+    bool valid;
+    HysteresisData data;
+    AircraftHysteresis() : valid(false) {}
+  };
+
+  // Alerting and DTA hysteresis per aircraft's handle
+  std::vector<AircraftHysteresis> alerting_hysteresis_acs_;
+  std::vector<AircraftHysteresis> dta_hysteresis_acs_;
+
+  /**** CONFLICT DETECTION MEMO ****/
+
+  /* Conflict data of an aircraft with a detector in the time interval [B,T] */
+  struct ConflictMemo {
+    const Detection3D* detector;
+    double B;
+    double T;
+    ConflictData data;
+  };
+
+  /* Memoized conflict data of an aircraft, only meaningful when generation is conflict_generation_ */
+  struct AircraftConflicts {
+    int generation;
+    std::vector<ConflictMemo> memo;
+    AircraftConflicts() : generation(-1) {}
+  };
+
+  // Memoized conflict data per aircraft's handle
+  std::vector<AircraftConflicts> conflicts_acs_;
+  // Generation of memoized conflict data. It's incremented every time cached values become stale
+  int conflict_generation_;
+
+  /* Checkers of spread alerting thresholds. One per concurrent task, allocated on demand. They are not copied */
+  std::vector<DaidalusSpreadAlerting*> spread_alerting_;
 
   void copyFrom(const DaidalusCore& core);
   void refresh_mua_eps();
 
+  // Handle of intruder in the conflict detection memo or -1, if intruder is not in the traffic list
+  int memo_handle(const TrafficState& intruder) const;
+
+  // Same as set_traffic_state, but caches are not invalidated
+  int put_traffic_state(const std::string& id, const Position& pos, const Velocity& vel, double time);
+
+  /* Set index in traffic list of aircraft at positions from, from+1, ... of the traffic list */
+  void index_traffic(int from);
+  /* Return hysteresis data of aircraft id in acs, or NULL if there is none */
+  HysteresisData* find_hysteresis(std::vector<AircraftHysteresis>& acs, const std::string& id);
+  const HysteresisData* find_hysteresis(const std::vector<AircraftHysteresis>& acs, const std::string& id) const;
+  /* Set hysteresis data of aircraft id in acs */
+  void set_hysteresis(std::vector<AircraftHysteresis>& acs, const std::string& id, const HysteresisData& hysteresis);
+  std::string hysteresisString(const std::string& name, const std::vector<AircraftHysteresis>& acs) const;
+
 public:
   DaidalusCore();
-  virtual ~DaidalusCore() {};
+  virtual ~DaidalusCore();
   DaidalusCore& operator=(const DaidalusCore& core);
 
   DaidalusCore(const DaidalusCore& core);
@@ -124,7 +211,10 @@ public:
   bool isFresh() const;
 
   /**
-   *  Refresh cached values
+   *  Refresh cached values. Once the core is fresh, bands are computed through a const reference
+   *  to the core, whose const methods, e.g., acs_conflict_bands, alerter_index_of, epsilonH, and
+   *  epsilonV, only read cached values and hysteresis data. Therefore, several bands objects can be
+   *  concurrently computed with the same fresh core.
    */
   void refresh();
 
@@ -136,6 +226,11 @@ public:
    */
   int DTAStatus();
 
+  /**
+   * Same as DTAStatus, but requires a fresh core. This method doesn't modify the core.
+   */
+  int DTAStatus() const;
+
   /**
    * @return most urgent aircraft for implicit coordination
    */
@@ -158,16 +253,31 @@ public:
    */
   int epsilonH(bool recovery_case, const TrafficState& traffic);
 
+  /**
+   * Same as epsilonH, but requires a fresh core. This method doesn't modify the core.
+   */
+  int epsilonH(bool recovery_case, const TrafficState& traffic) const;
+
   /**
    * Returns vertical epsilon for implicit coordination with respect to criteria ac.
    */
   int epsilonV(bool recovery_case, const TrafficState& traffic);
 
+  /**
+   * Same as epsilonV, but requires a fresh core. This method doesn't modify the core.
+   */
+  int epsilonV(bool recovery_case, const TrafficState& traffic) const;
+
   /**
    * Return true if bands are computed for this particular region (0:NEAR, 1:MID, 2: FAR)
    */
   bool bands_for(int region);
 
+  /**
+   * Same as bands_for, but requires a fresh core. This method doesn't modify the core.
+   */
+  bool bands_for(int region) const;
+
   /**
    * Returns actual minimum horizontal separation for recovery bands in internal units.
    */
@@ -189,6 +299,10 @@ public:
 
   void reset_ownship(int idx);
 
+  // Add or update traffic aircraft from n tracks. Caches are invalidated once. Return number of
+  // tracks that were set (tracks whose id is the same as ownship's are ignored)
+  int set_traffic_states(const TrafficTrack* tracks, int n);
+
   // idx is 0-based index in traffic list
   bool remove_traffic(int idx);
 
@@ -240,16 +354,34 @@ private:
 
   int dta_hysteresis_current_value(const TrafficState& ac);
 
+  /* Same as dta_hysteresis_current_value, but hysteresis data is only read */
+  int dta_hysteresis_current_value(const TrafficState& ac) const;
+
+  /* Raw DTA status of aircraft ac, before hysteresis logic is applied */
+  int raw_dta(const TrafficState& ac) const;
+
   int alerting_hysteresis_current_value(const TrafficState& intruder, int turning, int accelerating, int climbing);
 
+  /* Apply alerting hysteresis logic of intruder to raw alert level at current time */
+  int apply_alerting_hysteresis(const TrafficState& intruder, int raw_alert);
+
+  /* Task that computes raw alert levels of traffic aircraft concurrently */
+  struct RawAlertTask;
+
+  /* Compute alert levels of all traffic aircraft at current time */
+  void refresh_alert_levels();
+
   bool greater_than_corrective() const;
 
-  int raw_alert_level(const Alerter& alerter, const TrafficState& intruder, int turning, int accelerating, int climbing);
+  /* Return i-th checker of spread alerting thresholds */
+  DaidalusSpreadAlerting& spread_alerting(int i);
+
+  int raw_alert_level(DaidalusSpreadAlerting& spread, const Alerter& alerter, const TrafficState& intruder, int turning, int accelerating, int climbing);
 
   /**
    * Return true if and only if threshold values, defining an alerting level, are violated.
    */
-  bool check_alerting_thresholds(const Alerter& alerter, int alert_level, const TrafficState& intruder, int turning, int accelerating, int climbing);
+  bool check_alerting_thresholds(DaidalusSpreadAlerting& spread, const Alerter& alerter, int alert_level, const TrafficState& intruder, int turning, int accelerating, int climbing);
 
   /**
    * Requires 0 <= conflict_region < CONFICT_BANDS
@@ -268,6 +400,11 @@ public:
    */
   const std::vector<IndexLevelT>& acs_conflict_bands(int conflict_region);
 
+  /**
+   * Same as acs_conflict_bands, but requires a fresh core. This method doesn't modify the core.
+   */
+  const std::vector<IndexLevelT>& acs_conflict_bands(int conflict_region) const;
+
   /**
    * Requires 0 <= conflict_region < CONFICT_BANDS
    * @return Return time interval of conflict for given conflict region
@@ -275,6 +412,11 @@ public:
    */
   const Interval& tiov(int conflict_region);
 
+  /**
+   * Same as tiov, but requires a fresh core. This method doesn't modify the core.
+   */
+  const Interval& tiov(int conflict_region) const;
+
   /**
    * Return alert index used for intruder aircraft.
    * The alert index depends on alerting logic and DTA logic.
@@ -285,6 +427,35 @@ public:
    */
   int alerter_index_of(const TrafficState& intruder);
 
+  /**
+   * Same as alerter_index_of, but hysteresis data is only read. When the DTA status of
+   * an aircraft is not updated at current time, it's computed on a copy of its hysteresis data.
+   */
+  int alerter_index_of(const TrafficState& intruder) const;
+
+  /**
+   * Returns true if the traffic pre-filter is enabled and intruder is provably not in conflict with ownship,
+   * for the given detector within lookahead time, under any ownship maneuver considered by alerting and bands.
+   * The bound assumes that ownship horizontal speed does not exceed the largest of its current speed and
+   * the maximum horizontal speed, plus wind speed.
+   */
+  bool out_of_reach(const TrafficState& intruder, const Detection3D* detector) const;
+
+  /**
+   * Returns conflict data of ownship and intruder with detector in the time interval [B,T].
+   * When intruder is an aircraft of the traffic list, the result is memoized until cached
+   * values become stale, so that alerting, bands, and on-demand queries of the same cycle
+   * evaluate the detector only once.
+   */
+  ConflictData conflict_detection(const TrafficState& intruder, Detection3D* detector, double B, double T);
+
+  /**
+   * Same as conflict_detection, but the memo is only read. When the conflict data is not
+   * memoized, the detector is called directly. This method doesn't modify the core, so
+   * it can be used by concurrent refreshes of bands.
+   */
+  ConflictData memoized_conflict_detection(const TrafficState& intruder, Detection3D* detector, double B, double T) const;
+
   static int epsilonH(const TrafficState& ownship, const TrafficState& ac);
 
   static int epsilonV(const TrafficState& ownship, const TrafficState& ac);
@@ -13,16 +13,26 @@
 #define DAIDALUSFILEWALKER_H_
 
 #include "SequenceReader.h"
+#include "DaidalusBinaryReader.h"
 #include "ParameterData.h"
 #include "Daidalus.h"
+#include "DaidalusTimeStep.h"
 #include <vector>
 #include <string>
 
 namespace larcfm {
 
-class DaidalusFileWalker : public ErrorReporter {
+/**
+ * Walker of DAIDALUS files, with random access to time steps. Files are either text files or binary
+ * files written by DaidalusBinaryWriter, e.g., by the daa2bin converter. Binary files are memory mapped
+ * and are not parsed.
+ */
+class DaidalusFileWalker : public ErrorReporter, public DaidalusTimeStepSource {
   private:
   SequenceReader sr_;
+  DaidalusBinaryReader bin_;
+  // True if the input file is a binary file, which is read by bin_
+  bool binary_;
   ParameterData p_;
   std::vector<double> times_;
   int index_;
@@ -33,6 +43,7 @@ class DaidalusFileWalker : public ErrorReporter {
   void resetInputFile(const std::string& filename);
 
   private:
+  void open(const std::string& filename);
   void init();
 
   static ParameterData extraColumnsToParameters(const SequenceReader& sr, double time, const std::string& ac_name);
@@ -66,7 +77,17 @@ class DaidalusFileWalker : public ErrorReporter {
 
   static void readExtraColumns(Daidalus& daa, const SequenceReader& sr, int ac_idx);
 
+  static void readExtraColumns(Daidalus& daa, const ParameterData& pcol, int ac_idx);
+
   void readState(Daidalus& daa);
+
+  /**
+   * Store states of current time step into step, as readState loads them into a Daidalus
+   * object, and move to the next time step.
+   * @return false if at end of file
+   */
+  bool readTimeStep(DaidalusTimeStep& step);
+
   bool hasError() const;
 
   bool hasMessage() const;
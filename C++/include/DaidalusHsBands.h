@@ -46,6 +46,13 @@ public:
 
   virtual std::pair<Vect3, Velocity> trajectory(const DaidalusParameters& parameters, const TrafficState& ownship, double time, bool dir, int target_step, bool instantaneous) const;
 
+  virtual void kinematic_trajectory_samples(std::vector<std::pair<Vect3,Velocity> >& samples, const DaidalusParameters& parameters,
+      const TrafficState& ownship, double tstep, bool dir, int maxk) const;
+
+  virtual bool instantaneous_critical_steps(std::vector<double>& ks, const DaidalusParameters& parameters,
+      const TrafficState& ownship, const TrafficState& traffic, bool dir,
+      double D, double H, double B, double T, double TH, double TV, bool exact) const;
+
   virtual double max_delta_resolution(const DaidalusParameters& parameters) const;
 
 };
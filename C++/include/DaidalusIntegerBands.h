@@ -20,6 +20,7 @@
 #include <vector>
 #include <string>
 #include "TrafficState.h"
+#include "ConflictProbeMemo.h"
 
 namespace larcfm {
 
@@ -28,14 +29,171 @@ class DaidalusIntegerBands {
 
   // This class computes NONE bands
 
+private:
+
+  /**** OWNSHIP TRAJECTORY CACHE ****/
+
+  /* Ownship for which the trajectory cache is enabled. NULL means that the cache is disabled */
+  const TrafficState* traj_ownship_;
+  /* Time step of cached trajectory samples. It is 0 when cached trajectories are instantaneous */
+  double traj_tstep_;
+  /* Instantaneous flag of cached trajectories */
+  bool traj_instantaneous_;
+  /* Maximum index k of a cached trajectory sample */
+  int traj_maxk_;
+  /* Cached trajectory samples at times k*traj_tstep_. Trajectory of target step ts in direction dir is
+   * at index 2*ts+dir, where dir is 0 for left/down and 1 for right/up. Samples are computed on demand and
+   * shared by all traffic aircraft */
+  mutable std::vector<std::vector<std::pair<Vect3,Velocity> > > traj_samples_;
+  /* When true, the cache is read-only, i.e., samples that are not in the cache are computed but not stored.
+   * A read-only cache can be safely accessed by concurrent threads */
+  bool traj_frozen_;
+
+  /**** SEARCH OF BANDS ****/
+
+  /* Stride, in number of steps, of the coarse-to-fine search of bands. A value of 1 means exhaustive search */
+  int search_stride_;
+
+  /**** INCREMENTAL TRAJECTORY SAMPLES ****/
+
+  /* Period, in number of samples, at which incremental trajectory samples are computed exactly. A value
+   * of 1 means that every sample is computed exactly */
+  int anchor_period_;
+
+  /**** MEMO OF CONFLICT PROBES ****/
+
+  /* Memo of conflict probes. NULL means that probes are not memoized */
+  ConflictProbeMemo* probe_memo_;
+
+  /**** BATCHES OF CONFLICT PROBES ****/
+
+  /* Reusable buffers of kinematic_CD_future_traj_batch. Memory is kept for the next batch. They are only used
+   * while the trajectory cache is not frozen, since concurrent jobs only run while it is frozen */
+  mutable DetectionBatch batch_;
+  mutable std::vector<int> batch_index_;
+  mutable std::vector<bool> batch_conflict_;
+
+  /* True if trajectory cache is enabled for these inputs. Sets k to the index of the sample, or -1 if it is not cached */
+  bool cached_sample(const TrafficState& ownship, double time, int target_step, bool instantaneous, int& k) const;
+
+  /* Memoized probes of traffic with det at the given ownship trajectory sample, or NULL if probes are not memoized */
+  ConflictProbeMemo::Probes* memoized_probes(const Detection3D* det, const TrafficState& ownship,
+      const TrafficState& traffic, double time, bool dir, int target_step, bool instantaneous) const;
+
 public:
+  /**
+   * Status of a step in a search of bands.
+   */
+  class StepStatus {
+  public:
+    virtual ~StepStatus() {}
+    /* Returns true if step k is conflict free */
+    virtual bool green(int k) const = 0;
+    /* Returns a number n of steps such that steps k+1,...,k+n provably have the same status as step k.
+     * By default, there is no such bound, i.e., n is 0. */
+    virtual int steady_steps(int k) const { return 0; }
+  };
+
+  DaidalusIntegerBands();
+
   // trajdir == false is left/down
   // target_step is used by instantaneous_bands and altitude_bands
   virtual std::pair<Vect3,Velocity> trajectory(const DaidalusParameters& parameters, const TrafficState& ownship,
       double time, bool dir, int target_step, bool instantaneous) const = 0;
 
+  /**
+   * Add to ks the (real) instantaneous steps in direction dir of the ownship velocities that are critical with
+   * respect to traffic for the cylinder of radius D and half height H, i.e., the steps where the status of a conflict
+   * with the cylinder may change. When exact is true, these are the critical velocities of a conflict in [B,T].
+   * Otherwise, these are the critical velocities of a horizontal conflict in [B,TH] together with those of a vertical
+   * conflict in [B,TV]. Returns false if critical velocities are not available for these bands (default).
+   */
+  virtual bool instantaneous_critical_steps(std::vector<double>& ks, const DaidalusParameters& parameters,
+      const TrafficState& ownship, const TrafficState& traffic, bool dir,
+      double D, double H, double B, double T, double TH, double TV, bool exact) const;
+
+  /**
+   * Append to samples, which contains the kinematic trajectory samples in direction dir at times i*tstep, for
+   * 0 <= i < samples.size(), the samples at times i*tstep, for samples.size() <= i <= maxk. By default, every
+   * sample is computed by trajectory. Subclasses may compute the sequence of samples incrementally.
+   */
+  virtual void kinematic_trajectory_samples(std::vector<std::pair<Vect3,Velocity> >& samples, const DaidalusParameters& parameters,
+      const TrafficState& ownship, double tstep, bool dir, int maxk) const;
+
   virtual ~DaidalusIntegerBands() {}
 
+  /**
+   * Same as trajectory, but when the trajectory cache is enabled for ownship, samples at times k*tstep,
+   * where tstep is the time step of the cache, are computed only once.
+   */
+  std::pair<Vect3,Velocity> cached_trajectory(const DaidalusParameters& parameters, const TrafficState& ownship,
+      double time, bool dir, int target_step, bool instantaneous) const;
+
+protected:
+  /**
+   * Enable trajectory cache for ownship, where samples are taken at times k*tstep, for 0 <= k <= maxk.
+   * When instantaneous is true, only samples at time 0 are cached. The cache is only valid while ownship
+   * and parameters remain unchanged. Therefore, it should be disabled as soon as the computation of bands
+   * that uses it is done.
+   */
+  void enable_trajectory_cache(const TrafficState& ownship, double tstep, bool instantaneous, int maxk);
+
+  /**
+   * Disable trajectory cache. Cached samples are cleared, but memory is kept for the next computation.
+   */
+  void disable_trajectory_cache();
+
+  /**
+   * Make the trajectory cache read-only (frozen == true) or writable (frozen == false).
+   */
+  void freeze_trajectory_cache(bool frozen);
+
+  /**
+   * Set stride, in number of steps, of the coarse-to-fine search of bands. Values less than 1 are treated as 1,
+   * i.e., exhaustive search.
+   */
+  void set_search_stride(int stride);
+
+  /**
+   * Set period, in number of samples, at which incremental trajectory samples are computed exactly. Samples in
+   * between may be computed from the previous ones. Values less than 1 are treated as 1, i.e., every sample is
+   * computed exactly.
+   */
+  void set_anchor_period(int period);
+
+  int get_anchor_period() const;
+
+  /**
+   * Compute all kinematic samples of the trajectory cache in both directions. This is only needed when samples
+   * are not computed exactly, so that a frozen cache doesn't mix exact and incremental samples.
+   */
+  void fill_trajectory_cache(const DaidalusParameters& parameters) const;
+
+  /**
+   * Compute in green[k], for 0 <= k <= max, the value of status.green(k). When the search stride is greater than 1,
+   * a stride is skipped when status.steady_steps shows that the status doesn't change within it. Otherwise, every
+   * step of the stride is checked. When NDEBUG is not defined, the result is asserted to be the same as the one
+   * of the exhaustive search.
+   */
+  void search_green_steps(std::vector<bool>& green, const StepStatus& status, int max) const;
+
+  /**
+   * Returns true if traffic is horizontally out of reach of conflict_det and recovery_det, within lookahead time,
+   * for every trajectory of ownship, whose horizontal speed doesn't exceed the largest of the current ownship horizontal
+   * speed and the maximum horizontal speed, plus wind speed. In this case, no step is in conflict.
+   */
+  bool out_of_reach(const Detection3D* conflict_det, const Detection3D* recovery_det,
+      const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic) const;
+
+  /**
+   * Set memo of conflict probes used by CD_future_traj and LOS_at. A NULL memo (default) means that probes
+   * are not memoized. The memo is only valid while ownship, traffic, parameters, and detectors remain unchanged.
+   * Therefore, it should be unset as soon as the computation of bands that uses it is done.
+   */
+  void set_conflict_probe_memo(ConflictProbeMemo* memo);
+
+public:
+
   /*
    * In PVS: int_bands@CD_future_traj
    */
@@ -59,6 +217,11 @@ public:
   bool LOS_at(const Detection3D* det, bool trajdir, double tsk,
       const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic, int target_step, bool instantaneous) const;
 
+  //In PVS: inst_bands@conflict_free_track_step, inst_bands@conflict_free_gs_step, inst_bands@conflict_free_vs_step
+  bool no_instantaneous_conflict(const Detection3D* conflict_det, const Detection3D* recovery_det, double B, double T,
+      bool trajdir, const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic,
+      int epsh, int epsv, int target_step) const;
+
 private:
   // In PVS: int_bands@first_los_step
   int kinematic_first_los_step(const Detection3D* det, double tstep, bool trajdir,
@@ -75,6 +238,14 @@ private:
       double B, bool trajdir, int max, const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic,
       int epsh, int epsv) const;
 
+  /**
+   * Compute in conflict[i] the value of CD_future_traj(det,B,T+(relative?tsk:0),trajdir,tsk,...,0,false), where
+   * tsk = tstep*steps[i]. Probes are evaluated by det as a single batch.
+   */
+  void kinematic_CD_future_traj_batch(std::vector<bool>& conflict, const std::vector<int>& steps,
+      const Detection3D* det, double tstep, double B, double T, bool relative, bool trajdir,
+      const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic) const;
+
   // In PVS: int_bands@traj_conflict_only_band, int_bands@nat_bands, and int_bands@nat_bands_rec
   void kinematic_traj_conflict_only_bands(std::vector<Integerval>& l,
       const Detection3D* conflict_det, const Detection3D* recovery_det, double tstep, double B, double T,
@@ -121,11 +292,20 @@ private:
       bool trajdir, int max, const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic,
       int epsh, int epsv) const;
 
-  //In PVS: inst_bands@conflict_free_track_step, inst_bands@conflict_free_gs_step, inst_bands@conflict_free_vs_step
-  bool no_instantaneous_conflict(const Detection3D* conflict_det, const Detection3D* recovery_det, double B, double T,
-      bool trajdir, const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic,
+  bool instantaneous_repulsive_at(bool trajdir, const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic,
       int epsh, int epsv, int target_step) const;
 
+  // Same as CD_future_traj(det,B,T,trajdir,0,...,k,true) for 0 <= k <= max, but computed from critical steps.
+  // Returns false if det or these bands do not support critical steps
+  bool instantaneous_conflict_steps(std::vector<bool>& conflict, const Detection3D* det, double B, double T,
+      bool trajdir, int max, const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic) const;
+
+  // Same as no_instantaneous_conflict(...,k) for 0 <= k <= max
+  void instantaneous_green_steps(std::vector<bool>& green,
+      const Detection3D* conflict_det, const Detection3D* recovery_det, double B, double T,
+      bool trajdir, int max, const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic,
+      int epsh, int epsv) const;
+
   //In PVS: int_bands@nat_bands, int_bands@nat_bands_rec
   void instantaneous_bands(std::vector<Integerval>& l,
       const Detection3D* conflict_det, const Detection3D* recovery_det, double B, double T,
@@ -124,6 +124,7 @@ private:
   double dta_radius_;
   double dta_height_;
   int dta_alerter_;
+  Position dta_position_; // Computed from dta_latitude_ and dta_longitude_ when they are set
 
 
   // Alerting logic
@@ -929,6 +930,11 @@ private:
    */
   void readAlerterList(const std::vector<std::string>& alerter_list, const ParameterData& params);
 
+  /**
+   * Compute DTA position from DTA latitude and longitude, and their units
+   */
+  void updateDTAPosition();
+
   static bool contains(const ParameterData& p,const std::string& key);
 
   static std::string getUnit(const ParameterData& p,const std::string& key);
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2015-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+/*
+ * DaidalusPipeline.h
+ *
+ */
+
+#ifndef DAIDALUSPIPELINE_H_
+#define DAIDALUSPIPELINE_H_
+
+#include "DaidalusTimeStep.h"
+#include "Daidalus.h"
+#include <ostream>
+#include <string>
+
+namespace larcfm {
+
+/**
+ * Three-stage pipeline for the replay of a DAIDALUS file. A reader thread prefetches time steps
+ * from a source, e.g., a file walker, the calling thread loads them into a Daidalus object and
+ * computes, and a writer thread writes the outputs of the computation. Stages are connected by
+ * bounded queues, so that parsing and writing overlap with computation, which remains sequential,
+ * while memory usage doesn't depend on the length of the file. Time steps and outputs keep their
+ * order.
+ *
+ * The source is only used by the reader thread between start and finish, and it must not write global
+ * state, e.g., the accuracies in Constants, which are read by the computation. Output streams are only
+ * written by the writer thread between start and finish.
+ */
+class DaidalusPipeline {
+
+  private:
+  struct Impl;
+  Impl* impl_;
+  int capacity_;
+
+  DaidalusPipeline(const DaidalusPipeline& pipeline);
+  DaidalusPipeline& operator=(const DaidalusPipeline& pipeline);
+
+  public:
+  /**
+   * Pipeline whose queues hold up to capacity time steps and outputs, respectively
+   */
+  explicit DaidalusPipeline(int capacity = 64);
+
+  /**
+   * Finish pipeline, if it is still running
+   */
+  ~DaidalusPipeline();
+
+  /**
+   * Start reader and writer threads. Time steps are read from source.
+   */
+  void start(DaidalusTimeStepSource& source);
+
+  /**
+   * Load next time step into daa.
+   * @return false if there are no more time steps
+   */
+  bool readState(Daidalus& daa);
+
+  /**
+   * Queue str to be written into out
+   */
+  void write(std::ostream& out, const std::string& str);
+
+  /**
+   * Stop reading time steps, wait until all queued outputs are written, and stop threads
+   */
+  void finish();
+
+  /**
+   * @return true if the pipeline has been started and not finished
+   */
+  bool isRunning() const;
+
+};
+
+}
+
+#endif /* DAIDALUSPIPELINE_H_ */
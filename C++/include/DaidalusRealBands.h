@@ -22,6 +22,7 @@
 #include "RecoveryInformation.h"
 #include "BandsMofN.h"
 #include "BandsHysteresis.h"
+#include "NoneSetCache.h"
 
 #include <vector>
 #include <string>
@@ -85,6 +86,8 @@ private:
   double max_relative_; // Computed relative max value
   bool   circular_; // True if bands is fully circular
 
+  NoneSetCache none_sets_cache_; // Cached none sets of traffic aircraft from previous computations
+
   /**** HYSTERESIS VARIABLES ****/
 
   BandsHysteresis bands_hysteresis_;
@@ -143,6 +146,26 @@ public:
   bool kinematic_conflict(const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic,
       Detection3D* detector, int epsh, int epsv, double alerting_time, int dta_status);
 
+  /**
+   * Start a sequence of spread conflict checks for ownship, where relative values are at most max_spread.
+   * Ownship trajectory samples are shared by all checks in the sequence. Trajectories must not depend on
+   * the range of values, e.g., altitude trajectories, which depend on the minimum value of the range,
+   * should not use this method. Ownship and parameters should remain unchanged until end_spread_conflicts is called.
+   */
+  void begin_spread_conflicts(const DaidalusParameters& parameters, const TrafficState& ownship, double max_spread);
+
+  /**
+   * End a sequence of spread conflict checks
+   */
+  void end_spread_conflicts();
+
+  /**
+   * Same as kinematic_conflict, but relative values are set to min_rel and max_rel. This method can be called
+   * repeatedly on the same object. The check stops as soon as a conflict is found at some step of the range.
+   */
+  bool spread_conflict(double min_rel, double max_rel, const DaidalusParameters& parameters, const TrafficState& ownship,
+      const TrafficState& traffic, Detection3D* detector, int epsh, int epsv, double alerting_time, int dta_status);
+
   int length(DaidalusCore& core);
 
   const Interval& interval(DaidalusCore& core, int i);
@@ -164,6 +187,12 @@ public:
    */
   void clear_hysteresis();
 
+  /**
+   * Set cached values to stale conditions and clear cached none sets. This method
+   * is called when parameters change.
+   */
+  void reset();
+
   /**
    * Returns true is object is fresh
    */
@@ -174,6 +203,12 @@ public:
    */
   void refresh(DaidalusCore& core);
 
+  /**
+   * Requires a fresh core. Refresh cached values, only reading the core. Several bands
+   * objects can be refreshed concurrently with the same fresh core.
+   */
+  void refresh_with(const DaidalusCore& core);
+
   /**
    *  Force computation of kinematic bands
    */
@@ -185,7 +220,7 @@ private:
    * Requires 0 <= conflict_region < CONFICT_BANDS and acs_peripheral_bands_ is empty
    * Put in acs_peripheral_bands_ the list of aircraft predicted to have a peripheral band for the given region.
    */
-  void peripheral_aircraft(DaidalusCore& core, int conflict_region);
+  void peripheral_aircraft(const DaidalusCore& core, int conflict_region);
 
 public:
   /**
@@ -212,7 +247,7 @@ private:
    * Ensure that the intervals are "complete", filling in missing intervals and ensuring the
    * bands end at the proper bounds.
    */
-  void color_values(std::vector<ColorValue>& lcvs, const std::vector<IntervalSet>& none_sets, DaidalusCore& core, bool recovery, int last_region);
+  void color_values(std::vector<ColorValue>& lcvs, const std::vector<IntervalSet>& none_sets, const DaidalusCore& core, bool recovery, int last_region);
 
   /**
    * Create an IntervalSet that represents a satured NONE band
@@ -227,7 +262,7 @@ private:
    */
   void compute_none_bands(IntervalSet& none_set_region, const std::vector<IndexLevelT>& ilts,
       Detection3D* det, Detection3D* recovery,
-      bool recovery_case, double B, DaidalusCore& core);
+      bool recovery_case, double B, const DaidalusCore& core);
 
   /**
    * Compute recovery bands. Class variables recovery_time_, recovery_horizontal_distance_,
@@ -235,18 +270,18 @@ private:
    * Return true if non-saturated recovery bands where computed
    */
   bool compute_recovery_bands(IntervalSet& none_set_region, const std::vector<IndexLevelT>& ilts,
-      DaidalusCore& core);
+      const DaidalusCore& core);
 
   /**
    * Requires: compute_bands(conflict_region) = true && 0 <= conflict_region < CONFLICT_BANDS
    * Compute bands for one region. Return true iff recovery bands were computed.
    */
-  bool compute_region(std::vector<IntervalSet>& none_sets, int conflict_region, int corrective_region, DaidalusCore& core);
+  bool compute_region(std::vector<IntervalSet>& none_sets, int conflict_region, int corrective_region, const DaidalusCore& core);
 
   /**
    * Compute all bands.
    */
-  void compute(DaidalusCore& core);
+  void compute(const DaidalusCore& core);
 
 public:
 
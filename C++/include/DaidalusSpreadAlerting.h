@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2015-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#ifndef DAIDALUSSPREADALERTING_H_
+#define DAIDALUSSPREADALERTING_H_
+
+#include "DaidalusParameters.h"
+#include "AlertThresholds.h"
+#include "Detection3D.h"
+#include "TrafficState.h"
+#include "DaidalusDirBands.h"
+#include "DaidalusHsBands.h"
+#include "DaidalusVsBands.h"
+#include "DaidalusAltBands.h"
+
+namespace larcfm {
+
+/**
+ * Checks of alerting thresholds that use spread values, i.e., that consider ownship maneuvers. Band
+ * objects used to probe the spreads are reused across traffic aircraft and alert levels. Between calls
+ * to begin and end, ownship trajectory samples are also shared by all the checks. An object of this
+ * class is not thread safe, but different objects can be used concurrently.
+ */
+class DaidalusSpreadAlerting {
+
+private:
+  DaidalusDirBands dir_band_;
+  DaidalusHsBands hs_band_;
+  DaidalusVsBands vs_band_;
+  DaidalusAltBands alt_band_;
+
+  // Band objects are not meant to be shared
+  DaidalusSpreadAlerting(const DaidalusSpreadAlerting& spread);
+  DaidalusSpreadAlerting& operator=(const DaidalusSpreadAlerting& spread);
+
+public:
+  DaidalusSpreadAlerting();
+
+  /**
+   * Start a sequence of checks for ownship. Parameters and ownship should remain unchanged until end is called.
+   */
+  void begin(const DaidalusParameters& parameters, const TrafficState& ownship);
+
+  /**
+   * End a sequence of checks
+   */
+  void end();
+
+  /**
+   * Return true if intruder is in conflict with ownship, using given detector and alerting time, when ownship
+   * maneuvers within the spread values of alerting thresholds athr. The meaning of turning, accelerating, and
+   * climbing is the same as in DaidalusCore::alert_level.
+   */
+  bool conflict(const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& intruder,
+      const AlertThresholds& athr, Detection3D* detector, int epsh, int epsv, double alerting_time, int dta_status,
+      int turning, int accelerating, int climbing);
+
+};
+
+}
+
+#endif
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2015-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+/*
+ * DaidalusStreamWalker.h
+ *
+ */
+
+#ifndef DAIDALUSSTREAMWALKER_H_
+#define DAIDALUSSTREAMWALKER_H_
+
+#include "SequenceStreamReader.h"
+#include "ParameterData.h"
+#include "Daidalus.h"
+#include "DaidalusTimeStep.h"
+#include <string>
+
+namespace larcfm {
+
+/**
+ * Forward-only walker of DAIDALUS files. Unlike DaidalusFileWalker, which loads the whole file, this walker
+ * parses one time step at a time. States are handed to readState as they are read, so that memory usage
+ * doesn't depend on the length of the file. The look-behind window, in number of time steps, determines
+ * the history of the aircraft states available through getReader(). It doesn't affect the states handed
+ * to readState, which are the ones of the current time step.
+ */
+class DaidalusStreamWalker : public ErrorReporter, public DaidalusTimeStepSource {
+  private:
+  SequenceStreamReader sr_;
+  int index_;
+
+  DaidalusStreamWalker(const DaidalusStreamWalker& walker);
+  DaidalusStreamWalker& operator=(const DaidalusStreamWalker& walker);
+
+  void init();
+
+  static ParameterData extraColumnsToParameters(const StateReader& sr, int ac);
+
+  public:
+  explicit DaidalusStreamWalker(const std::string& filename, int window = 1);
+
+  void resetInputFile(const std::string& filename);
+
+  /**
+   * @return number of time steps kept in memory
+   */
+  int getWindowSize() const;
+
+  /**
+   * @return index of current time step, i.e., number of time steps already read by readState or skipped by goNext
+   */
+  int getIndex() const;
+
+  /**
+   * @return time of current time step or NaN if at end of file
+   */
+  double getTime() const;
+
+  bool atBeginning() const;
+
+  bool atEnd() const;
+
+  /**
+   * Skip current time step
+   */
+  void goNext();
+
+  /**
+   * Reader of the file, whose active set of states includes the current time step and the previous
+   * ones in the look-behind window
+   */
+  const SequenceStreamReader& getReader() const;
+
+  /**
+   * Load states of current time step into daa and move to the next time step
+   */
+  void readState(Daidalus& daa);
+
+  /**
+   * Store states of current time step into step, as readState loads them into a Daidalus
+   * object, and move to the next time step.
+   * @return false if at end of file
+   */
+  bool readTimeStep(DaidalusTimeStep& step);
+
+  bool hasError() const;
+
+  bool hasMessage() const;
+
+  std::string getMessage();
+
+  std::string getMessageNoClear() const;
+
+};
+
+}
+
+#endif /* DAIDALUSSTREAMWALKER_H_ */
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2015-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+/*
+ * DaidalusTimeStep.h
+ *
+ */
+
+#ifndef DAIDALUSTIMESTEP_H_
+#define DAIDALUSTIMESTEP_H_
+
+#include "ParameterData.h"
+#include "Position.h"
+#include "Velocity.h"
+#include "Daidalus.h"
+#include <vector>
+#include <string>
+
+namespace larcfm {
+
+/**
+ * States of the aircraft at a time step of a DAIDALUS file, as read by DaidalusFileWalker or
+ * DaidalusStreamWalker. The first aircraft is the ownship. Time steps are independent of the
+ * walker that read them, so that they can be loaded into a Daidalus object by a different thread.
+ */
+class DaidalusTimeStep {
+  private:
+  double time_;
+  ParameterData parameters_;
+  std::vector<std::string> ids_;
+  std::vector<Position> positions_;
+  std::vector<Velocity> velocities_;
+  std::vector<ParameterData> columns_;
+
+  public:
+  DaidalusTimeStep();
+
+  /**
+   * Remove all aircraft and set time of time step
+   */
+  void clear(double time);
+
+  double getTime() const;
+
+  /**
+   * Set configuration parameters of the file, which are set into Daidalus at every time step
+   */
+  void setParameters(const ParameterData& parameters);
+
+  /**
+   * Add aircraft state and values of its extra columns
+   */
+  void add(const std::string& id, const Position& pos, const Velocity& vel, const ParameterData& columns);
+
+  /**
+   * @return number of aircraft
+   */
+  int size() const;
+
+  /**
+   * Load states into daa, as readState of DaidalusFileWalker does
+   */
+  void readState(Daidalus& daa) const;
+
+};
+
+/**
+ * Source of time steps, e.g., a walker of DAIDALUS files. In DaidalusPipeline, time steps are read
+ * by a thread while another one computes. Therefore, readTimeStep must not write global state, e.g.,
+ * the accuracies in Constants.
+ */
+class DaidalusTimeStepSource {
+  public:
+  virtual ~DaidalusTimeStepSource() {}
+
+  /**
+   * Store next time step into step.
+   * @return false if there are no more time steps
+   */
+  virtual bool readTimeStep(DaidalusTimeStep& step) = 0;
+};
+
+}
+
+#endif /* DAIDALUSTIMESTEP_H_ */
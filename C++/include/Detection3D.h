@@ -19,16 +19,43 @@
 #include "ParameterData.h"
 #include "TrafficState.h"
 #include "ConflictData.h"
+#include "LossData.h"
+#include "DetectionBatch.h"
 #include "string_util.h"
 #include "ParameterAcceptor.h"
 #include <string>
+#include <vector>
 
 namespace larcfm {
 
+/**
+ * Interface of conflict detectors. Alerting and bands evaluate a detector through a single virtual entry
+ * point, conflictDetectionSUM, whose default implementation calls conflictDetection and ignores SUM data.
+ * Every other detection method, including the ones on traffic states, is defined in terms of it. A detector
+ * defines conflictDetection and, if it takes sensor uncertainty into account, overrides conflictDetectionSUM.
+ * Overrides of conflictIntervalSUM and conflictBatchSUM, which are specializations for the computation of
+ * bands, must agree with conflictDetectionSUM.
+ */
 class Detection3D : public ParameterAcceptor {
+private:
+  unsigned long serial_number_;
+
+protected:
+  Detection3D();
+  Detection3D(const Detection3D& det);
+  Detection3D& operator=(const Detection3D& det);
+
 public:
   virtual ~Detection3D() = 0;
 
+  /**
+   * Serial number of this instance, which is different for every Detection3D object created by the
+   * program. Copies get a new serial number, and so does an instance that is assigned another one.
+   * Unlike its address, the serial number of a destroyed instance is never reused. Therefore, it can be
+   * used to identify detectors in caches that outlive them.
+   */
+  unsigned long getSerialNumber() const;
+
   /* Note: this interface might be better (i.e. more efficient and internally consistent) if all parameters are Euclidean Vect3s.
    * Internally, doing things like taking the dot product of positions and velocities is somewhat iffy from a type-consistency point
    * of view, and also potentially less efficient in C++, due to various type conversions (needs testing).
@@ -92,6 +119,8 @@ public:
 
   /**
    * This functional call returns a ConflictData object detailing the conflict between times B and T from now (relative), if any.
+   * This is conflictDetectionSUM applied to the states and SUM data of ownship and intruder. It isn't virtual: detectors
+   * that take SUM data into account override conflictDetectionSUM, so that alerting and bands use the same detection.
    * @param ownship   ownship state
    * @param intruder  intruder state
    * @param D   horizontal separation
@@ -100,7 +129,136 @@ public:
    * @param T   end of detection time (if T < 0 then use an "infinite" lookahead time)
    * @return a ConflictData object detailing the conflict
    */
-  virtual ConflictData conflictDetectionWithTrafficState(const TrafficState& ownship, const TrafficState& intruder, double B, double T) const;
+  ConflictData conflictDetectionWithTrafficState(const TrafficState& ownship, const TrafficState& intruder, double B, double T) const;
+
+  /**
+   * This functional call returns true if there is a violation at time t. This is the same as
+   * violationAtWithTrafficState, but states are given as raw vectors and SUM data so that callers
+   * probing many candidate ownship states do not need to build TrafficState objects.
+   * @param so  ownship position
+   * @param vo  ownship velocity
+   * @param si  intruder position
+   * @param vi  intruder velocity
+   * @param t   time in seconds
+   * @param own_sum  ownship's SUM data
+   * @param ac_sum   intruder's SUM data
+   * @return    true if there is a violation at time t
+   */
+  bool violationAtSUM(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double t,
+      const SUMData& own_sum, const SUMData& ac_sum) const;
+
+  /**
+   * This functional call returns true if there will be a violation between times B and T from now (relative).
+   * This is the same as conflictWithTrafficState, but states are given as raw vectors and SUM data.
+   * @param so  ownship position
+   * @param vo  ownship velocity
+   * @param si  intruder position
+   * @param vi  intruder velocity
+   * @param B   beginning of detection time (>=0)
+   * @param T   end of detection time (if T < 0 then use an "infinite" lookahead time)
+   * @param own_sum  ownship's SUM data
+   * @param ac_sum   intruder's SUM data
+   * @return true if there is a conflict within times B to T
+   */
+  bool conflictSUM(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T,
+      const SUMData& own_sum, const SUMData& ac_sum) const;
+
+  /**
+   * The conflict status of conflictSUM in [B,T] is decided by the conflict interval in [B,end], see probeConflict.
+   * When B and T are almost equal, end is B+1, since a conflict at time B is a loss that begins at B. Otherwise, end is T.
+   * @return false if there is no conflict in [B,T] for any detector, i.e., B > T. In this case, end is not set.
+   */
+  static bool probeInterval(double B, double T, double& end);
+
+  /**
+   * Conflict status of conflictSUM in [B,T], given the conflict interval in [B,end], where end is set by probeInterval.
+   */
+  static bool probeConflict(const LossData& interval, double B, double T);
+
+  /**
+   * This functional call returns a ConflictData object detailing the conflict between times B and T from now (relative), if any.
+   * Detectors that take sensor uncertainty into account override this method. By default, SUM data is ignored.
+   * @param so  ownship position
+   * @param vo  ownship velocity
+   * @param si  intruder position
+   * @param vi  intruder velocity
+   * @param B   beginning of detection time (>=0)
+   * @param T   end of detection time (if T < 0 then use an "infinite" lookahead time)
+   * @param own_sum  ownship's SUM data
+   * @param ac_sum   intruder's SUM data
+   * @return a ConflictData object detailing the conflict
+   */
+  virtual ConflictData conflictDetectionSUM(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T,
+      const SUMData& own_sum, const SUMData& ac_sum) const;
+
+  /**
+   * This functional call returns the conflict interval between times B and T from now (relative), if any. This is
+   * the interval of conflictDetectionSUM, but critical time and distance are not computed. Detectors that
+   * override conflictDetectionSUM or conflictDetection should override this method accordingly.
+   * @param so  ownship position
+   * @param vo  ownship velocity
+   * @param si  intruder position
+   * @param vi  intruder velocity
+   * @param B   beginning of detection time (>=0)
+   * @param T   end of detection time (if T < 0 then use an "infinite" lookahead time)
+   * @param own_sum  ownship's SUM data
+   * @param ac_sum   intruder's SUM data
+   * @return a LossData object with the conflict interval
+   */
+  virtual LossData conflictIntervalSUM(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T,
+      const SUMData& own_sum, const SUMData& ac_sum) const;
+
+  /**
+   * Computes in conflicts[i], for every element i of batch, the value of
+   * conflictSUM(batch.so(i),batch.vo(i),si,vi,batch.B(i),batch.T(i),own_sum,ac_sum).
+   * By default, elements are computed one at a time. Detectors may override this method
+   * with a specialized loop.
+   * @param conflicts output vector, resized to the size of the batch
+   * @param batch  ownship states and detection times
+   * @param si  intruder position
+   * @param vi  intruder velocity
+   * @param own_sum  ownship's SUM data
+   * @param ac_sum   intruder's SUM data
+   */
+  virtual void conflictBatchSUM(std::vector<bool>& conflicts, const DetectionBatch& batch, const Vect3& si, const Velocity& vi,
+      const SUMData& own_sum, const SUMData& ac_sum) const;
+
+  /**
+   * Loss interval of the linear projections of ownship and intruder, not bounded in time, whose clipping to
+   * [B,T] is the conflict interval of conflictIntervalSUM(so,vo,si,vi,B,T,own_sum,ac_sum) for every 0 <= B < T,
+   * i.e., the conflict interval in [B,T] is [min(max(time_in,B),T),max(min(time_out,T),B)]. A single interval then
+   * answers conflictSUM for the same states and any times B and T, e.g., the probes of every pivot of the search
+   * of the recovery time.
+   * @param interval output loss interval
+   * @param so  ownship position
+   * @param vo  ownship velocity
+   * @param si  intruder position
+   * @param vi  intruder velocity
+   * @param own_sum  ownship's SUM data
+   * @param ac_sum   intruder's SUM data
+   * @return false if conflicts of this detector are not characterized by a loss interval (default)
+   */
+  virtual bool lossIntervalSUM(LossData& interval, const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi,
+      const SUMData& own_sum, const SUMData& ac_sum) const;
+
+  /**
+   * Cylinder of horizontal radius D and half height H that characterizes the conflicts of this detector
+   * for the computation of critical vectors (SUM data is ignored). If exact is true, there is a conflict
+   * in [B,T] if and only if there is a conflict with the cylinder in [B,T]. Otherwise, a conflict in [B,T]
+   * implies a horizontal conflict with the cylinder in [B,T+TH] and a vertical conflict with the cylinder
+   * in [B,T+TV]. D is infinite when conflicts are not horizontally bounded.
+   * @return false if this detector is not characterized by a cylinder (default)
+   */
+  virtual bool criticalCylinder(double& D, double& H, double& TH, double& TV, bool& exact) const;
+
+  /**
+   * Upper bound on the current horizontal distance between two aircraft that may be in conflict at some time
+   * in [0,T], when their relative horizontal speed is at most vh at all times in [0,T]. Aircraft that are
+   * horizontally farther apart are not in conflict in [0,T] for any maneuver that satisfies that speed bound.
+   * By default, the bound is derived from the critical cylinder of this detector.
+   * @return bound on horizontal distance or infinity if this detector provides no bound
+   */
+  virtual double horizontalReachSUM(double T, double vh, const SUMData& own_sum, const SUMData& ac_sum) const;
 
   /** This returns a pointer to a new instance of this type of Detector3D.  You are responsible for destroying this instance when it is no longer needed. */
   virtual Detection3D* copy() const = 0;
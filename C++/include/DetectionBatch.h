@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2015-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#ifndef DETECTIONBATCH_H_
+#define DETECTIONBATCH_H_
+
+#include "Vect3.h"
+#include "Velocity.h"
+#include <vector>
+
+namespace larcfm {
+
+/**
+ * Batch of inputs of conflict detection against one intruder, i.e., ownship positions, ownship velocities,
+ * and time intervals [B,T]. Components are stored as separate arrays (structure of arrays), so that
+ * detectors can evaluate a whole batch, e.g., a sweep of candidate ownship maneuvers, in a single loop.
+ */
+class DetectionBatch {
+
+private:
+  std::vector<double> sx_;
+  std::vector<double> sy_;
+  std::vector<double> sz_;
+  std::vector<double> vx_;
+  std::vector<double> vy_;
+  std::vector<double> vz_;
+  std::vector<double> B_;
+  std::vector<double> T_;
+
+public:
+
+  /**
+   * Remove all elements. Memory is kept for the next batch.
+   */
+  void clear();
+
+  /**
+   * Add ownship position so, ownship velocity vo, and detection interval [B,T] to this batch.
+   */
+  void add(const Vect3& so, const Velocity& vo, double B, double T);
+
+  /**
+   * @return number of elements in this batch
+   */
+  int size() const;
+
+  /**
+   * @return ownship position of i-th element
+   */
+  Vect3 so(int i) const;
+
+  /**
+   * @return ownship velocity of i-th element
+   */
+  Velocity vo(int i) const;
+
+  /**
+   * @return beginning of detection time of i-th element
+   */
+  double B(int i) const;
+
+  /**
+   * @return end of detection time of i-th element
+   */
+  double T(int i) const;
+
+};
+
+}
+
+#endif
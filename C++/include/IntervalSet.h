@@ -49,13 +49,14 @@ namespace larcfm {
  * }
  * </code></pre><p>
  *
- * The current implementation does not allocate any dynamic (heap) memory.
+ * Small sets, i.e., up to inline_capacity intervals, are stored inside the object and do not
+ * allocate any dynamic (heap) memory. Larger sets are stored in heap memory.
  */
 class IntervalSet {// : ErrorReporter {
 
 public:
-	/** The maximum number of intervals */
-	static const int max_intervals = 400;
+	/** The number of intervals that are stored without allocating heap memory */
+	static const int inline_capacity = 8;
 
 public:
 	/** Construct an empty IntervalSet */
@@ -66,6 +67,10 @@ public:
 	 * */ 
 	IntervalSet(const IntervalSet& l);
 
+	IntervalSet& operator=(const IntervalSet& l);
+
+	~IntervalSet();
+
 	/** Build an IntervalSet from the given vector */
 	explicit IntervalSet(const std::vector<Interval>& v);
 
@@ -220,13 +225,18 @@ public:
 
 private:
 	int order(double x) const;
+	void reserve(int n);
+	void assign(const Interval* v, int n);
+	void append(const Interval& rn);
 	void insert(int i, const Interval& r);
 	void remove(int i);
 	void remove(int i, int len);
 
 	static const Interval empty;
-	Interval r[max_intervals];
+	Interval inline_r[inline_capacity];
+	Interval* r; // Either inline_r or heap memory
 	int length;
+	int capacity;
 };
 
 }
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2015-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#ifndef MAPPEDFILE_H_
+#define MAPPEDFILE_H_
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace larcfm {
+
+/**
+ * Read-only view of the contents of a file. On POSIX systems, the file is memory mapped, so that
+ * its contents are paged in on demand and are not copied. On other systems, the file is read
+ * into memory. The contents are valid until the file is closed or another file is opened.
+ */
+class MappedFile {
+
+private:
+  const char* data_;
+  std::size_t size_;
+  bool open_;
+  // True if data_ is memory mapped
+  bool mapped_;
+  // Contents of the file when it's not memory mapped
+  std::vector<char> buffer_;
+
+  MappedFile(const MappedFile& file);
+  MappedFile& operator=(const MappedFile& file);
+
+public:
+
+  MappedFile();
+
+  explicit MappedFile(const std::string& filename);
+
+  ~MappedFile();
+
+  /**
+   * Open file. Any previously opened file is closed.
+   * @return true if the file was successfully opened
+   */
+  bool open(const std::string& filename);
+
+  void close();
+
+  bool isOpen() const;
+
+  /**
+   * @return pointer to first character of the file
+   */
+  const char* begin() const;
+
+  /**
+   * @return pointer past the last character of the file
+   */
+  const char* end() const;
+
+  std::size_t size() const;
+
+};
+
+}
+
+#endif
@@ -12,14 +12,25 @@
 #ifndef MOFN_H_
 #define MOFN_H_
 
-#include <deque>
 #include <string>
 
 namespace larcfm {
 
+/*
+ * M of N values are kept in a fixed-size ring of at most MAX_N values. Furthermore, for every level
+ * 0 <= i < LEVELS, the ring keeps a bit mask whose k-th bit is set when the k-th value is greater than
+ * or equal to i, so that occurrences of values are counted with a population count. Therefore,
+ * M of N logic doesn't allocate memory.
+ */
 class MofN {
 public:
 
+  /* Maximum value of N. Larger values are treated as MAX_N */
+  static const int MAX_N = 64;
+
+  /* Number of levels whose occurrences are counted with bit masks */
+  static const int LEVELS = 8;
+
   /*
    * Set M of N with a given initial value
    */
@@ -70,7 +81,18 @@ private:
   int m_;
   int n_;
   int    max_;
-  std::deque<int> queue_;
+  int head_; // Position in the ring of the oldest value
+  int ring_[MAX_N];
+  unsigned long long levels_[LEVELS]; // Bit k of levels_[i] is set iff ring_[k] >= i
+
+  /* Set the k-th value of the ring */
+  void set(int k, int val);
+
+  /* Number of values in the ring that are greater than or equal to i, where i >= 0 */
+  int count(int i) const;
+
+  /* i-th oldest value in the ring */
+  int at(int i) const;
 
 };
 
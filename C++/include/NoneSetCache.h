@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2015-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#ifndef NONESETCACHE_H_
+#define NONESETCACHE_H_
+
+#include "Position.h"
+#include "Velocity.h"
+#include "Vect3.h"
+#include "TrafficState.h"
+#include "Detection3D.h"
+#include "IntervalSet.h"
+#include <map>
+#include <vector>
+#include <string>
+
+namespace larcfm {
+
+/**
+ * Cache of none sets computed for traffic aircraft. An entry is indexed by the aircraft id and
+ * is valid as long as every input of the computation of the none set is the same, i.e., ownship
+ * state, bands configuration, traffic state, detectors, epsilon values, and times B and T. None
+ * sets don't depend on the current time. Therefore, entries are kept across cycles as long as the
+ * ownship state and the range of the bands don't change, e.g., for a hovering or a fixed ground
+ * ownship, and only the none sets of traffic aircraft whose inputs changed are recomputed.
+ * Parameters are not part of the key. Therefore, the cache has to be cleared when parameters
+ * change.
+ *
+ * A computation of bands is enclosed by calls to begin and end. Entries that are not used
+ * during that computation are removed by end.
+ *
+ * Detectors are identified by their serial number, which, unlike their address, is never reused.
+ * Entries are not copied when the cache is copied.
+ */
+class NoneSetCache {
+
+private:
+
+  /* Ownship state and bands configuration */
+  struct OwnKey {
+    Position pos;
+    Velocity gvel;
+    Velocity avel;
+    Position posxyz;
+    Velocity velxyz;
+    Vect3 s;
+    Velocity v;
+    double sum[4];
+    double config[5];
+  };
+
+  /* Traffic state and inputs of a computation of none set */
+  struct Key {
+    Position pos;
+    Velocity avel;
+    Vect3 s;
+    Velocity v;
+    double sum[4];
+    // Serial numbers of detectors plus 1, or 0 if there is no detector
+    unsigned long conflict_det;
+    unsigned long recovery_det;
+    int epsh;
+    int epsv;
+    double B;
+    double T;
+  };
+
+  struct Entry {
+    Key key;
+    IntervalSet noneset;
+    bool used;
+  };
+
+  bool valid_;
+  OwnKey own_;
+  std::map<std::string,std::vector<Entry> > entries_;
+
+  static void set_sum(double sum[4], const SUMData& data);
+
+  static bool equals(const OwnKey& k1, const OwnKey& k2);
+
+  static bool equals(const Key& k1, const Key& k2);
+
+  static unsigned long detector_key(const Detection3D* det);
+
+  static void set_key(Key& key, const TrafficState& traffic, const Detection3D* conflict_det,
+      const Detection3D* recovery_det, int epsh, int epsv, double B, double T);
+
+public:
+
+  NoneSetCache();
+
+  NoneSetCache(const NoneSetCache& cache);
+
+  NoneSetCache& operator=(const NoneSetCache& cache);
+
+  /**
+   * Remove all entries.
+   */
+  void clear();
+
+  /**
+   * Start a computation of bands for ownship. The values min_val, max_val, min_relative, max_relative,
+   * and circular describe the range of the bands. If ownship state or range are different from the
+   * ones of the previous computation, all entries are removed.
+   */
+  void begin(const TrafficState& ownship, double min_val, double max_val,
+      double min_relative, double max_relative, bool circular);
+
+  /**
+   * Finish a computation of bands. Entries that were not used since begin are removed.
+   */
+  void end();
+
+  /**
+   * If there is an entry for the given inputs, copy its none set into noneset and return true.
+   * Otherwise, return false.
+   */
+  bool lookup(IntervalSet& noneset, const TrafficState& traffic, const Detection3D* conflict_det,
+      const Detection3D* recovery_det, int epsh, int epsv, double B, double T);
+
+  /**
+   * Store the none set computed for the given inputs.
+   */
+  void store(const IntervalSet& noneset, const TrafficState& traffic, const Detection3D* conflict_det,
+      const Detection3D* recovery_det, int epsh, int epsv, double B, double T);
+
+};
+
+}
+
+#endif
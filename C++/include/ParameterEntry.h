@@ -41,7 +41,7 @@ public:
 
 private:
 	static std::string format(const std::string& u, double d, int p);
-	static long count;
+	static long nextOrder();
 
 };
 
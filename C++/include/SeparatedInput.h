@@ -108,6 +108,12 @@ namespace larcfm {
     /** Create a new SeparatedInput from the given stream */
     explicit SeparatedInput(std::istream *fs);
 
+    /**
+     * Create a new SeparatedInput from the characters in [begin,end), e.g., the contents of a MappedFile.
+     * Characters are not copied, so they must remain valid while lines are read.
+     */
+    SeparatedInput(const char* begin, const char* end);
+
     /** Copy Constructor.  This should not be used. */
     SeparatedInput(const SeparatedInput& x);
 
@@ -309,6 +315,26 @@ namespace larcfm {
 
   private:
     std::istream* reader;
+
+    // Input in memory, used when reader is NULL
+    const char* data_begin;
+    const char* data_end;
+    const char* data_pos;
+    bool data_eof;
+
+    // Current line. The line is stored in line_buf, unless it's a line of the input in memory
+    std::string line_buf;
+    bool line_in_buf;
+    std::size_t line_offset;  // Offset of the line in the input in memory
+    std::size_t line_length;
+
+    // Columns of the last line read as (offset,length) pairs in the line. They are used instead of
+    // line_str when columns are separated by the default delimiters
+    std::vector<std::pair<int,int> > line_cols;
+    bool cols_in_line;
+
+    // Factors of default units, which are resolved only once
+    mutable std::map<std::string,double> default_factors;
     
     mutable ErrorLog error;
     bool header;         // header line read in
@@ -338,12 +364,22 @@ namespace larcfm {
     ParameterData parameters;
     
     double getUnitFactor(int i) const;
+    double getDefaultFactor(const std::string& unit) const;
     bool process_units(const std::string& str);
     bool process_preamble(std::string str);
     void process_line(const std::string& str);
+    void process_line(const char* begin, const char* end);
+    std::vector<std::string> split_fields(const std::string& str) const;
+    bool default_delimiters() const;
+    int columns() const;
+    void column(int i, const char*& begin, const char*& end) const;
 	
     std::vector<std::string> processQuotes(const std::string& str) const; 
 	std::string readFullLine(std::istream* reader);  
+	bool readMemoryLine(const char*& begin, const char*& end);
+	void readFullLine();
+	const char* lineBegin() const;
+	bool atEof() const;
   };
 }
 
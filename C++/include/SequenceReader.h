@@ -79,6 +79,7 @@ private:
 
 
 	void loadfile();
+	void openInput(SeparatedInput si);
 	void buildActive(double tm);
 	
 public:
@@ -0,0 +1,137 @@
+/*
+ * SequenceStreamReader
+ *
+ * Copyright (c) 2011-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#ifndef SEQUENCESTREAMREADER_H
+#define SEQUENCESTREAMREADER_H
+
+#include "StateReader.h"
+#include "MappedFile.h"
+#include "Position.h"
+#include "Velocity.h"
+#include "Triple.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <iostream>
+
+namespace larcfm {
+
+/**
+ * <p>Forward-only reader of sequence files. This reader accepts the same file format as SequenceReader,
+ * but instead of loading the whole file, it reads one time step at a time. Only the last time steps,
+ * up to the window size, are kept in memory. Therefore, memory usage doesn't depend on the length of
+ * the file.</p>
+ *
+ * <p>The active set of states is the one of the last time step read. As in SequenceReader, aircraft are
+ * ordered by first appearance in the file and their states include the entries in the window. Extra column
+ * values of the active set are the ones of the last time step read.</p>
+ *
+ * <p>Only the names of the aircraft in the window are kept. An aircraft that reappears after leaving the
+ * window is ordered, and taken as the last new name for "-shorthand names, as if it appeared for the
+ * first time.</p>
+ *
+ * <p>Lines of the same time step must be contiguous and times must be increasing. Otherwise, an error is
+ * reported and no further time steps are read.</p>
+ *
+ * <p>Unlike SequenceReader, this reader never writes the global accuracies in Constants. Reading data lines
+ * doesn't depend on them, and the accuracy parameters of the file (horizontalAccuracy, verticalAccuracy,
+ * timeAccuracy) remain available through getParametersRef(). Time steps can therefore be read by a thread
+ * while another one computes, e.g., in DaidalusPipeline.</p>
+ */
+class SequenceStreamReader : public StateReader {
+private:
+	typedef std::map<int, Triple<double,bool,std::string> > ExtraEntry;
+
+	struct DataPoint {
+		Position p;
+		Velocity v;
+		ExtraEntry extra;
+	};
+
+	// Entries of a time step indexed by aircraft handle, i.e., in order of appearance in the file
+	typedef std::map<int, DataPoint> SequenceEntry;
+
+	struct TimeStep {
+		double time;
+		SequenceEntry entries;
+	};
+
+	MappedFile file;
+	int windowSize;
+	// Handles of the aircraft in the window or read ahead. Handles increase in order of appearance in the file
+	std::map<std::string,int> handles;
+	// Aircraft name of every handle in handles
+	std::map<int,std::string> names;
+	int nextHandle;
+	std::string lastName;
+	// Last time steps read, up to window size
+	std::deque<TimeStep> window;
+	// Entry read ahead of the last time step
+	bool pending;
+	double pendingTime;
+	int pendingHandle;
+	DataPoint pendingPoint;
+	bool done;
+
+	void openInput(SeparatedInput si);
+	void init();
+	bool readDataLine();
+	bool processDataLine(double& tm, int& handle, DataPoint& dp);
+	int handleOf(const std::string& name);
+	void evict(const SequenceEntry& entries);
+	void buildActive();
+
+	SequenceStreamReader(const SequenceStreamReader& sr);
+	SequenceStreamReader& operator=(const SequenceStreamReader& sr);
+
+public:
+	/** A new, empty reader. */
+	SequenceStreamReader();
+
+	explicit SequenceStreamReader(const std::string& filename);
+
+	/** Start reading a new file. Parameters are preserved if they are not specified in the file. */
+	virtual void open(const std::string& filename);
+
+	/** Start reading a new stream, which is not owned by this reader. Parameters are preserved if they are not specified in the file. */
+	virtual void open(std::istream* in);
+
+	/**
+	 * Sets the window size, i.e., number of time steps kept in memory
+	 * @param s new window size
+	 */
+	void setWindowSize(int s);
+
+	/**
+	 * Returns the current window size
+	 * @return size
+	 */
+	int getWindowSize() const;
+
+	/**
+	 * Read the next time step and make it the active set of states.
+	 * @return false if there are no more time steps, in which case the active set is empty
+	 */
+	bool readNext();
+
+	/**
+	 * @return true if all time steps have been read
+	 */
+	bool atEnd() const;
+
+	/**
+	 * @return time of the last time step read or NaN if none
+	 */
+	double activeTime() const;
+
+};
+
+}
+
+#endif
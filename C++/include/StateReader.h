@@ -85,6 +85,7 @@ namespace larcfm {
 class StateReader: public ErrorReporter, public ParameterReader, public ParameterProvider {
 private:
 	void loadfile();
+	void openInput(SeparatedInput si);
 
 protected:
 	// we store the heading indices in the following order:
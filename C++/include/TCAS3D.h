@@ -79,6 +79,14 @@ public:
 
   ConflictData conflictDetection(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T) const;
 
+  /**
+   * Thresholds are the maximum over all sensitivity levels. When the HMD filter is enabled, a horizontal
+   * RA at time t implies that the max(DMOD,HMD) cylinder is horizontally entered before t+TAU. Otherwise,
+   * RAs are not horizontally bounded. A vertical RA at time t implies that the ZTHR cylinder is
+   * vertically entered before t+TCOA.
+   */
+  bool criticalCylinder(double& D, double& H, double& TH, double& TV, bool& exact) const;
+
   TCAS3D* copy() const;
   TCAS3D* make() const;
 
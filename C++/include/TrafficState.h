@@ -69,6 +69,17 @@ private:
   TrafficState(const std::string& id, const Position& pos, const Velocity& vel,
       EuclideanProjection eprj,int alerter);
 
+  /**
+   * Create a traffic state with given wind
+   * @param id Aircraft's identifier
+   * @param pos Aircraft's position
+   * @param vel Aircraft's ground velocity
+   * @param wind_vector Wind velocity specified in the TO direction
+   * @param eprj Euclidean projection
+   */
+  TrafficState(const std::string& id, const Position& pos, const Velocity& vel, const Velocity& wind_vector,
+      EuclideanProjection eprj,int alerter);
+
   /**
    * Apply Euclidean projection. Requires aircraft's position in lat/lon
    * @param eprj
@@ -105,6 +116,17 @@ public:
    */
   TrafficState makeIntruder(const std::string& id, const Position& pos, const Velocity& vel) const;
 
+  /**
+   * Make intruder aircraft with given wind. This is the same as makeIntruder followed by applyWindVector,
+   * but position and velocity are only projected once.
+   * @param id Intruder's identifier
+   * @param pos Intruder's position
+   * @param vel Intruder's ground velocity
+   * @param wind_vector Wind velocity specified in the TO direction
+   * @return
+   */
+  TrafficState makeIntruder(const std::string& id, const Position& pos, const Velocity& vel, const Velocity& wind_vector) const;
+
   /**
    * Set alerter index for this aircraft
    * @param alerter
@@ -296,6 +318,11 @@ public:
    */
   void resetUncertainty();
 
+  /**
+   * Set all uncertainties from SUM data
+   */
+  void setUncertainty(const SUMData& sum);
+
   bool sameId(const TrafficState& ac) const;
 
   std::string toString() const;
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2015-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#ifndef TRAFFICTRACK_H_
+#define TRAFFICTRACK_H_
+
+#include "Position.h"
+#include "Velocity.h"
+#include "SUMData.h"
+#include <string>
+
+namespace larcfm {
+
+/**
+ * Surveillance track of a traffic aircraft, i.e., its identifier, position, ground velocity, time stamp,
+ * alerter index, and SUM (Sensor Uncertainty Mitigation) data. Arrays of tracks are the input of
+ * Daidalus::setTrafficStates.
+ */
+class TrafficTrack {
+public:
+  std::string id;  // Aircraft's identifier
+  Position pos;    // Aircraft's position
+  Velocity vel;    // Aircraft's ground velocity
+  double time;     // Time stamp of aircraft's state
+  int alerter;     // Alerter index (1-based)
+  SUMData sum;     // SUM data
+
+  /**
+   * Create an invalid track
+   */
+  TrafficTrack();
+
+  /**
+   * Create a track with alerter index 1 and no uncertainty
+   */
+  TrafficTrack(const std::string& id, const Position& pos, const Velocity& vel, double time);
+
+  /**
+   * Create a track with given alerter index and SUM data
+   */
+  TrafficTrack(const std::string& id, const Position& pos, const Velocity& vel, double time,
+      int alerter, const SUMData& sum);
+
+};
+
+}
+
+#endif
@@ -529,6 +529,12 @@ public:
 	 */
 	static double parse_double(const std::string& str);
 
+	/**
+	 * Same as parse_double(std::string(begin,end)), but most decimal numbers are parsed in place,
+	 * without allocation.
+	 */
+	static double parse_double(const char* begin, const char* end);
+
 	/** @param degMinSec  Lat/Lon String of the form "46:55:00"  or "-111:57:00"
       @return   numbers of degrees in decimal form
 	 */
@@ -43,6 +43,11 @@ public:
 
   bool contains(const Detection3D* cd) const;
 
+  /**
+   * The vertical volume of WCV_HZ (VMOD) is not characterized by a cylinder.
+   */
+  virtual bool criticalCylinder(double& D, double& H, double& TH, double& TV, bool& exact) const;
+
 };
 }
 #endif
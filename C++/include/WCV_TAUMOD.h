@@ -72,6 +72,13 @@ public:
 
   virtual LossData horizontal_WCV_interval(double T, const Vect2& s, const Vect2& v) const ;
 
+  /**
+   * A horizontal violation at time t implies that the DTHR cylinder is horizontally entered
+   * before t+TTHR (tau mod is an upper bound of the time to entry). Similarly, a vertical violation at time t
+   * implies that the ZTHR cylinder is vertically entered before t+TCOA.
+   */
+  virtual bool criticalCylinder(double& D, double& H, double& TH, double& TV, bool& exact) const;
+
   virtual Detection3D* make() const;
 
   /**
@@ -54,8 +54,24 @@ public:
    */
   static const WCV_TAUMOD_SUM& DO_365_DWC_Non_Coop();
 
-  virtual ConflictData conflictDetectionWithTrafficState(const TrafficState& ownship, const TrafficState& intruder,
-      double B, double T) const;
+  virtual ConflictData conflictDetectionSUM(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi,
+      double B, double T, const SUMData& own_sum, const SUMData& ac_sum) const;
+
+  virtual LossData conflictIntervalSUM(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi,
+      double B, double T, const SUMData& own_sum, const SUMData& ac_sum) const;
+
+  /**
+   * Computes the conflicts of a batch with conflictIntervalSUM in a single loop.
+   */
+  virtual void conflictBatchSUM(std::vector<bool>& conflicts, const DetectionBatch& batch, const Vect3& si, const Velocity& vi,
+      const SUMData& own_sum, const SUMData& ac_sum) const;
+
+  /**
+   * Conflicts with sensor uncertainty are not characterized by a cylinder.
+   */
+  virtual bool criticalCylinder(double& D, double& H, double& TH, double& TV, bool& exact) const;
+
+  virtual double horizontalReachSUM(double T, double vh, const SUMData& own_sum, const SUMData& ac_sum) const;
 
 private:
 
@@ -81,6 +97,9 @@ private:
 
   static double MinError;
 
+  bool relative_errors(double& s_err, double& sz_err, double& v_err, double& vz_err,
+      const Vect3& so, const Vect3& si, const SUMData& own_sum, const SUMData& ac_sum) const;
+
   void initSUM();
 
   void copyFrom(const WCV_TAUMOD_SUM& wcv);
@@ -119,15 +138,15 @@ private:
 
   bool containsSUM(WCV_TAUMOD_SUM* wcv) const;
 
-  double relativeHorizontalPositionError(const TrafficState& own, const TrafficState& ac) const;
+  double relativeHorizontalPositionError(const SUMData& own_sum, const SUMData& ac_sum) const;
 
-  double relativeVerticalPositionError(const TrafficState& own, const TrafficState& ac) const;
+  double relativeVerticalPositionError(const SUMData& own_sum, const SUMData& ac_sum) const;
 
   double weighted_z_score(double range) const;
 
-  double relativeHorizontalSpeedError(const TrafficState& own, const TrafficState& ac, double s_err) const;
+  double relativeHorizontalSpeedError(const Vect3& so, const Vect3& si, const SUMData& own_sum, const SUMData& ac_sum, double s_err) const;
 
-  double relativeVerticalSpeedError(const TrafficState& own, const TrafficState& ac) const;
+  double relativeVerticalSpeedError(const SUMData& own_sum, const SUMData& ac_sum) const;
 
 public:
 
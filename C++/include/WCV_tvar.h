@@ -71,6 +71,15 @@ public:
 
   virtual ConflictData conflictDetection(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T) const;
 
+  virtual LossData conflictIntervalSUM(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T,
+      const SUMData& own_sum, const SUMData& ac_sum) const;
+
+  /**
+   * Computes the conflicts of a batch with WCV3D in a single loop (SUM data is ignored).
+   */
+  virtual void conflictBatchSUM(std::vector<bool>& conflicts, const DetectionBatch& batch, const Vect3& si, const Velocity& vi,
+      const SUMData& own_sum, const SUMData& ac_sum) const;
+
   LossData WCV3D(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T) const;
 
   LossData WCV_interval(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T) const;
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2015-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+#ifndef WORKERPOOL_H_
+#define WORKERPOOL_H_
+
+namespace larcfm {
+
+/**
+ * A unit of work that can be executed by a WorkerPool. The method execute(i) is
+ * called exactly once for each index i in [0,n), where n is the number of jobs
+ * given to WorkerPool::run. Calls for different indices may run concurrently.
+ */
+class WorkerTask {
+public:
+  virtual ~WorkerTask() {}
+  virtual void execute(int i) = 0;
+};
+
+/**
+ * A fixed-size pool of worker threads. The thread calling run participates
+ * in the computation, so a pool of n threads uses n-1 helper threads. Helper
+ * threads are started on first use. A pool of 1 thread (the default) runs every
+ * job serially in the calling thread.
+ *
+ * A call to run that happens while the pool is already running a task (e.g.,
+ * a nested call from a task) is executed serially in the calling thread.
+ *
+ * Copying a pool copies its configuration, not its threads.
+ */
+class WorkerPool {
+
+private:
+  struct Impl;
+  Impl* impl_;
+  int threads_;
+
+  void shutdown();
+
+public:
+  WorkerPool();
+
+  explicit WorkerPool(int threads);
+
+  WorkerPool(const WorkerPool& pool);
+
+  WorkerPool& operator=(const WorkerPool& pool);
+
+  ~WorkerPool();
+
+  /**
+   * Set number of threads used by this pool, including the calling thread.
+   * Values less than 1 are treated as 1.
+   */
+  void setNumberOfThreads(int threads);
+
+  /**
+   * @return number of threads used by this pool, including the calling thread.
+   */
+  int getNumberOfThreads() const;
+
+  /**
+   * @return true if this pool runs tasks with more than one thread.
+   */
+  bool isParallel() const;
+
+  /**
+   * @return true if this pool is currently running a task. In this case, calls to run
+   * are executed serially by the calling thread.
+   */
+  bool isRunning() const;
+
+  /**
+   * Call task.execute(i) for every i in [0,n). Returns when all jobs are done. If a job
+   * throws an exception, jobs that haven't started are skipped and the first exception is
+   * rethrown by run, as in the serial case.
+   */
+  void run(WorkerTask& task, int n);
+
+};
+
+}
+
+#endif
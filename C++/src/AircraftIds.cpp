@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2015-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+#include "AircraftIds.h"
+#include <string>
+#include <vector>
+
+namespace larcfm {
+
+AircraftIds::AircraftIds() : slots_(16,-1) {}
+
+/**
+ * FNV-1a hash of an identifier
+ */
+unsigned int AircraftIds::hash(const std::string& id) {
+  unsigned int h = 2166136261U;
+  for (std::string::size_type i = 0; i < id.size(); ++i) {
+    h ^= static_cast<unsigned char>(id[i]);
+    h *= 16777619U;
+  }
+  return h;
+}
+
+/**
+ * Returns the slot of identifier id, whose hash value is h, or the empty slot where it should be added.
+ */
+int AircraftIds::slot(const std::string& id, unsigned int h) const {
+  int mask = static_cast<int>(slots_.size())-1;
+  int i = static_cast<int>(h) & mask;
+  // Linear probing. There is always an empty slot since the table is at most half full.
+  while (slots_[i] >= 0 && (hashes_[slots_[i]] != h || ids_[slots_[i]] != id)) {
+    i = (i+1) & mask;
+  }
+  return i;
+}
+
+void AircraftIds::rehash(int capacity) {
+  slots_.assign(capacity,-1);
+  int mask = capacity-1;
+  for (int handle = 0; handle < static_cast<int>(ids_.size()); ++handle) {
+    int i = static_cast<int>(hashes_[handle]) & mask;
+    while (slots_[i] >= 0) {
+      i = (i+1) & mask;
+    }
+    slots_[i] = handle;
+  }
+}
+
+/**
+ * Remove all identifiers. Previous handles are no longer valid.
+ */
+void AircraftIds::clear() {
+  ids_.clear();
+  hashes_.clear();
+  slots_.assign(16,-1);
+}
+
+/**
+ * @return number of interned identifiers. Handles are the integers 0,...,size()-1.
+ */
+int AircraftIds::size() const {
+  return static_cast<int>(ids_.size());
+}
+
+/**
+ * @return handle of identifier id or -1 if id has not been interned
+ */
+int AircraftIds::find(const std::string& id) const {
+  return slots_[slot(id,hash(id))];
+}
+
+/**
+ * @return handle of identifier id. The identifier is interned if it's not already in the table.
+ */
+int AircraftIds::intern(const std::string& id) {
+  unsigned int h = hash(id);
+  int i = slot(id,h);
+  if (slots_[i] >= 0) {
+    return slots_[i];
+  }
+  int handle = static_cast<int>(ids_.size());
+  ids_.push_back(id);
+  hashes_.push_back(h);
+  if (2*ids_.size() > slots_.size()) {
+    rehash(2*static_cast<int>(slots_.size()));
+  } else {
+    slots_[i] = handle;
+  }
+  return handle;
+}
+
+/**
+ * @return identifier of given handle. Requires 0 <= handle < size().
+ */
+const std::string& AircraftIds::id(int handle) const {
+  return ids_[handle];
+}
+
+}
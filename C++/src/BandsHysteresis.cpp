@@ -146,16 +146,19 @@ void BandsHysteresis::m_of_n(std::vector<ColorValue>& lcvs) {
       }
     }
 
-    // Remove values whose of mofns queues are the same both sides
-    i_ptr = bands_mofn_.begin();
-    while (i_ptr != bands_mofn_.end()) {
-      if (i_ptr != bands_mofn_.begin() && (i_ptr+1) != bands_mofn_.end() &&
-          i_ptr->same_colors()) {
-        i_ptr = bands_mofn_.erase(i_ptr);
-      } else {
-        ++i_ptr;
+    // Remove values whose of mofns queues are the same both sides. The list is compacted in place
+    // so that its memory is reused in the next cycle
+    std::vector<BandsMofN>::iterator k_ptr = bands_mofn_.begin();
+    for (i_ptr = bands_mofn_.begin(); i_ptr != bands_mofn_.end(); ++i_ptr) {
+      if (i_ptr == bands_mofn_.begin() || (i_ptr+1) == bands_mofn_.end() ||
+          !i_ptr->same_colors()) {
+        if (k_ptr != i_ptr) {
+          *k_ptr = *i_ptr;
+        }
+        ++k_ptr;
       }
     }
+    bands_mofn_.erase(k_ptr,bands_mofn_.end());
   }
 }
 
@@ -148,6 +148,45 @@ ConflictData CDCylinder::conflictDetection(const Vect3& so, const Velocity& vo,
   return conflict_detection(so,vo,si,vi,D_,H_,B,T);
 }
 
+LossData CDCylinder::conflictIntervalSUM(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T,
+    const SUMData& own_sum, const SUMData& ac_sum) const {
+  return CD3D::detection(so.Sub(si),vo,vi,D_,H_,B,T);
+}
+
+/**
+ * Computes the conflicts of a batch with the cylinder in a single loop (SUM data is ignored).
+ */
+void CDCylinder::conflictBatchSUM(std::vector<bool>& conflicts, const DetectionBatch& batch, const Vect3& si, const Velocity& vi,
+    const SUMData& own_sum, const SUMData& ac_sum) const {
+  conflicts.resize(batch.size());
+  double end;
+  for (int i = 0; i < batch.size(); ++i) {
+    double B = batch.B(i);
+    double T = batch.T(i);
+    conflicts[i] = probeInterval(B,T,end) &&
+        probeConflict(CD3D::detection(batch.so(i).Sub(si),batch.vo(i),vi,D_,H_,B,end),B,T);
+  }
+}
+
+/**
+ * Loss interval with the cylinder, not bounded in time (SUM data is ignored). Clipped to [B,T], this is the
+ * interval of CD3D::detection.
+ */
+bool CDCylinder::lossIntervalSUM(LossData& interval, const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi,
+    const SUMData& own_sum, const SUMData& ac_sum) const {
+  interval = CD3D::detectionActual(so.Sub(si),vo,vi,D_,H_);
+  return true;
+}
+
+bool CDCylinder::criticalCylinder(double& D, double& H, double& TH, double& TV, bool& exact) const {
+  D = D_;
+  H = H_;
+  TH = 0;
+  TV = 0;
+  exact = true;
+  return true;
+}
+
 double CDCylinder::time_of_closest_approach(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double D, double H, double B, double T) {
   return CD3D::tccpa(so.Sub(si),vo,vi,D,H,B,T);
 }
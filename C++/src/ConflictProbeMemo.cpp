@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2015-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+#include "ConflictProbeMemo.h"
+#include "Util.h"
+#include <map>
+#include <vector>
+
+namespace larcfm {
+
+ConflictProbeMemo::Probes::Probes() : los_(-1), profile_(-1) {}
+
+/* Conflict status in [B,T] of the loss interval clipped to [B,T], as in Detection3D::conflictSUM */
+bool ConflictProbeMemo::Probes::loss_conflict(double B, double T) const {
+  double end;
+  if (!Detection3D::probeInterval(B,T,end)) {
+    return false;
+  }
+  LossData clipped(Util::min(Util::max(loss_.getTimeIn(),B),end),Util::max(Util::min(loss_.getTimeOut(),end),B));
+  return Detection3D::probeConflict(clipped,B,T);
+}
+
+/**
+ * If the conflict status in [B,T] follows from stored probes, set conflict to that status and return true.
+ * Otherwise, return false.
+ */
+bool ConflictProbeMemo::Probes::lookup(bool& conflict, double B, double T) const {
+  if (profile_ == 1) {
+    conflict = loss_conflict(B,T);
+    return true;
+  }
+  // Otherwise, only probes in time intervals that are not reduced to a point are memoized
+  if (Util::almost_equals(B,T)) {
+    return false;
+  }
+  std::vector<std::pair<double,double> >::const_iterator int_ptr;
+  // A conflict in a subinterval of [B,T] is a conflict in [B,T]
+  for (int_ptr = conflict_.begin(); int_ptr != conflict_.end(); ++int_ptr) {
+    if (B <= int_ptr->first && int_ptr->second <= T) {
+      conflict = true;
+      return true;
+    }
+  }
+  // No conflict in an interval that contains [B,T] means no conflict in [B,T]
+  for (int_ptr = free_.begin(); int_ptr != free_.end(); ++int_ptr) {
+    if (int_ptr->first <= B && T <= int_ptr->second) {
+      conflict = false;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Store the conflict status in [B,T].
+ */
+void ConflictProbeMemo::Probes::store(bool conflict, double B, double T) {
+  if (Util::almost_equals(B,T)) {
+    return;
+  }
+  if (conflict) {
+    conflict_.push_back(std::pair<double,double>(B,T));
+  } else {
+    free_.push_back(std::pair<double,double>(B,T));
+  }
+}
+
+/**
+ * If the violation status at time t of the step is known, set los to that status and return true.
+ * Otherwise, return false.
+ */
+bool ConflictProbeMemo::Probes::lookup_los(bool& los, double t) const {
+  if (profile_ == 1) {
+    // As in Detection3D::violationAtSUM
+    los = loss_conflict(t,t);
+    return true;
+  }
+  if (los_ < 0) {
+    return false;
+  }
+  los = los_ == 1;
+  return true;
+}
+
+/**
+ * Store the violation status at the time of the step.
+ */
+void ConflictProbeMemo::Probes::store_los(bool los) {
+  los_ = los ? 1 : 0;
+}
+
+/**
+ * Store the loss interval of det for the linear projection so,vo of the step against si,vi, unless it is
+ * already known. Return true if det has a loss interval.
+ */
+bool ConflictProbeMemo::Probes::store_profile(const Detection3D* det, const Vect3& so, const Velocity& vo,
+    const Vect3& si, const Velocity& vi, const SUMData& own_sum, const SUMData& ac_sum) {
+  if (profile_ < 0) {
+    profile_ = det->lossIntervalSUM(loss_,so,vo,si,vi,own_sum,ac_sum) ? 1 : 0;
+  }
+  return profile_ == 1;
+}
+
+/**
+ * Remove all aircraft and probes.
+ */
+void ConflictProbeMemo::clear() {
+  aircraft_.clear();
+}
+
+/**
+ * Add traffic aircraft to the memo. Probes are only memoized for added aircraft.
+ */
+void ConflictProbeMemo::add(const TrafficState& traffic) {
+  std::map<const TrafficState*,Aircraft>::iterator ac_ptr = aircraft_.find(&traffic);
+  if (ac_ptr == aircraft_.end()) {
+    aircraft_[&traffic] = Aircraft();
+  } else {
+    // Aircraft that are added more than once may be probed concurrently
+    ac_ptr->second.unique = false;
+    ac_ptr->second.tables.clear();
+  }
+}
+
+/**
+ * Return probes of traffic with detector det at sample k of trajectory idx, where idx >= 0. If k < 0, the
+ * sample is identified by its time. Return NULL if probes of traffic are not memoized.
+ */
+ConflictProbeMemo::Probes* ConflictProbeMemo::probes(const TrafficState& traffic, const Detection3D* det, int idx, int k, double time) {
+  std::map<const TrafficState*,Aircraft>::iterator ac_ptr = aircraft_.find(&traffic);
+  if (ac_ptr == aircraft_.end() || !ac_ptr->second.unique) {
+    return NULL;
+  }
+  std::vector<Table>& tables = ac_ptr->second.tables;
+  // There are only a few detectors per aircraft
+  int i = 0;
+  while (i < static_cast<int>(tables.size()) && tables[i].det != det) {
+    ++i;
+  }
+  if (i == static_cast<int>(tables.size())) {
+    tables.push_back(Table());
+    tables[i].det = det;
+  }
+  std::vector<Samples>& samples = tables[i].samples;
+  if (idx >= static_cast<int>(samples.size())) {
+    samples.resize(idx+1);
+  }
+  if (k >= 0) {
+    std::vector<Probes>& steps = samples[idx].steps;
+    if (k >= static_cast<int>(steps.size())) {
+      steps.resize(k+1);
+    }
+    return &steps[k];
+  }
+  // There are only a few samples that are not multiples of the time step
+  std::vector<std::pair<double,Probes> >& others = samples[idx].others;
+  std::vector<std::pair<double,Probes> >::iterator other_ptr;
+  for (other_ptr = others.begin(); other_ptr != others.end(); ++other_ptr) {
+    if (other_ptr->first == time) {
+      return &other_ptr->second;
+    }
+  }
+  others.push_back(std::pair<double,Probes>(time,Probes()));
+  return &others.back().second;
+}
+
+}
@@ -65,7 +65,7 @@ namespace larcfm {
     return groundSpeeds(s,vo,vi,D,H,0,T);
   }
 
-  std::list<double> verticalSpeeds1D(const double sz, const double viz,
+  std::list<double> CriticalVectors::verticalSpeeds1D(const double sz, const double viz,
 				     const double H, const double B, const double T) {
     std::list<double> vss;
     Vertical nvoz;
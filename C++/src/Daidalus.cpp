@@ -324,6 +324,38 @@ int Daidalus::addTrafficState(const std::string& id, const Position& pos, const
   return addTrafficState(id,pos,vel,core_.current_time);
 }
 
+/**
+ * Add or update traffic states in bulk from n tracks. This is the same as calling addTrafficState,
+ * setAlerterIndex, and SUM setters for every track, but cached values are invalidated only once.
+ * Requires ownship to be set. Tracks whose identifier is the same as ownship's are ignored.
+ * @param tracks Array of traffic tracks
+ * @param n Number of tracks
+ * @return Number of traffic states that were set
+ */
+int Daidalus::setTrafficStates(const TrafficTrack* tracks, int n) {
+  if (!hasOwnship()) {
+    error.addError("setTrafficStates: ownship has not been set");
+    return 0;
+  }
+  int count = core_.set_traffic_states(tracks,n);
+  if (count > 0) {
+    stale_bands();
+  }
+  return count;
+}
+
+/**
+ * Add or update traffic states in bulk from a list of tracks.
+ * @param tracks List of traffic tracks
+ * @return Number of traffic states that were set
+ */
+int Daidalus::setTrafficStates(const std::vector<TrafficTrack>& tracks) {
+  if (tracks.empty()) {
+    return 0;
+  }
+  return setTrafficStates(&tracks[0],static_cast<int>(tracks.size()));
+}
+
 
 /**
  * Get index of aircraft with given name. Return -1 if no such index exists
@@ -677,6 +709,94 @@ TrafficState Daidalus::mostUrgentAircraft() {
   return core_.mostUrgentAircraft();
 }
 
+/**
+ * Set number of threads, including the calling thread, used to compute alerting and bands.
+ * When threads > 1, alert levels and bands contributed by different aircraft are computed
+ * concurrently. Results are identical to the ones computed serially. Default is 1.
+ */
+void Daidalus::setNumberOfThreads(int threads) {
+  core_.worker_pool().setNumberOfThreads(threads);
+}
+
+/**
+ * @return number of threads used to compute bands.
+ */
+int Daidalus::getNumberOfThreads() const {
+  return core_.worker_pool().getNumberOfThreads();
+}
+
+/* Coarse-to-fine search of kinematic bands */
+
+/**
+ * Set stride, in number of steps, of the coarse-to-fine search of kinematic bands. When stride > 1,
+ * a whole stride is skipped when a bound shows that conflict status doesn't change within it, e.g.,
+ * when traffic is out of horizontal reach of ownship. Other strides are refined down to every step.
+ * Therefore, bands are the same as in the exhaustive search. Default is 1, i.e., every step is checked.
+ */
+void Daidalus::setBandsSearchStride(int stride) {
+  if (stride < 1) {
+    stride = 1;
+  }
+  if (stride != core_.search_stride()) {
+    core_.set_search_stride(stride);
+    reset();
+  }
+}
+
+/**
+ * @return stride, in number of steps, of the coarse-to-fine search of kinematic bands.
+ */
+int Daidalus::getBandsSearchStride() const {
+  return core_.search_stride();
+}
+
+/* Incremental kinematic trajectories */
+
+/**
+ * Set period, in number of time steps, at which samples of kinematic turn trajectories are computed
+ * exactly. Samples in between are computed by rotating the velocity of the previous sample, which
+ * avoids trigonometric functions but accumulates rounding errors between exact samples. Default is 1,
+ * i.e., every sample is computed exactly.
+ */
+void Daidalus::setBandsTrajectoryAnchorPeriod(int period) {
+  if (period < 1) {
+    period = 1;
+  }
+  if (period != core_.trajectory_anchor_period()) {
+    core_.set_trajectory_anchor_period(period);
+    reset();
+  }
+}
+
+/**
+ * @return period, in number of time steps, at which samples of kinematic turn trajectories are computed exactly.
+ */
+int Daidalus::getBandsTrajectoryAnchorPeriod() const {
+  return core_.trajectory_anchor_period();
+}
+
+/* Pre-filter of traffic aircraft */
+
+/**
+ * Enable/disable a conservative pre-filter of traffic aircraft. When enabled, detectors are not
+ * evaluated on aircraft that are horizontally too far from ownship to be in conflict within lookahead
+ * time, assuming that ownship horizontal speed doesn't exceed the largest of its current speed
+ * and the maximum horizontal speed. Default is disabled.
+ */
+void Daidalus::setTrafficPreFilter(bool flag) {
+  if (flag != core_.traffic_prefilter()) {
+    core_.set_traffic_prefilter(flag);
+    reset();
+  }
+}
+
+/**
+ * @return true if the conservative pre-filter of traffic aircraft is enabled.
+ */
+bool Daidalus::isEnabledTrafficPreFilter() const {
+  return core_.traffic_prefilter();
+}
+
 /* Computation of contours, a.k.a. blobs, and hazard zones */
 
 /**
@@ -1254,7 +1374,7 @@ bool Daidalus::isEnabledBandsPersistence() const {
  */
 void Daidalus::setBandsPersistence(bool flag) {
   core_.parameters.setBandsPersistence(flag);
-  reset();
+  invalidate(RES_DEP);
 }
 
 /**
@@ -1390,7 +1510,7 @@ void Daidalus::setLookaheadTime(double t, const std::string& u) {
  */
 void Daidalus::setLeftHorizontalDirection(double val) {
   core_.parameters.setLeftHorizontalDirection(val);
-  reset();
+  invalidate(HDIR_TRAJ_DEP);
 }
 
 /**
@@ -1398,7 +1518,7 @@ void Daidalus::setLeftHorizontalDirection(double val) {
  */
 void Daidalus::setLeftHorizontalDirection(double val, const std::string& u) {
   core_.parameters.setLeftHorizontalDirection(val,u);
-  reset();
+  invalidate(HDIR_TRAJ_DEP);
 }
 
 /**
@@ -1406,7 +1526,7 @@ void Daidalus::setLeftHorizontalDirection(double val, const std::string& u) {
  */
 void Daidalus::setRightHorizontalDirection(double val) {
   core_.parameters.setRightHorizontalDirection(val);
-  reset();
+  invalidate(HDIR_TRAJ_DEP);
 }
 
 /**
@@ -1414,7 +1534,7 @@ void Daidalus::setRightHorizontalDirection(double val) {
  */
 void Daidalus::setRightHorizontalDirection(double val, const std::string& u) {
   core_.parameters.setRightHorizontalDirection(val,u);
-  reset();
+  invalidate(HDIR_TRAJ_DEP);
 }
 
 /**
@@ -1422,7 +1542,7 @@ void Daidalus::setRightHorizontalDirection(double val, const std::string& u) {
  */
 void Daidalus::setMinHorizontalSpeed(double val) {
   core_.parameters.setMinHorizontalSpeed(val);
-  reset();
+  invalidate(HS_TRAJ_DEP);
 }
 
 /**
@@ -1430,7 +1550,7 @@ void Daidalus::setMinHorizontalSpeed(double val) {
  */
 void Daidalus::setMinHorizontalSpeed(double val, const std::string& u) {
   core_.parameters.setMinHorizontalSpeed(val,u);
-  reset();
+  invalidate(HS_TRAJ_DEP);
 }
 
 /**
@@ -1438,7 +1558,7 @@ void Daidalus::setMinHorizontalSpeed(double val, const std::string& u) {
  */
 void Daidalus::setMaxHorizontalSpeed(double val) {
   core_.parameters.setMaxHorizontalSpeed(val);
-  reset();
+  invalidate(max_hs_dependency());
 }
 
 /**
@@ -1446,7 +1566,7 @@ void Daidalus::setMaxHorizontalSpeed(double val) {
  */
 void Daidalus::setMaxHorizontalSpeed(double val, const std::string& u) {
   core_.parameters.setMaxHorizontalSpeed(val,u);
-  reset();
+  invalidate(max_hs_dependency());
 }
 
 /**
@@ -1454,7 +1574,7 @@ void Daidalus::setMaxHorizontalSpeed(double val, const std::string& u) {
  */
 void Daidalus::setMinVerticalSpeed(double val) {
   core_.parameters.setMinVerticalSpeed(val);
-  reset();
+  invalidate(VS_TRAJ_DEP);
 }
 
 /**
@@ -1462,7 +1582,7 @@ void Daidalus::setMinVerticalSpeed(double val) {
  */
 void Daidalus::setMinVerticalSpeed(double val, const std::string& u) {
   core_.parameters.setMinVerticalSpeed(val,u);
-  reset();
+  invalidate(VS_TRAJ_DEP);
 }
 
 /**
@@ -1470,7 +1590,7 @@ void Daidalus::setMinVerticalSpeed(double val, const std::string& u) {
  */
 void Daidalus::setMaxVerticalSpeed(double val) {
   core_.parameters.setMaxVerticalSpeed(val);
-  reset();
+  invalidate(VS_TRAJ_DEP);
 }
 
 /**
@@ -1478,7 +1598,7 @@ void Daidalus::setMaxVerticalSpeed(double val) {
  */
 void Daidalus::setMaxVerticalSpeed(double val, const std::string& u) {
   core_.parameters.setMaxVerticalSpeed(val,u);
-  reset();
+  invalidate(VS_TRAJ_DEP);
 }
 
 /**
@@ -1486,7 +1606,7 @@ void Daidalus::setMaxVerticalSpeed(double val, const std::string& u) {
  */
 void Daidalus::setMinAltitude(double val) {
   core_.parameters.setMinAltitude(val);
-  reset();
+  invalidate(ALT_TRAJ_DEP);
 }
 
 /**
@@ -1494,7 +1614,7 @@ void Daidalus::setMinAltitude(double val) {
  */
 void Daidalus::setMinAltitude(double val, const std::string& u) {
   core_.parameters.setMinAltitude(val,u);
-  reset();
+  invalidate(ALT_TRAJ_DEP);
 }
 
 /**
@@ -1502,7 +1622,7 @@ void Daidalus::setMinAltitude(double val, const std::string& u) {
  */
 void Daidalus::setMaxAltitude(double val) {
   core_.parameters.setMaxAltitude(val);
-  reset();
+  invalidate(ALT_TRAJ_DEP);
 }
 
 /**
@@ -1510,7 +1630,7 @@ void Daidalus::setMaxAltitude(double val) {
  */
 void Daidalus::setMaxAltitude(double val, const std::string& u) {
   core_.parameters.setMaxAltitude(val,u);
-  reset();
+  invalidate(ALT_TRAJ_DEP);
 }
 
 /**
@@ -1519,7 +1639,7 @@ void Daidalus::setMaxAltitude(double val, const std::string& u) {
  */
 void Daidalus::setBelowRelativeHorizontalSpeed(double val) {
   core_.parameters.setBelowRelativeHorizontalSpeed(val);
-  reset();
+  invalidate(HS_TRAJ_DEP);
 }
 
 /**
@@ -1528,7 +1648,7 @@ void Daidalus::setBelowRelativeHorizontalSpeed(double val) {
  */
 void Daidalus::setBelowRelativeHorizontalSpeed(double val,std::string u) {
   core_.parameters.setBelowRelativeHorizontalSpeed(val,u);
-  reset();
+  invalidate(HS_TRAJ_DEP);
 }
 
 /**
@@ -1537,7 +1657,7 @@ void Daidalus::setBelowRelativeHorizontalSpeed(double val,std::string u) {
  */
 void Daidalus::setAboveRelativeHorizontalSpeed(double val) {
   core_.parameters.setAboveRelativeHorizontalSpeed(val);
-  reset();
+  invalidate(HS_TRAJ_DEP);
 }
 
 /**
@@ -1546,7 +1666,7 @@ void Daidalus::setAboveRelativeHorizontalSpeed(double val) {
  */
 void Daidalus::setAboveRelativeHorizontalSpeed(double val, const std::string& u) {
   core_.parameters.setAboveRelativeHorizontalSpeed(val,u);
-  reset();
+  invalidate(HS_TRAJ_DEP);
 }
 
 /**
@@ -1555,7 +1675,7 @@ void Daidalus::setAboveRelativeHorizontalSpeed(double val, const std::string& u)
  */
 void Daidalus::setBelowRelativeVerticalSpeed(double val) {
   core_.parameters.setBelowRelativeHorizontalSpeed(val);
-  reset();
+  invalidate(VS_TRAJ_DEP);
 }
 
 /**
@@ -1564,7 +1684,7 @@ void Daidalus::setBelowRelativeVerticalSpeed(double val) {
  */
 void Daidalus::setBelowRelativeVerticalSpeed(double val, const std::string& u) {
   core_.parameters.setBelowRelativeVerticalSpeed(val,u);
-  reset();
+  invalidate(VS_TRAJ_DEP);
 }
 
 /**
@@ -1573,7 +1693,7 @@ void Daidalus::setBelowRelativeVerticalSpeed(double val, const std::string& u) {
  */
 void Daidalus::setAboveRelativeVerticalSpeed(double val) {
   core_.parameters.setAboveRelativeVerticalSpeed(val);
-  reset();
+  invalidate(VS_TRAJ_DEP);
 }
 
 /**
@@ -1582,7 +1702,7 @@ void Daidalus::setAboveRelativeVerticalSpeed(double val) {
  */
 void Daidalus::setAboveRelativeVerticalSpeed(double val, const std::string& u) {
   core_.parameters.setAboveRelativeVerticalSpeed(val,u);
-  reset();
+  invalidate(VS_TRAJ_DEP);
 }
 
 /**
@@ -1591,7 +1711,7 @@ void Daidalus::setAboveRelativeVerticalSpeed(double val, const std::string& u) {
  */
 void Daidalus::setBelowRelativeAltitude(double val) {
   core_.parameters.setBelowRelativeAltitude(val);
-  reset();
+  invalidate(ALT_TRAJ_DEP);
 }
 
 /**
@@ -1600,7 +1720,7 @@ void Daidalus::setBelowRelativeAltitude(double val) {
  */
 void Daidalus::setBelowRelativeAltitude(double val, const std::string& u) {
   core_.parameters.setBelowRelativeAltitude(val,u);
-  reset();
+  invalidate(ALT_TRAJ_DEP);
 }
 
 /**
@@ -1609,7 +1729,7 @@ void Daidalus::setBelowRelativeAltitude(double val, const std::string& u) {
  */
 void Daidalus::setAboveRelativeAltitude(double val) {
   core_.parameters.setAboveRelativeAltitude(val);
-  reset();
+  invalidate(ALT_TRAJ_DEP);
 }
 
 /**
@@ -1618,7 +1738,7 @@ void Daidalus::setAboveRelativeAltitude(double val) {
  */
 void Daidalus::setAboveRelativeAltitude(double val, const std::string& u) {
   core_.parameters.setAboveRelativeAltitude(val,u);
-  reset();
+  invalidate(ALT_TRAJ_DEP);
 }
 
 /**
@@ -1692,7 +1812,7 @@ void Daidalus::disableRelativeAltitude() {
  */
 void Daidalus::setHorizontalDirectionStep(double val) {
   core_.parameters.setHorizontalDirectionStep(val);
-  reset();
+  invalidate(HDIR_TRAJ_DEP);
 }
 
 /**
@@ -1700,7 +1820,7 @@ void Daidalus::setHorizontalDirectionStep(double val) {
  */
 void Daidalus::setHorizontalDirectionStep(double val, const std::string& u) {
   core_.parameters.setHorizontalDirectionStep(val,u);
-  reset();
+  invalidate(HDIR_TRAJ_DEP);
 }
 
 /**
@@ -1708,7 +1828,7 @@ void Daidalus::setHorizontalDirectionStep(double val, const std::string& u) {
  */
 void Daidalus::setHorizontalSpeedStep(double val) {
   core_.parameters.setHorizontalSpeedStep(val);
-  reset();
+  invalidate(HS_TRAJ_DEP);
 }
 
 /**
@@ -1716,7 +1836,7 @@ void Daidalus::setHorizontalSpeedStep(double val) {
  */
 void Daidalus::setHorizontalSpeedStep(double val, const std::string& u) {
   core_.parameters.setHorizontalSpeedStep(val,u);
-  reset();
+  invalidate(HS_TRAJ_DEP);
 }
 
 /**
@@ -1724,7 +1844,7 @@ void Daidalus::setHorizontalSpeedStep(double val, const std::string& u) {
  */
 void Daidalus::setVerticalSpeedStep(double val) {
   core_.parameters.setVerticalSpeedStep(val);
-  reset();
+  invalidate(VS_TRAJ_DEP);
 }
 
 /**
@@ -1732,7 +1852,7 @@ void Daidalus::setVerticalSpeedStep(double val) {
  */
 void Daidalus::setVerticalSpeedStep(double val, const std::string& u) {
   core_.parameters.setVerticalSpeedStep(val,u);
-  reset();
+  invalidate(VS_TRAJ_DEP);
 }
 
 /**
@@ -1740,7 +1860,7 @@ void Daidalus::setVerticalSpeedStep(double val, const std::string& u) {
  */
 void Daidalus::setAltitudeStep(double val) {
   core_.parameters.setAltitudeStep(val);
-  reset();
+  invalidate(ALT_TRAJ_DEP);
 }
 
 /**
@@ -1748,7 +1868,7 @@ void Daidalus::setAltitudeStep(double val) {
  */
 void Daidalus::setAltitudeStep(double val, const std::string& u) {
   core_.parameters.setAltitudeStep(val,u);
-  reset();
+  invalidate(ALT_TRAJ_DEP);
 }
 
 /**
@@ -1756,7 +1876,7 @@ void Daidalus::setAltitudeStep(double val, const std::string& u) {
  */
 void Daidalus::setHorizontalAcceleration(double val) {
   core_.parameters.setHorizontalAcceleration(val);
-  reset();
+  invalidate(HS_TRAJ_DEP);
 }
 
 /**
@@ -1764,7 +1884,7 @@ void Daidalus::setHorizontalAcceleration(double val) {
  */
 void Daidalus::setHorizontalAcceleration(double val, const std::string& u) {
   core_.parameters.setHorizontalAcceleration(val,u);
-  reset();
+  invalidate(HS_TRAJ_DEP);
 }
 
 /**
@@ -1773,7 +1893,7 @@ void Daidalus::setHorizontalAcceleration(double val, const std::string& u) {
  */
 void Daidalus::setVerticalAcceleration(double val) {
   core_.parameters.setVerticalAcceleration(val);
-  reset();
+  invalidate(VS_TRAJ_DEP | ALT_TRAJ_DEP);
 }
 
 /**
@@ -1782,7 +1902,7 @@ void Daidalus::setVerticalAcceleration(double val) {
  */
 void Daidalus::setVerticalAcceleration(double val, const std::string& u) {
   core_.parameters.setVerticalAcceleration(val,u);
-  reset();
+  invalidate(VS_TRAJ_DEP | ALT_TRAJ_DEP);
 }
 
 /**
@@ -1791,7 +1911,7 @@ void Daidalus::setVerticalAcceleration(double val, const std::string& u) {
  */
 void Daidalus::setTurnRate(double val) {
   core_.parameters.setTurnRate(val);
-  reset();
+  invalidate(HDIR_TRAJ_DEP);
 }
 
 /**
@@ -1800,7 +1920,7 @@ void Daidalus::setTurnRate(double val) {
  */
 void Daidalus::setTurnRate(double val, const std::string& u) {
   core_.parameters.setTurnRate(val,u);
-  reset();
+  invalidate(HDIR_TRAJ_DEP);
 }
 
 /**
@@ -1809,7 +1929,7 @@ void Daidalus::setTurnRate(double val, const std::string& u) {
  */
 void Daidalus::setBankAngle(double val) {
   core_.parameters.setBankAngle(val);
-  reset();
+  invalidate(HDIR_TRAJ_DEP);
 }
 
 /**
@@ -1818,7 +1938,7 @@ void Daidalus::setBankAngle(double val) {
  */
 void Daidalus::setBankAngle(double val, const std::string& u) {
   core_.parameters.setBankAngle(val,u);
-  reset();
+  invalidate(HDIR_TRAJ_DEP);
 }
 
 /**
@@ -1826,7 +1946,7 @@ void Daidalus::setBankAngle(double val, const std::string& u) {
  */
 void Daidalus::setVerticalRate(double val) {
   core_.parameters.setVerticalRate(val);
-  reset();
+  invalidate(ALT_TRAJ_DEP);
 }
 
 /**
@@ -1834,7 +1954,7 @@ void Daidalus::setVerticalRate(double val) {
  */
 void Daidalus::setVerticalRate(double val, const std::string& u) {
   core_.parameters.setVerticalRate(val,u);
-  reset();
+  invalidate(ALT_TRAJ_DEP);
 }
 
 /**
@@ -1842,7 +1962,7 @@ void Daidalus::setVerticalRate(double val, const std::string& u) {
  */
 void Daidalus::setHorizontalNMAC(double val) {
   core_.parameters.setHorizontalNMAC(val);
-  reset();
+  invalidate(RES_DEP);
 }
 
 /**
@@ -1850,7 +1970,7 @@ void Daidalus::setHorizontalNMAC(double val) {
  */
 void Daidalus::setHorizontalNMAC(double val, const std::string& u) {
   core_.parameters.setHorizontalNMAC(val,u);
-  reset();
+  invalidate(RES_DEP);
 }
 
 /**
@@ -1858,7 +1978,7 @@ void Daidalus::setHorizontalNMAC(double val, const std::string& u) {
  */
 void Daidalus::setVerticalNMAC(double val) {
   core_.parameters.setVerticalNMAC(val);
-  reset();
+  invalidate(RES_DEP);
 }
 
 /**
@@ -1866,7 +1986,7 @@ void Daidalus::setVerticalNMAC(double val) {
  */
 void Daidalus::setVerticalNMAC(double val, const std::string& u) {
   core_.parameters.setVerticalNMAC(val,u);
-  reset();
+  invalidate(RES_DEP);
 }
 
 /**
@@ -1875,7 +1995,7 @@ void Daidalus::setVerticalNMAC(double val, const std::string& u) {
  */
 void Daidalus::setRecoveryStabilityTime(double t) {
   core_.parameters.setRecoveryStabilityTime(t);
-  reset();
+  invalidate(RES_DEP);
 }
 
 /**
@@ -1884,7 +2004,7 @@ void Daidalus::setRecoveryStabilityTime(double t) {
  */
 void Daidalus::setRecoveryStabilityTime(double t, const std::string& u) {
   core_.parameters.setRecoveryStabilityTime(t,u);
-  reset();
+  invalidate(RES_DEP);
 }
 
 /**
@@ -1924,7 +2044,7 @@ void Daidalus::setPersistenceTime(double val, const std::string& u) {
  */
 void Daidalus::setPersistencePreferredHorizontalDirectionResolution(double val) {
   core_.parameters.setPersistencePreferredHorizontalDirectionResolution(val);
-  reset();
+  invalidate(HDIR_RES_DEP);
 }
 
 /**
@@ -1932,7 +2052,7 @@ void Daidalus::setPersistencePreferredHorizontalDirectionResolution(double val)
  */
 void Daidalus::setPersistencePreferredHorizontalDirectionResolution(double val, const std::string& u) {
   core_.parameters.setPersistencePreferredHorizontalDirectionResolution(val,u);
-  reset();
+  invalidate(HDIR_RES_DEP);
 }
 
 /**
@@ -1940,7 +2060,7 @@ void Daidalus::setPersistencePreferredHorizontalDirectionResolution(double val,
  */
 void Daidalus::setPersistencePreferredHorizontalSpeedResolution(double val) {
   core_.parameters.setPersistencePreferredHorizontalSpeedResolution(val);
-  reset();
+  invalidate(HS_RES_DEP);
 }
 
 /**
@@ -1948,7 +2068,7 @@ void Daidalus::setPersistencePreferredHorizontalSpeedResolution(double val) {
  */
 void Daidalus::setPersistencePreferredHorizontalSpeedResolution(double val, const std::string& u) {
   core_.parameters.setPersistencePreferredHorizontalSpeedResolution(val,u);
-  reset();
+  invalidate(HS_RES_DEP);
 }
 
 /**
@@ -1956,7 +2076,7 @@ void Daidalus::setPersistencePreferredHorizontalSpeedResolution(double val, cons
  */
 void Daidalus::setPersistencePreferredVerticalSpeedResolution(double val) {
   core_.parameters.setPersistencePreferredVerticalSpeedResolution(val);
-  reset();
+  invalidate(VS_RES_DEP);
 }
 
 /**
@@ -1964,7 +2084,7 @@ void Daidalus::setPersistencePreferredVerticalSpeedResolution(double val) {
  */
 void Daidalus::setPersistencePreferredVerticalSpeedResolution(double val, const std::string& u) {
   core_.parameters.setPersistencePreferredVerticalSpeedResolution(val,u);
-  reset();
+  invalidate(VS_RES_DEP);
 }
 
 /**
@@ -1972,7 +2092,7 @@ void Daidalus::setPersistencePreferredVerticalSpeedResolution(double val, const
  */
 void Daidalus::setPersistencePreferredAltitudeResolution(double val) {
   core_.parameters.setPersistencePreferredAltitudeResolution(val);
-  reset();
+  invalidate(ALT_RES_DEP);
 }
 
 /**
@@ -1980,7 +2100,7 @@ void Daidalus::setPersistencePreferredAltitudeResolution(double val) {
  */
 void Daidalus::setPersistencePreferredAltitudeResolution(double val, const std::string& u) {
   core_.parameters.setPersistencePreferredAltitudeResolution(val,u);
-  reset();
+  invalidate(ALT_RES_DEP);
 }
 
 /**
@@ -1996,7 +2116,7 @@ void Daidalus::setAlertingMofN(int m, int n) {
  */
 void Daidalus::setMinHorizontalRecovery(double val) {
   core_.parameters.setMinHorizontalRecovery(val);
-  reset();
+  invalidate(RES_DEP);
 }
 
 /**
@@ -2004,7 +2124,7 @@ void Daidalus::setMinHorizontalRecovery(double val) {
  */
 void Daidalus::setMinHorizontalRecovery(double val, const std::string& u) {
   core_.parameters.setMinHorizontalRecovery(val,u);
-  reset();
+  invalidate(RES_DEP);
 }
 
 /**
@@ -2012,7 +2132,7 @@ void Daidalus::setMinHorizontalRecovery(double val, const std::string& u) {
  */
 void Daidalus::setMinVerticalRecovery(double val) {
   core_.parameters.setMinVerticalRecovery(val);
-  reset();
+  invalidate(RES_DEP);
 }
 
 /**
@@ -2020,7 +2140,7 @@ void Daidalus::setMinVerticalRecovery(double val) {
  */
 void Daidalus::setMinVerticalRecovery(double val, const std::string& u) {
   core_.parameters.setMinVerticalRecovery(val,u);
-  reset();
+  invalidate(RES_DEP);
 }
 
 /**
@@ -2160,7 +2280,7 @@ void Daidalus::disableRecoveryBands() {
  */
 void Daidalus::setRecoveryHorizontalDirectionBands(bool flag) {
   core_.parameters.setRecoveryHorizontalDirectionBands(flag);
-  reset();
+  invalidate(HDIR_RES_DEP);
 }
 
 /**
@@ -2168,7 +2288,7 @@ void Daidalus::setRecoveryHorizontalDirectionBands(bool flag) {
  */
 void Daidalus::setRecoveryHorizontalSpeedBands(bool flag) {
   core_.parameters.setRecoveryHorizontalSpeedBands(flag);
-  reset();
+  invalidate(HS_RES_DEP);
 }
 
 /**
@@ -2176,7 +2296,7 @@ void Daidalus::setRecoveryHorizontalSpeedBands(bool flag) {
  */
 void Daidalus::setRecoveryVerticalSpeedBands(bool flag) {
   core_.parameters.setRecoveryVerticalSpeedBands(flag);
-  reset();
+  invalidate(VS_RES_DEP);
 }
 
 /**
@@ -2184,7 +2304,7 @@ void Daidalus::setRecoveryVerticalSpeedBands(bool flag) {
  */
 void Daidalus::setRecoveryAltitudeBands(bool flag) {
   core_.parameters.setRecoveryAltitudeBands(flag);
-  reset();
+  invalidate(ALT_RES_DEP);
 }
 
 /**
@@ -2199,7 +2319,7 @@ bool Daidalus::isEnabledCollisionAvoidanceBands() {
  */
 void Daidalus::setCollisionAvoidanceBands(bool flag) {
   core_.parameters.setCollisionAvoidanceBands(flag);
-  reset();
+  invalidate(RES_DEP);
 }
 
 /**
@@ -2228,7 +2348,7 @@ double Daidalus::getCollisionAvoidanceBandsFactor() const {
  */
 void Daidalus::setCollisionAvoidanceBandsFactor(double val) {
   core_.parameters.setCollisionAvoidanceBandsFactor(val);
-  reset();
+  invalidate(RES_DEP);
 }
 
 /**
@@ -2641,7 +2761,7 @@ int Daidalus::maxAlertLevel() const {
  */
 void Daidalus::setInstantaneousBands() {
   core_.parameters.setInstantaneousBands();
-  reset();
+  invalidate(TRAJ_DEP);
 }
 
 /**
@@ -2651,7 +2771,7 @@ void Daidalus::setInstantaneousBands() {
  */
 void Daidalus::setKinematicBands(bool type) {
   core_.parameters.setKinematicBands(type);
-  reset();
+  invalidate(TRAJ_DEP);
 }
 
 /**
@@ -2686,9 +2806,15 @@ void Daidalus::setDaidalusParameters(const DaidalusParameters& parameters) {
   clearHysteresis();
 }
 
+/**
+ * Set parameters from ParameterData. Only cached values that depend on parameters whose
+ * values actually change are invalidated. Hysteresis data is cleared when hysteresis or
+ * persistence parameters change.
+ */
 void Daidalus::setParameterData(const ParameterData& p) {
+  DaidalusParameters parameters(core_.parameters);
   if (core_.parameters.setParameterData(p)) {
-    clearHysteresis();
+    invalidate(parameter_dependencies(parameters));
   }
 }
 
@@ -2748,7 +2874,186 @@ void Daidalus::stale_bands() {
  */
 void Daidalus::reset() {
   core_.stale();
-  stale_bands();
+  hdir_band_.reset();
+  hs_band_.reset();
+  vs_band_.reset();
+  alt_band_.reset();
+}
+
+/**
+ * Set to stale conditions only the cached values that depend on parameters in deps, which is a
+ * combination of ParameterDependency values. None sets of a bands object are only cleared when
+ * ownship trajectories of that dimension change.
+ */
+void Daidalus::invalidate(int deps) {
+  if (deps & HYSTERESIS_DEP) {
+    clearHysteresis();
+    return;
+  }
+  if (deps & ALERTING_DEP) {
+    reset();
+    return;
+  }
+  if (spread_alerting(deps)) {
+    // Alerting and peripheral aircraft depend on the trajectories of the spread bands
+    core_.stale();
+    stale_bands();
+  }
+  if (deps & HDIR_TRAJ_DEP) {
+    hdir_band_.reset();
+  } else if (deps & HDIR_RES_DEP) {
+    hdir_band_.stale();
+  }
+  if (deps & HS_TRAJ_DEP) {
+    hs_band_.reset();
+  } else if (deps & HS_RES_DEP) {
+    hs_band_.stale();
+  }
+  if (deps & VS_TRAJ_DEP) {
+    vs_band_.reset();
+  } else if (deps & VS_RES_DEP) {
+    vs_band_.stale();
+  }
+  if (deps & ALT_TRAJ_DEP) {
+    alt_band_.reset();
+  } else if (deps & ALT_RES_DEP) {
+    alt_band_.stale();
+  }
+}
+
+/**
+ * Returns true if some alert level uses a spread in a dimension whose ownship trajectories
+ * are in deps. In that case, alerting depends on these trajectories.
+ */
+bool Daidalus::spread_alerting(int deps) const {
+  if ((deps & TRAJ_DEP) == 0) {
+    return false;
+  }
+  for (int alerter_idx=1; alerter_idx <= core_.parameters.numberOfAlerters(); ++alerter_idx) {
+    const Alerter& alerter = core_.parameters.getAlerterAt(alerter_idx);
+    for (int level=1; level <= alerter.mostSevereAlertLevel(); ++level) {
+      const AlertThresholds& athr = alerter.getLevel(level);
+      if (((deps & HDIR_TRAJ_DEP) && athr.getHorizontalDirectionSpread() > 0) ||
+          ((deps & HS_TRAJ_DEP) && athr.getHorizontalSpeedSpread() > 0) ||
+          ((deps & VS_TRAJ_DEP) && athr.getVerticalSpeedSpread() > 0) ||
+          ((deps & ALT_TRAJ_DEP) && athr.getAltitudeSpread() > 0)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/**
+ * Dependencies of maximum horizontal speed. When the pre-filter of traffic aircraft is enabled,
+ * this parameter is also used by the core to discard aircraft.
+ */
+int Daidalus::max_hs_dependency() const {
+  return core_.traffic_prefilter() ? ALERTING_DEP : HS_TRAJ_DEP;
+}
+
+/**
+ * Returns the combination of ParameterDependency values of the parameters that are different in
+ * current parameters and the given ones.
+ */
+int Daidalus::parameter_dependencies(const DaidalusParameters& parameters) const {
+  const DaidalusParameters& p = core_.parameters;
+  int deps = 0;
+  if (p.getHysteresisTime() != parameters.getHysteresisTime() ||
+      p.getPersistenceTime() != parameters.getPersistenceTime() ||
+      p.getAlertingParameterM() != parameters.getAlertingParameterM() ||
+      p.getAlertingParameterN() != parameters.getAlertingParameterN()) {
+    deps |= HYSTERESIS_DEP;
+  }
+  if (p.getLookaheadTime() != parameters.getLookaheadTime() ||
+      p.isEnabledConflictCriteria() != parameters.isEnabledConflictCriteria() ||
+      p.isEnabledRecoveryCriteria() != parameters.isEnabledRecoveryCriteria() ||
+      p.getHorizontalPositionZScore() != parameters.getHorizontalPositionZScore() ||
+      p.getHorizontalVelocityZScoreMin() != parameters.getHorizontalVelocityZScoreMin() ||
+      p.getHorizontalVelocityZScoreMax() != parameters.getHorizontalVelocityZScoreMax() ||
+      p.getHorizontalVelocityZDistance() != parameters.getHorizontalVelocityZDistance() ||
+      p.getVerticalPositionZScore() != parameters.getVerticalPositionZScore() ||
+      p.getVerticalSpeedZScore() != parameters.getVerticalSpeedZScore() ||
+      p.getDTALogic() != parameters.getDTALogic() ||
+      p.getDTAPosition().lat() != parameters.getDTAPosition().lat() ||
+      p.getDTAPosition().lon() != parameters.getDTAPosition().lon() ||
+      p.getDTARadius() != parameters.getDTARadius() ||
+      p.getDTAHeight() != parameters.getDTAHeight() ||
+      p.getDTAAlerter() != parameters.getDTAAlerter() ||
+      p.isAlertingLogicOwnshipCentric() != parameters.isAlertingLogicOwnshipCentric() ||
+      p.getCorrectiveRegion() != parameters.getCorrectiveRegion() ||
+      p.numberOfAlerters() != parameters.numberOfAlerters()) {
+    deps |= ALERTING_DEP;
+  } else {
+    for (int alerter_idx=1; alerter_idx <= p.numberOfAlerters(); ++alerter_idx) {
+      if (p.getAlerterAt(alerter_idx).toString() != parameters.getAlerterAt(alerter_idx).toString()) {
+        deps |= ALERTING_DEP;
+        break;
+      }
+    }
+  }
+  if (p.getLeftHorizontalDirection() != parameters.getLeftHorizontalDirection() ||
+      p.getRightHorizontalDirection() != parameters.getRightHorizontalDirection() ||
+      p.getHorizontalDirectionStep() != parameters.getHorizontalDirectionStep() ||
+      p.getTurnRate() != parameters.getTurnRate() ||
+      p.getBankAngle() != parameters.getBankAngle()) {
+    deps |= HDIR_TRAJ_DEP;
+  }
+  if (p.getMaxHorizontalSpeed() != parameters.getMaxHorizontalSpeed()) {
+    deps |= max_hs_dependency();
+  }
+  if (p.getMinHorizontalSpeed() != parameters.getMinHorizontalSpeed() ||
+      p.getBelowRelativeHorizontalSpeed() != parameters.getBelowRelativeHorizontalSpeed() ||
+      p.getAboveRelativeHorizontalSpeed() != parameters.getAboveRelativeHorizontalSpeed() ||
+      p.getHorizontalSpeedStep() != parameters.getHorizontalSpeedStep() ||
+      p.getHorizontalAcceleration() != parameters.getHorizontalAcceleration()) {
+    deps |= HS_TRAJ_DEP;
+  }
+  if (p.getMinVerticalSpeed() != parameters.getMinVerticalSpeed() ||
+      p.getMaxVerticalSpeed() != parameters.getMaxVerticalSpeed() ||
+      p.getBelowRelativeVerticalSpeed() != parameters.getBelowRelativeVerticalSpeed() ||
+      p.getAboveRelativeVerticalSpeed() != parameters.getAboveRelativeVerticalSpeed() ||
+      p.getVerticalSpeedStep() != parameters.getVerticalSpeedStep()) {
+    deps |= VS_TRAJ_DEP;
+  }
+  if (p.getVerticalAcceleration() != parameters.getVerticalAcceleration()) {
+    deps |= VS_TRAJ_DEP | ALT_TRAJ_DEP;
+  }
+  if (p.getMinAltitude() != parameters.getMinAltitude() ||
+      p.getMaxAltitude() != parameters.getMaxAltitude() ||
+      p.getBelowRelativeAltitude() != parameters.getBelowRelativeAltitude() ||
+      p.getAboveRelativeAltitude() != parameters.getAboveRelativeAltitude() ||
+      p.getAltitudeStep() != parameters.getAltitudeStep() ||
+      p.getVerticalRate() != parameters.getVerticalRate()) {
+    deps |= ALT_TRAJ_DEP;
+  }
+  if (p.getHorizontalNMAC() != parameters.getHorizontalNMAC() ||
+      p.getVerticalNMAC() != parameters.getVerticalNMAC() ||
+      p.getMinHorizontalRecovery() != parameters.getMinHorizontalRecovery() ||
+      p.getMinVerticalRecovery() != parameters.getMinVerticalRecovery() ||
+      p.isEnabledCollisionAvoidanceBands() != parameters.isEnabledCollisionAvoidanceBands() ||
+      p.getCollisionAvoidanceBandsFactor() != parameters.getCollisionAvoidanceBandsFactor() ||
+      p.getRecoveryStabilityTime() != parameters.getRecoveryStabilityTime() ||
+      p.isEnabledBandsPersistence() != parameters.isEnabledBandsPersistence()) {
+    deps |= RES_DEP;
+  }
+  if (p.isEnabledRecoveryHorizontalDirectionBands() != parameters.isEnabledRecoveryHorizontalDirectionBands() ||
+      p.getPersistencePreferredHorizontalDirectionResolution() != parameters.getPersistencePreferredHorizontalDirectionResolution()) {
+    deps |= HDIR_RES_DEP;
+  }
+  if (p.isEnabledRecoveryHorizontalSpeedBands() != parameters.isEnabledRecoveryHorizontalSpeedBands() ||
+      p.getPersistencePreferredHorizontalSpeedResolution() != parameters.getPersistencePreferredHorizontalSpeedResolution()) {
+    deps |= HS_RES_DEP;
+  }
+  if (p.isEnabledRecoveryVerticalSpeedBands() != parameters.isEnabledRecoveryVerticalSpeedBands() ||
+      p.getPersistencePreferredVerticalSpeedResolution() != parameters.getPersistencePreferredVerticalSpeedResolution()) {
+    deps |= VS_RES_DEP;
+  }
+  if (p.isEnabledRecoveryAltitudeBands() != parameters.isEnabledRecoveryAltitudeBands() ||
+      p.getPersistencePreferredAltitudeResolution() != parameters.getPersistencePreferredAltitudeResolution()) {
+    deps |= ALT_RES_DEP;
+  }
+  return deps;
 }
 
 /* Main interface methods */
@@ -2793,6 +3098,48 @@ Interval Daidalus::timeIntervalOfConflict(BandsRegion::Region region) {
   return timeIntervalOfConflict(BandsRegion::orderOfRegion(region));
 }
 
+/**
+ * Task that refreshes a list of bands objects sharing a fresh core.
+ */
+class RefreshBandsTask : public WorkerTask {
+public:
+  DaidalusRealBands** bands;
+  const DaidalusCore& core;
+
+  RefreshBandsTask(DaidalusRealBands** b, const DaidalusCore& c) : bands(b), core(c) {}
+
+  void execute(int i) {
+    bands[i]->refresh_with(core);
+  }
+};
+
+/**
+ * Compute horizontal direction, horizontal speed, vertical speed, and altitude bands.
+ * Usually, bands are only computed when needed. This method computes all bands that are
+ * not up to date. When the number of threads is greater than 1, the four kinds of bands
+ * are computed concurrently.
+ */
+void Daidalus::computeAllBands() {
+  // Once the core is fresh, bands computations only read it through a const reference
+  core_.refresh();
+  DaidalusRealBands* bands[4];
+  int n = 0;
+  if (!hdir_band_.isFresh()) {
+    bands[n++] = &hdir_band_;
+  }
+  if (!hs_band_.isFresh()) {
+    bands[n++] = &hs_band_;
+  }
+  if (!vs_band_.isFresh()) {
+    bands[n++] = &vs_band_;
+  }
+  if (!alt_band_.isFresh()) {
+    bands[n++] = &alt_band_;
+  }
+  RefreshBandsTask task(bands,core_);
+  core_.worker_pool().run(task,n);
+}
+
 /**
  * @return the number of horizontal direction bands negative if the ownship has not been set
  */
@@ -3687,7 +4034,7 @@ ConflictData Daidalus::violationOfAlertThresholds(int ac_idx, int alert_level) {
       if (alert_level > 0) {
         Detection3D* detector = alerter.getDetectorPtr(alert_level);
         if (detector != NULL) {
-          return detector->conflictDetectionWithTrafficState(core_.ownship,intruder,0.0,core_.parameters.getLookaheadTime());
+          return core_.conflict_detection(intruder,detector,0.0,core_.parameters.getLookaheadTime());
         } else {
           error.addError("violationOfAlertThresholds: detector of traffic aircraft "+Fmi(ac_idx)+" is not set");
         }
@@ -4361,6 +4708,7 @@ std::string Daidalus::outputString() {
   std::string s="";
   s+=outputStringInfo();
   s+=outputStringAlerting();
+  computeAllBands();
   s+=outputStringDirectionBands();
   s+=outputStringHorizontalSpeedBands();
   s+=outputStringVerticalSpeedBands();
@@ -83,9 +83,25 @@ std::pair<Vect3, Velocity> DaidalusAltBands::trajectory(const DaidalusParameters
   return std::pair<Vect3, Velocity>(ownship.pos_to_s(posvel.first),ownship.vel_to_v(posvel.first,posvel.second));
 }
 
+// True if there is a loss of separation at time i*tstep, for some from <= i <= to
+bool DaidalusAltBands::LOS_at_steps(const Detection3D* conflict_det, const Detection3D* recovery_det, double B, double tstep, int from, double to,
+    const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic, int target_step, bool instantaneous) const {
+  bool trajdir = true;
+  for (int i=from; i<=to;++i) {
+    double tsi = i*tstep;
+    if ((B <= tsi && LOS_at(conflict_det,trajdir,tsi,parameters,ownship,traffic,target_step,instantaneous)) ||
+        (recovery_det != NULL && 0 <= tsi && tsi <= B &&
+            LOS_at(recovery_det,trajdir,tsi,parameters,ownship,traffic,target_step,instantaneous))) {
+      return true;
+    }
+  }
+  return false;
+}
+
 // In PVS: alt_bands@conflict_free_traj_step
 bool DaidalusAltBands::conflict_free_traj_step(const Detection3D* conflict_det, const Detection3D* recovery_det, double B, double T,
-    const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic, int target_step, bool instantaneous) const {
+    const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic, int target_step, bool instantaneous,
+    ClimbProfile* profiles) const {
   bool trajdir = true;
   if (instantaneous) {
     return no_CD_future_traj(conflict_det,recovery_det,B,T,trajdir,0.0,parameters,ownship,traffic,target_step,instantaneous);
@@ -97,31 +113,46 @@ bool DaidalusAltBands::conflict_free_traj_step(const Detection3D* conflict_det,
     double tsqj1 = tsqj.first;
     double tsqj2 = tsqj.second;
     double tsqj3 = tsqj.third+tstep;
-    for (int i=0; i<=std::floor(tsqj1/tstep);++i) {
-      double tsi = i*tstep;
-      if ((B <= tsi && LOS_at(conflict_det,trajdir,tsi,parameters,ownship,traffic,target_step,instantaneous)) ||
-          (recovery_det != NULL && 0 <= tsi && tsi <= B &&
-              LOS_at(recovery_det,trajdir,tsi,parameters,ownship,traffic,target_step,instantaneous))) {
-        return false;
+    ClimbProfile* profile = NULL;
+    if (profiles != NULL && tsqj1 >= 0) {
+      profile = &profiles[target_alt >= ownship.positionXYZ().alt() ? 1 : 0];
+      if (!profile->valid) {
+        profile->valid = true;
+        profile->t1 = tsqj1;
+        profile->a1 = tsqj.fourth;
+        profile->los = LOS_at_steps(conflict_det,recovery_det,B,tstep,0,std::floor(tsqj1/tstep),
+            parameters,ownship,traffic,target_step,instantaneous);
+      } else if (profile->t1 != tsqj1 || profile->a1 != tsqj.fourth) {
+        profile = NULL;
       }
     }
-    double tsk1 = Util::max(tsqj1,0.0);
-    if ((tsqj2 >= B &&
-        CD_future_traj(conflict_det,B,std::min(T+tsk1,tsqj2),trajdir,tsk1,parameters,ownship,traffic,target_step,instantaneous)) ||
-        (recovery_det != NULL && tsqj2 >= 0 &&
-            CD_future_traj(recovery_det,0,Util::min(B,tsqj2),trajdir,tsk1,parameters,ownship,traffic,target_step,instantaneous))) {
-      return false;
+    // Level-off segments of targets that are not reached within the lookahead time are never checked
+    bool unreachable = profile != NULL && tsqj2 >= parameters.getLookaheadTime() && tsqj2 >= B;
+    if (unreachable && profile->unreachable_valid) {
+      return profile->unreachable_free;
     }
-    for (int i=(int)std::ceil(tsqj2/tstep); i<=std::floor(tsqj3/tstep);++i) {
-      double tsi = i*tstep;
-      if ((B <= tsi && LOS_at(conflict_det,trajdir,tsi,parameters,ownship,traffic,target_step,instantaneous)) ||
-          (recovery_det != NULL && 0 <= tsi && tsi <= B &&
-              LOS_at(recovery_det,trajdir,tsi,parameters,ownship,traffic,target_step,instantaneous))) {
-        return false;
+    bool free = !(profile != NULL ? profile->los :
+        LOS_at_steps(conflict_det,recovery_det,B,tstep,0,std::floor(tsqj1/tstep),parameters,ownship,traffic,target_step,instantaneous));
+    if (free) {
+      double tsk1 = Util::max(tsqj1,0.0);
+      if ((tsqj2 >= B &&
+          CD_future_traj(conflict_det,B,std::min(T+tsk1,tsqj2),trajdir,tsk1,parameters,ownship,traffic,target_step,instantaneous)) ||
+          (recovery_det != NULL && tsqj2 >= 0 &&
+              CD_future_traj(recovery_det,0,Util::min(B,tsqj2),trajdir,tsk1,parameters,ownship,traffic,target_step,instantaneous))) {
+        free = false;
+      } else if (LOS_at_steps(conflict_det,recovery_det,B,tstep,(int)std::ceil(tsqj2/tstep),std::floor(tsqj3/tstep),
+          parameters,ownship,traffic,target_step,instantaneous)) {
+        free = false;
+      } else {
+        double tsk3 = Util::max(tsqj3,0.0);
+        free = no_CD_future_traj(conflict_det,recovery_det,B,T+tsk3,trajdir,tsk3,parameters,ownship,traffic,target_step,instantaneous);
       }
     }
-    double tsk3 = Util::max(tsqj3,0.0);
-    return no_CD_future_traj(conflict_det,recovery_det,B,T+tsk3,trajdir,tsk3,parameters,ownship,traffic,target_step,instantaneous);
+    if (unreachable) {
+      profile->unreachable_valid = true;
+      profile->unreachable_free = free;
+    }
+    return free;
   }
 }
 
@@ -129,14 +160,15 @@ bool DaidalusAltBands::conflict_free_traj_step(const Detection3D* conflict_det,
 void DaidalusAltBands::alt_bands_generic(std::vector<Integerval>& l,
     const Detection3D* conflict_det, const Detection3D* recovery_det, double B, double T,
     int maxup, const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic, bool instantaneous) const {
+  ClimbProfile profiles[2];
   int d = -1; // Set to the first index with no conflict
   for (int k = 0; k <= maxup; ++k) {
-    if (d >=0 && conflict_free_traj_step(conflict_det,recovery_det,B,T,parameters,ownship,traffic,k,instantaneous)) {
+    if (d >=0 && conflict_free_traj_step(conflict_det,recovery_det,B,T,parameters,ownship,traffic,k,instantaneous,profiles)) {
       continue;
     } else if (d >=0) {
       l.push_back(Integerval(d,k-1));
       d = -1;
-    } else if (conflict_free_traj_step(conflict_det,recovery_det,B,T,parameters,ownship,traffic,k,instantaneous)) {
+    } else if (conflict_free_traj_step(conflict_det,recovery_det,B,T,parameters,ownship,traffic,k,instantaneous,profiles)) {
       d = k;
     }
   }
@@ -166,14 +198,15 @@ bool DaidalusAltBands::all_red(const Detection3D* conflict_det, const Detection3
 }
 
 int DaidalusAltBands::first_nat(int mini, int maxi, bool dir, const Detection3D* conflict_det, const Detection3D* recovery_det,
-    double B, double T,  const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic, bool green, bool instantaneous) const {
+    double B, double T,  const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic, bool green, bool instantaneous,
+    ClimbProfile* profiles) const {
   while (mini <= maxi) {
-    if (dir && green == conflict_free_traj_step(conflict_det,recovery_det,B,T,parameters,ownship,traffic,mini,instantaneous)) {
+    if (dir && green == conflict_free_traj_step(conflict_det,recovery_det,B,T,parameters,ownship,traffic,mini,instantaneous,profiles)) {
       return mini;
     } else if (dir) {
       ++mini;
     } else {
-      if (green == conflict_free_traj_step(conflict_det,recovery_det,B,T,parameters,ownship,traffic,maxi,instantaneous)) {
+      if (green == conflict_free_traj_step(conflict_det,recovery_det,B,T,parameters,ownship,traffic,maxi,instantaneous,profiles)) {
         return maxi;
       } else if (maxi == 0) {
         return -1;
@@ -194,7 +227,8 @@ int DaidalusAltBands::first_band_alt_generic(const Detection3D* conflict_det, co
   if (ownship.positionXYZ().alt() < get_min_val_() || ownship.positionXYZ().alt() > get_max_val_()) {
     return -1;
   } else {
-    return first_nat(lower,upper,dir,conflict_det,recovery_det,B,T,parameters,ownship,traffic,green,instantaneous);
+    ClimbProfile profiles[2];
+    return first_nat(lower,upper,dir,conflict_det,recovery_det,B,T,parameters,ownship,traffic,green,instantaneous,profiles);
   }
 }
 
@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2015-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+/*
+ * DaidalusBinaryReader.cpp
+ *
+ * Layout of DAIDALUS binary files. Offsets are from the beginning of the file and
+ * sections are aligned to 8 bytes.
+ *
+ * Header (88 bytes)
+ *   char     magic[8]
+ *   uint32   byte order mark, version, flags, number of time steps, number of ids,
+ *            number of extra columns, number of strings, unused
+ *   uint64   offsets of times, block index, ids, columns, string index, and characters
+ * Time steps
+ *   double   times[steps]
+ *   uint64   blocks[steps+1], offsets of blocks. The last one is the end of the blocks.
+ * Block of a time step with n aircraft
+ *   uint32   n, unused
+ *   uint32   ids[n], indices in the table of ids
+ *   double   sx[n], sy[n], sz[n], vx[n], vy[n], vz[n], where (sx,sy,sz) is (lat,lon,alt) in
+ *            geodesic files
+ *   per extra column:
+ *     uint8  present[n]
+ *     double values[n] (real columns) or uint32 values[n], indices in the table of strings
+ *            (string columns)
+ * Tables
+ *   uint32   ids[ids], indices in the table of strings
+ *   uint32   columns[3*columns], index of name, index of units, and type of each column
+ *   uint64   strings[strings+1], offsets of strings from the characters section
+ *   char     characters of all strings
+ */
+
+#include "DaidalusBinaryReader.h"
+#include "format.h"
+#include <cstring>
+#include <fstream>
+
+namespace larcfm {
+
+const char DaidalusBinaryReader::MAGIC[8] = { 'D','A','A','B','I','N','\r','\n' };
+const uint32_t DaidalusBinaryReader::VERSION = 1;
+const uint32_t DaidalusBinaryReader::BYTE_ORDER_MARK = 0x01020304;
+
+static const uint64_t HEADER_SIZE = 88;
+
+// Size of n items of the given size, aligned to 8 bytes
+static uint64_t aligned(uint64_t n, uint64_t size) {
+  return (n*size+7)/8*8;
+}
+
+DaidalusBinaryReader::DaidalusBinaryReader() : error("DaidalusBinaryReader") {
+  close();
+}
+
+DaidalusBinaryReader::DaidalusBinaryReader(const std::string& filename) : error("DaidalusBinaryReader") {
+  open(filename);
+}
+
+DaidalusBinaryReader::DaidalusBinaryReader(const DaidalusBinaryReader& reader) : error("DaidalusBinaryReader") {
+  if (reader.file_.isOpen()) {
+    open(reader.filename_);
+  } else {
+    close();
+  }
+}
+
+DaidalusBinaryReader& DaidalusBinaryReader::operator=(const DaidalusBinaryReader& reader) {
+  if (this != &reader) {
+    if (reader.file_.isOpen()) {
+      open(reader.filename_);
+    } else {
+      close();
+    }
+  }
+  return *this;
+}
+
+bool DaidalusBinaryReader::isBinaryFile(const std::string& filename) {
+  std::ifstream in(filename.c_str(),std::ios::in | std::ios::binary);
+  char magic[sizeof(MAGIC)];
+  return in.read(magic,sizeof(MAGIC)) && std::memcmp(magic,MAGIC,sizeof(MAGIC)) == 0;
+}
+
+bool DaidalusBinaryReader::open(const std::string& filename) {
+  close();
+  error = ErrorLog("DaidalusBinaryReader("+filename+")");
+  if (!file_.open(filename)) {
+    error.addError("File "+filename+" read protected or not found");
+    return false;
+  }
+  filename_ = filename;
+  if (!validate()) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+void DaidalusBinaryReader::close() {
+  file_.close();
+  filename_ = "";
+  latlon_ = false;
+  num_steps_ = 0;
+  num_ids_ = 0;
+  num_columns_ = 0;
+  num_strings_ = 0;
+  times_offset_ = 0;
+  blocks_offset_ = 0;
+  ids_offset_ = 0;
+  columns_offset_ = 0;
+  strings_offset_ = 0;
+  chars_offset_ = 0;
+  column_names_.clear();
+  column_units_.clear();
+  column_types_.clear();
+}
+
+/**
+ * Value of type T at offset. Values are copied, since the file doesn't guarantee their alignment.
+ */
+template<typename T> T DaidalusBinaryReader::at(uint64_t offset) const {
+  T value;
+  std::memcpy(&value,file_.begin()+offset,sizeof(T));
+  return value;
+}
+
+/**
+ * Read header and tables, and check that all sections and blocks are within the file, so that
+ * time steps can be accessed without further checks.
+ */
+bool DaidalusBinaryReader::validate() {
+  uint64_t size = file_.size();
+  if (size < HEADER_SIZE || std::memcmp(file_.begin(),MAGIC,sizeof(MAGIC)) != 0) {
+    error.addError("Not a DAIDALUS binary file");
+    return false;
+  }
+  if (at<uint32_t>(8) != BYTE_ORDER_MARK) {
+    error.addError("Binary file was written with a different byte order");
+    return false;
+  }
+  if (at<uint32_t>(12) != VERSION) {
+    error.addError("Unsupported version "+Fmi(at<uint32_t>(12))+" of binary file");
+    return false;
+  }
+  latlon_ = (at<uint32_t>(16) & LATLON_FLAG) != 0;
+  num_steps_ = at<uint32_t>(20);
+  num_ids_ = at<uint32_t>(24);
+  num_columns_ = at<uint32_t>(28);
+  num_strings_ = at<uint32_t>(32);
+  times_offset_ = at<uint64_t>(40);
+  blocks_offset_ = at<uint64_t>(48);
+  ids_offset_ = at<uint64_t>(56);
+  columns_offset_ = at<uint64_t>(64);
+  strings_offset_ = at<uint64_t>(72);
+  chars_offset_ = at<uint64_t>(80);
+  // Offsets and counts are checked separately, so that their sums can't overflow
+  if (times_offset_ > size || num_steps_ > size || times_offset_+8*uint64_t(num_steps_) > size ||
+      blocks_offset_ > size || blocks_offset_+8*(uint64_t(num_steps_)+1) > size ||
+      ids_offset_ > size || num_ids_ > size || ids_offset_+4*uint64_t(num_ids_) > size ||
+      columns_offset_ > size || num_columns_ > size || columns_offset_+12*uint64_t(num_columns_) > size ||
+      strings_offset_ > size || num_strings_ > size || strings_offset_+8*(uint64_t(num_strings_)+1) > size ||
+      chars_offset_ > size) {
+    error.addError("Truncated binary file");
+    return false;
+  }
+  uint64_t chars_size = size-chars_offset_;
+  uint64_t last = 0;
+  for (uint32_t i = 0; i <= num_strings_; ++i) {
+    uint64_t offset = at<uint64_t>(strings_offset_+8*uint64_t(i));
+    if (offset < last || offset > chars_size) {
+      error.addError("Invalid string table in binary file");
+      return false;
+    }
+    last = offset;
+  }
+  for (uint32_t i = 0; i < num_ids_; ++i) {
+    if (at<uint32_t>(ids_offset_+4*uint64_t(i)) >= num_strings_) {
+      error.addError("Invalid id table in binary file");
+      return false;
+    }
+  }
+  for (uint32_t i = 0; i < num_columns_; ++i) {
+    uint32_t name = at<uint32_t>(columns_offset_+12*uint64_t(i));
+    uint32_t units = at<uint32_t>(columns_offset_+12*uint64_t(i)+4);
+    uint32_t type = at<uint32_t>(columns_offset_+12*uint64_t(i)+8);
+    if (name >= num_strings_ || units >= num_strings_ || (type != REAL_COLUMN && type != STRING_COLUMN)) {
+      error.addError("Invalid column table in binary file");
+      return false;
+    }
+    column_names_.push_back(stringAt(name));
+    column_units_.push_back(stringAt(units));
+    column_types_.push_back(static_cast<int>(type));
+  }
+  for (uint32_t step = 0; step < num_steps_; ++step) {
+    uint64_t begin = block(step);
+    uint64_t end = block(step+1);
+    if (begin < HEADER_SIZE || begin > end || end > size || end-begin < 8 ||
+        at<uint32_t>(begin) > size || blockSize(at<uint32_t>(begin)) != end-begin) {
+      error.addError("Invalid block of time step "+Fmi(step)+" in binary file");
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Offset of the block of a time step
+ */
+uint64_t DaidalusBinaryReader::block(int step) const {
+  return at<uint64_t>(blocks_offset_+8*uint64_t(step));
+}
+
+/**
+ * Size of a block with n aircraft
+ */
+uint64_t DaidalusBinaryReader::blockSize(uint32_t n) const {
+  uint64_t size = 8+aligned(n,4)+6*aligned(n,8);
+  for (uint32_t col = 0; col < num_columns_; ++col) {
+    size += aligned(n,1)+(column_types_[col] == REAL_COLUMN ? aligned(n,8) : aligned(n,4));
+  }
+  return size;
+}
+
+std::string DaidalusBinaryReader::stringAt(uint32_t idx) const {
+  if (idx >= num_strings_) {
+    return "";
+  }
+  uint64_t begin = at<uint64_t>(strings_offset_+8*uint64_t(idx));
+  uint64_t end = at<uint64_t>(strings_offset_+8*uint64_t(idx)+8);
+  return std::string(file_.begin()+chars_offset_+begin,file_.begin()+chars_offset_+end);
+}
+
+bool DaidalusBinaryReader::isLatLon() const {
+  return latlon_;
+}
+
+int DaidalusBinaryReader::numberOfSteps() const {
+  return static_cast<int>(num_steps_);
+}
+
+double DaidalusBinaryReader::getTime(int step) const {
+  return at<double>(times_offset_+8*uint64_t(step));
+}
+
+std::vector<double> DaidalusBinaryReader::getTimes() const {
+  std::vector<double> times(num_steps_);
+  for (uint32_t step = 0; step < num_steps_; ++step) {
+    times[step] = getTime(step);
+  }
+  return times;
+}
+
+int DaidalusBinaryReader::size(int step) const {
+  return static_cast<int>(at<uint32_t>(block(step)));
+}
+
+std::string DaidalusBinaryReader::getName(int step, int ac) const {
+  uint32_t id = at<uint32_t>(block(step)+8+4*uint64_t(ac));
+  if (id >= num_ids_) {
+    error.addError("Invalid id of aircraft "+Fmi(ac)+" in time step "+Fmi(step));
+    return "";
+  }
+  return stringAt(at<uint32_t>(ids_offset_+4*uint64_t(id)));
+}
+
+Position DaidalusBinaryReader::getPosition(int step, int ac) const {
+  uint64_t b = block(step);
+  uint64_t n = at<uint32_t>(b);
+  uint64_t s = b+8+aligned(n,4)+8*uint64_t(ac);
+  double sx = at<double>(s);
+  double sy = at<double>(s+aligned(n,8));
+  double sz = at<double>(s+2*aligned(n,8));
+  if (latlon_) {
+    return Position::mkLatLonAlt(sx,sy,sz);
+  }
+  return Position::mkXYZ(sx,sy,sz);
+}
+
+Velocity DaidalusBinaryReader::getVelocity(int step, int ac) const {
+  uint64_t b = block(step);
+  uint64_t n = at<uint32_t>(b);
+  uint64_t v = b+8+aligned(n,4)+3*aligned(n,8)+8*uint64_t(ac);
+  return Velocity::mkVxyz(at<double>(v),at<double>(v+aligned(n,8)),at<double>(v+2*aligned(n,8)));
+}
+
+std::vector<std::string> DaidalusBinaryReader::getExtraColumnList() const {
+  return column_names_;
+}
+
+ParameterData DaidalusBinaryReader::getExtraColumns(int step, int ac) const {
+  ParameterData pd;
+  uint64_t b = block(step);
+  uint64_t n = at<uint32_t>(b);
+  uint64_t col_offset = b+8+aligned(n,4)+6*aligned(n,8);
+  for (uint32_t col = 0; col < num_columns_; ++col) {
+    uint64_t values = col_offset+aligned(n,1);
+    if (at<uint8_t>(col_offset+ac) != 0) {
+      if (column_types_[col] == REAL_COLUMN) {
+        pd.setInternal(column_names_[col],at<double>(values+8*uint64_t(ac)),column_units_[col]);
+      } else {
+        pd.set(column_names_[col],stringAt(at<uint32_t>(values+4*uint64_t(ac))));
+      }
+    }
+    col_offset = values+(column_types_[col] == REAL_COLUMN ? aligned(n,8) : aligned(n,4));
+  }
+  return pd;
+}
+
+// ErrorReporter Interface Methods
+
+bool DaidalusBinaryReader::hasError() const {
+  return error.hasError();
+}
+
+bool DaidalusBinaryReader::hasMessage() const {
+  return error.hasMessage();
+}
+
+std::string DaidalusBinaryReader::getMessage() {
+  return error.getMessage();
+}
+
+std::string DaidalusBinaryReader::getMessageNoClear() const {
+  return error.getMessageNoClear();
+}
+
+}
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2015-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+/*
+ * DaidalusBinaryWriter.cpp
+ *
+ * The layout of binary files is described in DaidalusBinaryReader.cpp
+ */
+
+#include "DaidalusBinaryWriter.h"
+#include "DaidalusBinaryReader.h"
+
+namespace larcfm {
+
+DaidalusBinaryWriter::DaidalusBinaryWriter() : error("DaidalusBinaryWriter"), offset_(0) {}
+
+/**
+ * Index of str in the table of strings
+ */
+uint32_t DaidalusBinaryWriter::intern(const std::string& str) {
+  std::map<std::string,uint32_t>::const_iterator idx_ptr = string_idx_.find(str);
+  if (idx_ptr != string_idx_.end()) {
+    return idx_ptr->second;
+  }
+  uint32_t idx = static_cast<uint32_t>(strings_.size());
+  strings_.push_back(str);
+  string_idx_[str] = idx;
+  return idx;
+}
+
+/**
+ * Index of aircraft name in the table of ids
+ */
+uint32_t DaidalusBinaryWriter::internId(const std::string& name) {
+  std::map<std::string,uint32_t>::const_iterator idx_ptr = id_idx_.find(name);
+  if (idx_ptr != id_idx_.end()) {
+    return idx_ptr->second;
+  }
+  uint32_t idx = static_cast<uint32_t>(ids_.size());
+  ids_.push_back(intern(name));
+  id_idx_[name] = idx;
+  return idx;
+}
+
+void DaidalusBinaryWriter::write(const void* data, uint64_t size) {
+  if (size > 0) {
+    out_.write(static_cast<const char*>(data),static_cast<std::streamsize>(size));
+    offset_ += size;
+  }
+}
+
+/**
+ * Align next section to 8 bytes
+ */
+void DaidalusBinaryWriter::pad() {
+  static const char zeros[8] = { 0,0,0,0,0,0,0,0 };
+  write(zeros,(8-offset_%8)%8);
+}
+
+template<typename T> void DaidalusBinaryWriter::write(const std::vector<T>& values) {
+  if (!values.empty()) {
+    write(&values[0],values.size()*sizeof(T));
+  }
+  pad();
+}
+
+bool DaidalusBinaryWriter::write(SequenceReader& sr, const std::string& filename) {
+  error = ErrorLog("DaidalusBinaryWriter("+filename+")");
+  strings_.clear();
+  string_idx_.clear();
+  ids_.clear();
+  id_idx_.clear();
+  out_.close();
+  out_.clear();
+  out_.open(filename.c_str(),std::ios::out | std::ios::binary | std::ios::trunc);
+  if (out_.fail()) {
+    error.addError("File "+filename+" can't be written");
+    return false;
+  }
+  sr.setWindowSize(1);
+  std::vector<double> times = sr.sequenceKeys();
+  bool latlon = sr.isLatLon();
+  std::vector<std::string> columns = sr.getExtraColumnList();
+  std::vector<uint32_t> column_table;
+  std::vector<bool> real_column;
+  std::vector<std::string>::const_iterator col_ptr;
+  for (col_ptr = columns.begin(); col_ptr != columns.end(); ++col_ptr) {
+    std::string units = sr.getExtraColumnUnits(*col_ptr);
+    // As in DaidalusFileWalker, columns without units are handed to Daidalus as strings
+    bool real = !(units == "unitless" || units == "unspecified");
+    column_table.push_back(intern(*col_ptr));
+    column_table.push_back(intern(units));
+    column_table.push_back(real ? DaidalusBinaryReader::REAL_COLUMN : DaidalusBinaryReader::STRING_COLUMN);
+    real_column.push_back(real);
+  }
+  // The header is written last, when offsets are known
+  offset_ = 0;
+  write(std::vector<char>(88,0));
+  std::vector<uint64_t> blocks;
+  std::vector<double>::const_iterator time_ptr;
+  for (time_ptr = times.begin(); time_ptr != times.end(); ++time_ptr) {
+    double time = *time_ptr;
+    sr.setActive(time);
+    uint32_t n = static_cast<uint32_t>(sr.size());
+    blocks.push_back(offset_);
+    std::vector<uint32_t> count(2,0);
+    count[0] = n;
+    write(count);
+    std::vector<std::string> names(n);
+    std::vector<uint32_t> ids(n);
+    std::vector<std::vector<double> > components(6,std::vector<double>(n));
+    for (uint32_t ac = 0; ac < n; ++ac) {
+      names[ac] = sr.getName(ac);
+      ids[ac] = internId(names[ac]);
+      Position s = sr.getPosition(ac);
+      Velocity v = sr.getVelocity(ac);
+      components[0][ac] = latlon ? s.lat() : s.x();
+      components[1][ac] = latlon ? s.lon() : s.y();
+      components[2][ac] = latlon ? s.alt() : s.z();
+      components[3][ac] = v.x;
+      components[4][ac] = v.y;
+      components[5][ac] = v.z;
+    }
+    write(ids);
+    for (int k = 0; k < 6; ++k) {
+      write(components[k]);
+    }
+    for (unsigned int col = 0; col < columns.size(); ++col) {
+      std::vector<uint8_t> present(n,0);
+      std::vector<double> reals;
+      std::vector<uint32_t> strings;
+      for (uint32_t ac = 0; ac < n; ++ac) {
+        present[ac] = sr.hasExtraColumnData(time,names[ac],columns[col]) ? 1 : 0;
+        if (real_column[col]) {
+          reals.push_back(present[ac] ? sr.getExtraColumnValue(time,names[ac],columns[col]) : 0.0);
+        } else {
+          strings.push_back(present[ac] ? intern(sr.getExtraColumnString(time,names[ac],columns[col])) : 0);
+        }
+      }
+      write(present);
+      if (real_column[col]) {
+        write(reals);
+      } else {
+        write(strings);
+      }
+    }
+  }
+  blocks.push_back(offset_);
+  uint64_t times_offset = offset_;
+  write(times);
+  uint64_t blocks_offset = offset_;
+  write(blocks);
+  uint64_t ids_offset = offset_;
+  write(ids_);
+  uint64_t columns_offset = offset_;
+  write(column_table);
+  std::vector<uint64_t> string_offsets(1,0);
+  std::string chars;
+  std::vector<std::string>::const_iterator str_ptr;
+  for (str_ptr = strings_.begin(); str_ptr != strings_.end(); ++str_ptr) {
+    chars += *str_ptr;
+    string_offsets.push_back(chars.size());
+  }
+  uint64_t strings_offset = offset_;
+  write(string_offsets);
+  uint64_t chars_offset = offset_;
+  write(chars.data(),chars.size());
+
+  std::vector<uint32_t> counts;
+  counts.push_back(DaidalusBinaryReader::BYTE_ORDER_MARK);
+  counts.push_back(DaidalusBinaryReader::VERSION);
+  counts.push_back(latlon ? DaidalusBinaryReader::LATLON_FLAG : 0);
+  counts.push_back(static_cast<uint32_t>(times.size()));
+  counts.push_back(static_cast<uint32_t>(ids_.size()));
+  counts.push_back(static_cast<uint32_t>(columns.size()));
+  counts.push_back(static_cast<uint32_t>(strings_.size()));
+  counts.push_back(0);
+  std::vector<uint64_t> offsets;
+  offsets.push_back(times_offset);
+  offsets.push_back(blocks_offset);
+  offsets.push_back(ids_offset);
+  offsets.push_back(columns_offset);
+  offsets.push_back(strings_offset);
+  offsets.push_back(chars_offset);
+  out_.seekp(0);
+  offset_ = 0;
+  write(DaidalusBinaryReader::MAGIC,sizeof(DaidalusBinaryReader::MAGIC));
+  write(counts);
+  write(offsets);
+  out_.close();
+  if (out_.fail()) {
+    error.addError("Error writing file "+filename);
+    return false;
+  }
+  return true;
+}
+
+bool DaidalusBinaryWriter::convert(const std::string& daa_file, const std::string& filename) {
+  SequenceReader sr(daa_file);
+  if (sr.hasError()) {
+    error = ErrorLog("DaidalusBinaryWriter("+filename+")");
+    error.addError(sr.getMessageNoClear());
+    return false;
+  }
+  return write(sr,filename);
+}
+
+// ErrorReporter Interface Methods
+
+bool DaidalusBinaryWriter::hasError() const {
+  return error.hasError();
+}
+
+bool DaidalusBinaryWriter::hasMessage() const {
+  return error.hasMessage();
+}
+
+std::string DaidalusBinaryWriter::getMessage() {
+  return error.getMessage();
+}
+
+std::string DaidalusBinaryWriter::getMessageNoClear() const {
+  return error.getMessageNoClear();
+}
+
+}
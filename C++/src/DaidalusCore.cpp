@@ -10,6 +10,7 @@
 #include "DaidalusHsBands.h"
 #include "DaidalusVsBands.h"
 #include "DaidalusAltBands.h"
+#include "DaidalusSpreadAlerting.h"
 #include "CriteriaCore.h"
 #include "UrgencyStrategy.h"
 #include "IndexLevelT.h"
@@ -31,8 +32,12 @@ DaidalusCore::DaidalusCore()
 , wind_vector()
 , parameters()
 , urgency_strategy_(new NoneUrgencyStrategy())
+, search_stride_(1)
+, trajectory_anchor_period_(1)
+, traffic_prefilter_(false)
 , cache_(0) // Cached_ variables are cleared
-, acs_conflict_bands_(std::vector<std::vector<IndexLevelT> >(BandsRegion::NUMBER_OF_CONFLICT_BANDS)) {
+, acs_conflict_bands_(std::vector<std::vector<IndexLevelT> >(BandsRegion::NUMBER_OF_CONFLICT_BANDS))
+, conflict_generation_(0) {
   stale();
 }
 
@@ -43,8 +48,12 @@ DaidalusCore::DaidalusCore(const Alerter& alerter)
 , wind_vector()
 , parameters()
 , urgency_strategy_(new NoneUrgencyStrategy())
+, search_stride_(1)
+, trajectory_anchor_period_(1)
+, traffic_prefilter_(false)
 , cache_(0) // Cached_ variables are cleared
-, acs_conflict_bands_(std::vector<std::vector<IndexLevelT> >(BandsRegion::NUMBER_OF_CONFLICT_BANDS)) {
+, acs_conflict_bands_(std::vector<std::vector<IndexLevelT> >(BandsRegion::NUMBER_OF_CONFLICT_BANDS))
+, conflict_generation_(0) {
   parameters.addAlerter(alerter);
   stale();
 }
@@ -56,8 +65,12 @@ DaidalusCore::DaidalusCore(const Detection3D* det, double T)
 , wind_vector()
 , parameters()
 , urgency_strategy_(new NoneUrgencyStrategy())
+, search_stride_(1)
+, trajectory_anchor_period_(1)
+, traffic_prefilter_(false)
 , cache_(0) // Cached_ variables are cleared
-, acs_conflict_bands_(std::vector<std::vector<IndexLevelT> >(BandsRegion::NUMBER_OF_CONFLICT_BANDS)) {
+, acs_conflict_bands_(std::vector<std::vector<IndexLevelT> >(BandsRegion::NUMBER_OF_CONFLICT_BANDS))
+, conflict_generation_(0) {
   parameters.addAlerter(Alerter::SingleBands(det,T,T));
   parameters.setLookaheadTime(T);
   stale();
@@ -70,20 +83,38 @@ DaidalusCore::DaidalusCore(const DaidalusCore& core)
 , wind_vector(core.wind_vector)
 , parameters(core.parameters)
 , urgency_strategy_(core.urgency_strategy_)
+, worker_pool_(core.worker_pool_)
+, search_stride_(core.search_stride_)
+, trajectory_anchor_period_(core.trajectory_anchor_period_)
+, traffic_prefilter_(core.traffic_prefilter_)
 , cache_(0) // Cached_ variables are cleared
-, acs_conflict_bands_(std::vector<std::vector<IndexLevelT> >(BandsRegion::NUMBER_OF_CONFLICT_BANDS)) {
+, acs_conflict_bands_(std::vector<std::vector<IndexLevelT> >(BandsRegion::NUMBER_OF_CONFLICT_BANDS))
+, conflict_generation_(0) {
+  index_traffic(0);
   stale();
 }
 
+DaidalusCore::~DaidalusCore() {
+  std::vector<DaidalusSpreadAlerting*>::iterator spread_ptr;
+  for (spread_ptr = spread_alerting_.begin(); spread_ptr != spread_alerting_.end(); ++spread_ptr) {
+    delete *spread_ptr;
+  }
+}
+
 void DaidalusCore::copyFrom(const DaidalusCore& core) {
   if (&core != this) {
     ownship = core.ownship;
     traffic = core.traffic;
+    index_traffic(0);
     current_time = core.current_time;
     wind_vector = core.wind_vector;
     parameters = core.parameters;
     delete urgency_strategy_;
     urgency_strategy_ = core.urgency_strategy_->copy();
+    worker_pool_ = core.worker_pool_;
+    search_stride_ = core.search_stride_;
+    trajectory_anchor_period_ = core.trajectory_anchor_period_;
+    traffic_prefilter_ = core.traffic_prefilter_;
     // Cached_ variables are cleared
     cache_ = 0;
     stale();
@@ -109,6 +140,34 @@ bool DaidalusCore::set_urgency_strategy(const UrgencyStrategy* strat) {
   return false;
 }
 
+WorkerPool& DaidalusCore::worker_pool() const {
+  return worker_pool_;
+}
+
+int DaidalusCore::search_stride() const {
+  return search_stride_;
+}
+
+void DaidalusCore::set_search_stride(int stride) {
+  search_stride_ = stride < 1 ? 1 : stride;
+}
+
+int DaidalusCore::trajectory_anchor_period() const {
+  return trajectory_anchor_period_;
+}
+
+void DaidalusCore::set_trajectory_anchor_period(int period) {
+  trajectory_anchor_period_ = period < 1 ? 1 : period;
+}
+
+bool DaidalusCore::traffic_prefilter() const {
+  return traffic_prefilter_;
+}
+
+void DaidalusCore::set_traffic_prefilter(bool flag) {
+  traffic_prefilter_ = flag;
+}
+
 
 /**
  *  Clear ownship and traffic data from this object.
@@ -152,6 +211,10 @@ bool DaidalusCore::set_alerter_traffic(int idx, int alerter_idx) {
 void DaidalusCore::clear_hysteresis() {
   alerting_hysteresis_acs_.clear();
   dta_hysteresis_acs_.clear();
+  // Identifiers are only interned while there is data associated to them
+  aircraft_ids_.clear();
+  traffic_index_.clear();
+  index_traffic(0);
   stale();
 }
 
@@ -160,6 +223,9 @@ void DaidalusCore::clear_hysteresis() {
  * If hysteresis is true, it also clears hysteresis variables
  */
 void DaidalusCore::stale() {
+  // Memoized conflict data is invalidated even if cached values are already stale, since
+  // it may also be populated by on-demand queries
+  ++conflict_generation_;
   if (cache_ >= 0) {
     cache_ = -1;
     most_urgent_ac_ = TrafficState::INVALID();
@@ -171,12 +237,16 @@ void DaidalusCore::stale() {
       tiov_[conflict_region] = Interval::EMPTY;
       bands4region_[conflict_region] = false;
     }
-    std::map<std::string,HysteresisData>::iterator hysteresis_ptr;
+    std::vector<AircraftHysteresis>::iterator hysteresis_ptr;
     for (hysteresis_ptr = alerting_hysteresis_acs_.begin();hysteresis_ptr != alerting_hysteresis_acs_.end();++hysteresis_ptr) {
-      hysteresis_ptr->second.outdateIfCurrentTime(current_time);
+      if (hysteresis_ptr->valid) {
+        hysteresis_ptr->data.outdateIfCurrentTime(current_time);
+      }
     }
     for (hysteresis_ptr = dta_hysteresis_acs_.begin();hysteresis_ptr != dta_hysteresis_acs_.end();++hysteresis_ptr) {
-      hysteresis_ptr->second.outdateIfCurrentTime(current_time);
+      if (hysteresis_ptr->valid) {
+        hysteresis_ptr->data.outdateIfCurrentTime(current_time);
+      }
     }
   }
 }
@@ -193,9 +263,7 @@ bool DaidalusCore::isFresh() const {
  */
 void DaidalusCore::refresh() {
   if (cache_ <= 0) {
-    for (int ac=0; ac < static_cast<int>(traffic.size()); ++ac) {
-      alert_level(ac,0,0,0);
-    }
+    refresh_alert_levels();
     for (int conflict_region=0; conflict_region < BandsRegion::NUMBER_OF_CONFLICT_BANDS; ++conflict_region) {
       conflict_aircraft(conflict_region);
       BandsRegion::Region region = BandsRegion::regionFromOrder(BandsRegion::NUMBER_OF_CONFLICT_BANDS-conflict_region);
@@ -269,6 +337,13 @@ int DaidalusCore::DTAStatus() {
   return dta_status_;
 }
 
+/**
+ * Same as DTAStatus, but requires a fresh core. This method doesn't modify the core.
+ */
+int DaidalusCore::DTAStatus() const {
+  return dta_status_;
+}
+
 /**
  * @return most urgent aircraft for implicit coordination
  */
@@ -300,6 +375,13 @@ int DaidalusCore::epsilonV() {
  */
 int DaidalusCore::epsilonH(bool recovery_case, const TrafficState& traffic) {
   refresh_mua_eps();
+  return static_cast<const DaidalusCore&>(*this).epsilonH(recovery_case,traffic);
+}
+
+/**
+ * Same as epsilonH, but requires a fresh core. This method doesn't modify the core.
+ */
+int DaidalusCore::epsilonH(bool recovery_case, const TrafficState& traffic) const {
   if ((recovery_case? parameters.isEnabledRecoveryCriteria() : parameters.isEnabledConflictCriteria()) &&
       traffic.sameId(most_urgent_ac_)) {
     return epsh_;
@@ -312,6 +394,13 @@ int DaidalusCore::epsilonH(bool recovery_case, const TrafficState& traffic) {
  */
 int DaidalusCore::epsilonV(bool recovery_case, const TrafficState& traffic) {
   refresh_mua_eps();
+  return static_cast<const DaidalusCore&>(*this).epsilonV(recovery_case,traffic);
+}
+
+/**
+ * Same as epsilonV, but requires a fresh core. This method doesn't modify the core.
+ */
+int DaidalusCore::epsilonV(bool recovery_case, const TrafficState& traffic) const {
   if ((recovery_case? parameters.isEnabledRecoveryCriteria() : parameters.isEnabledConflictCriteria()) &&
       traffic.sameId(most_urgent_ac_)) {
     return epsv_;
@@ -327,6 +416,13 @@ bool DaidalusCore::bands_for(int region) {
   return bands4region_[region];
 }
 
+/**
+ * Same as bands_for, but requires a fresh core. This method doesn't modify the core.
+ */
+bool DaidalusCore::bands_for(int region) const {
+  return bands4region_[region];
+}
+
 /**
  * Returns actual minimum horizontal separation for recovery bands in internal units.
  */
@@ -359,39 +455,81 @@ void DaidalusCore::set_ownship_state(const std::string& id, const Position& pos,
 
 // Return 0-based index in traffic list (-1 if aircraft doesn't exist)
 int DaidalusCore::find_traffic_state(const std::string& id) const {
-  for (int i = 0; i < static_cast<int>(traffic.size()); ++i) {
-    if (equals(traffic[i].getId(),id)) {
-      return i;
+  int handle = aircraft_ids_.find(id);
+  if (handle >= 0 && handle < static_cast<int>(traffic_index_.size())) {
+    int idx = traffic_index_[handle];
+    // Index is stale when the aircraft is no longer at that position of the traffic list
+    if (0 <= idx && idx < static_cast<int>(traffic.size()) && equals(traffic[idx].getId(),id)) {
+      return idx;
     }
   }
   return -1;
 }
 
+// Set index in traffic list of aircraft at positions from, from+1, ... of the traffic list
+void DaidalusCore::index_traffic(int from) {
+  for (int i = from; i < static_cast<int>(traffic.size()); ++i) {
+    int handle = aircraft_ids_.intern(traffic[i].getId());
+    if (handle >= static_cast<int>(traffic_index_.size())) {
+      traffic_index_.resize(handle+1,-1);
+    }
+    traffic_index_[handle] = i;
+  }
+}
+
 // Return 0-based index in traffic list where aircraft was added. Return -1 if
 // nothing is done (e.g., id is the same as ownship's)
 int DaidalusCore::set_traffic_state(const std::string& id, const Position& pos, const Velocity& vel, double time) {
+  int idx = put_traffic_state(id,pos,vel,time);
+  if (idx >= 0) {
+    stale();
+  }
+  return idx;
+}
+
+// Same as set_traffic_state, but caches are not invalidated
+int DaidalusCore::put_traffic_state(const std::string& id, const Position& pos, const Velocity& vel, double time) {
   if (ownship.isValid() && equals(ownship.getId(),id)) {
     return -1;
   }
   double dt = current_time-time;
   Position pt = dt == 0 ? pos : pos.linear(vel,dt);
-  TrafficState ac = ownship.makeIntruder(id,pt,vel);
+  TrafficState ac = ownship.makeIntruder(id,pt,vel,wind_vector);
   if (ac.isValid()) {
-    ac.applyWindVector(wind_vector);
     int idx = find_traffic_state(id);
     if (idx >= 0) {
       traffic[idx]=ac;
     } else {
       idx = traffic.size();
       traffic.push_back(ac);
+      index_traffic(idx);
     }
-    stale();
     return idx;
   } else {
     return -1;
   }
 }
 
+// Add or update traffic aircraft from n tracks. Caches are invalidated once. Return number of
+// tracks that were set (tracks whose id is the same as ownship's are ignored)
+int DaidalusCore::set_traffic_states(const TrafficTrack* tracks, int n) {
+  traffic.reserve(traffic.size()+n);
+  int count = 0;
+  for (int i = 0; i < n; ++i) {
+    const TrafficTrack& track = tracks[i];
+    int idx = put_traffic_state(track.id,track.pos,track.vel,track.time);
+    if (idx >= 0) {
+      traffic[idx].setAlerterIndex(track.alerter);
+      traffic[idx].setUncertainty(track.sum);
+      ++count;
+    }
+  }
+  if (count > 0) {
+    stale();
+  }
+  return count;
+}
+
 // idx is 0-based index in traffic list
 void DaidalusCore::reset_ownship(int idx) {
   TrafficState old_own = ownship;
@@ -405,15 +543,22 @@ void DaidalusCore::reset_ownship(int idx) {
       traffic[i].setAsIntruderOf(ownship);
     }
   }
+  index_traffic(idx);
   stale();
 }
 
 // idx is 0-based index in traffic list
 bool DaidalusCore::remove_traffic(int idx) {
   if (0 < idx && idx < static_cast<int>(traffic.size())) {
-    dta_hysteresis_acs_.erase(traffic[idx].getId());
-    alerting_hysteresis_acs_.erase(traffic[idx].getId());
+    int handle = aircraft_ids_.find(traffic[idx].getId());
+    if (0 <= handle && handle < static_cast<int>(dta_hysteresis_acs_.size())) {
+      dta_hysteresis_acs_[handle].valid = false;
+    }
+    if (0 <= handle && handle < static_cast<int>(alerting_hysteresis_acs_.size())) {
+      alerting_hysteresis_acs_[handle].valid = false;
+    }
     traffic.erase(traffic.begin()+idx);
+    index_traffic(idx);
     stale();
     return true;
   }
@@ -540,16 +685,16 @@ void DaidalusCore::conflict_aircraft(int conflict_region) {
       int alert_level = alerter.alertLevelForRegion(region);
       if (alert_level > 0) {
         Detection3D* detector =  alerter.getLevel(alert_level).getCoreDetectionPtr();
-        if (detector != NULL) {
-          std::map<std::string,HysteresisData>::iterator alerting_hysteresis_ptr = alerting_hysteresis_acs_.find(intruder.getId());
+        if (detector != NULL && !out_of_reach(intruder,detector)) {
+          const HysteresisData* alerting_hysteresis = find_hysteresis(alerting_hysteresis_acs_,intruder.getId());
           double alerting_time = alerter.getLevel(alert_level).getAlertingTime();
-          if (alerting_hysteresis_ptr != alerting_hysteresis_acs_.end() &&
-              !ISNAN(alerting_hysteresis_ptr->second.getInitTime()) &&
-              alerting_hysteresis_ptr->second.getInitTime() < current_time &&
-              alerting_hysteresis_ptr->second.getLastValue() == alert_level) {
+          if (alerting_hysteresis != NULL &&
+              !ISNAN(alerting_hysteresis->getInitTime()) &&
+              alerting_hysteresis->getInitTime() < current_time &&
+              alerting_hysteresis->getLastValue() == alert_level) {
             alerting_time = alerter.getLevel(alert_level).getEarlyAlertingTime();
           }
-          ConflictData det = detector->conflictDetectionWithTrafficState(ownship,intruder,0.0,parameters.getLookaheadTime());
+          ConflictData det = conflict_detection(intruder,detector,0.0,parameters.getLookaheadTime());
           if (det.conflict()) {
             if (det.conflictBefore(alerting_time)) {
               acs_conflict_bands_[conflict_region].push_back(IndexLevelT(ac,alert_level,parameters.getLookaheadTime()));
@@ -576,6 +721,13 @@ const std::vector<IndexLevelT>& DaidalusCore::acs_conflict_bands(int conflict_re
   return acs_conflict_bands_[conflict_region];
 }
 
+/**
+ * Same as acs_conflict_bands, but requires a fresh core. This method doesn't modify the core.
+ */
+const std::vector<IndexLevelT>& DaidalusCore::acs_conflict_bands(int conflict_region) const {
+  return acs_conflict_bands_[conflict_region];
+}
+
 /**
  * Requires 0 <= conflict_region < CONFICT_BANDS
  * @return Return time interval of conflict for given conflict region
@@ -586,33 +738,63 @@ const Interval& DaidalusCore::tiov(int conflict_region) {
   return tiov_[conflict_region];
 }
 
+/**
+ * Same as tiov, but requires a fresh core. This method doesn't modify the core.
+ */
+const Interval& DaidalusCore::tiov(int conflict_region) const {
+  return tiov_[conflict_region];
+}
+
 int DaidalusCore::dta_hysteresis_current_value(const TrafficState& ac) {
   if (parameters.getDTALogic() != 0 && parameters.getDTAAlerter() != 0 &&
       parameters.getDTARadius() > 0 && parameters.getDTAHeight() > 0) {
-    std::map<std::string,HysteresisData>::iterator dta_hysteresis_ptr = dta_hysteresis_acs_.find(ac.getId());
-    if (dta_hysteresis_ptr ==  dta_hysteresis_acs_.end()) {
+    HysteresisData* dta_hysteresis_ptr = find_hysteresis(dta_hysteresis_acs_,ac.getId());
+    if (dta_hysteresis_ptr == NULL) {
       HysteresisData dta_hysteresis = HysteresisData(
           parameters.getHysteresisTime(),
           parameters.getPersistenceTime(),
           parameters.getAlertingParameterM(),
           parameters.getAlertingParameterN());
-      int raw_dta = Util::almost_leq(ac.getPosition().distanceH(parameters.getDTAPosition()),parameters.getDTARadius()) &&
-          Util::almost_leq(ac.getPosition().alt(),parameters.getDTAHeight()) ? 1 : 0;
-      int actual_dta = dta_hysteresis.applyHysteresisLogic(raw_dta,current_time);
-      dta_hysteresis_acs_[ac.getId()] = dta_hysteresis;
+      int raw_dta_value = raw_dta(ac);
+      int actual_dta = dta_hysteresis.applyHysteresisLogic(raw_dta_value,current_time);
+      set_hysteresis(dta_hysteresis_acs_,ac.getId(),dta_hysteresis);
       return actual_dta;
-    } else if (dta_hysteresis_ptr->second.isUpdatedAtCurrentTime(current_time)) {
-      return dta_hysteresis_ptr->second.getLastValue();
+    } else if (dta_hysteresis_ptr->isUpdatedAtCurrentTime(current_time)) {
+      return dta_hysteresis_ptr->getLastValue();
     } else {
-      int raw_dta = Util::almost_leq(ac.getPosition().distanceH(parameters.getDTAPosition()),parameters.getDTARadius()) &&
-          Util::almost_leq(ac.getPosition().alt(),parameters.getDTAHeight()) ? 1 : 0;
-      return dta_hysteresis_ptr->second.applyHysteresisLogic(raw_dta,current_time);
+      int raw_dta_value = raw_dta(ac);
+      return dta_hysteresis_ptr->applyHysteresisLogic(raw_dta_value,current_time);
     }
   } else {
     return 0;
   }
 }
 
+// Same as dta_hysteresis_current_value, but hysteresis data is only read
+int DaidalusCore::dta_hysteresis_current_value(const TrafficState& ac) const {
+  if (parameters.getDTALogic() != 0 && parameters.getDTAAlerter() != 0 &&
+      parameters.getDTARadius() > 0 && parameters.getDTAHeight() > 0) {
+    const HysteresisData* dta_hysteresis_ptr = find_hysteresis(dta_hysteresis_acs_,ac.getId());
+    if (dta_hysteresis_ptr != NULL && dta_hysteresis_ptr->isUpdatedAtCurrentTime(current_time)) {
+      return dta_hysteresis_ptr->getLastValue();
+    }
+    HysteresisData dta_hysteresis = dta_hysteresis_ptr != NULL ? *dta_hysteresis_ptr :
+        HysteresisData(parameters.getHysteresisTime(),
+            parameters.getPersistenceTime(),
+            parameters.getAlertingParameterM(),
+            parameters.getAlertingParameterN());
+    return dta_hysteresis.applyHysteresisLogic(raw_dta(ac),current_time);
+  } else {
+    return 0;
+  }
+}
+
+// Raw DTA status of aircraft ac, before hysteresis logic is applied
+int DaidalusCore::raw_dta(const TrafficState& ac) const {
+  return Util::almost_leq(ac.getPosition().distanceH(parameters.getDTAPosition()),parameters.getDTARadius()) &&
+      Util::almost_leq(ac.getPosition().alt(),parameters.getDTAHeight()) ? 1 : 0;
+}
+
 /**
  * Return alert index used for intruder aircraft.
  * The alert index depends on alerting logic and DTA logic.
@@ -637,6 +819,111 @@ int DaidalusCore::alerter_index_of(const TrafficState& intruder) {
   }
 }
 
+/**
+ * Same as alerter_index_of, but hysteresis data is only read. When the DTA status of
+ * an aircraft is not updated at current time, it's computed on a copy of its hysteresis data.
+ */
+int DaidalusCore::alerter_index_of(const TrafficState& intruder) const {
+  if (parameters.isAlertingLogicOwnshipCentric()) {
+    if (dta_hysteresis_current_value(ownship) == 1) {
+      return parameters.getDTAAlerter();
+    } else {
+      return ownship.getAlerterIndex();
+    }
+  } else {
+    if (dta_hysteresis_current_value(intruder) == 1) {
+      return parameters.getDTAAlerter();
+    } else {
+      return intruder.getAlerterIndex();
+    }
+  }
+}
+
+/**
+ * Returns true if the traffic pre-filter is enabled and intruder is provably not in conflict with ownship,
+ * for the given detector within lookahead time, under any ownship maneuver considered by alerting and bands.
+ * Kinematic and instantaneous maneuvers only probe conflicts within lookahead time and they don't exceed
+ * the largest of the current ownship horizontal speed and the maximum horizontal speed. Wind speed is
+ * added in case the latter is an air speed.
+ */
+bool DaidalusCore::out_of_reach(const TrafficState& intruder, const Detection3D* detector) const {
+  if (!traffic_prefilter_ || detector == NULL) {
+    return false;
+  }
+  double vo = Util::max(ownship.get_v().gs(),parameters.getMaxHorizontalSpeed()+wind_vector.gs());
+  double vh = vo+intruder.get_v().gs();
+  double reach = detector->horizontalReachSUM(parameters.getLookaheadTime(),vh,ownship.sum(),intruder.sum());
+  return ownship.get_s().distanceH(intruder.get_s()) > reach;
+}
+
+/**
+ * Returns conflict data of ownship and intruder with detector in the time interval [B,T].
+ * When intruder is an aircraft of the traffic list, the result is memoized until cached
+ * values become stale, so that alerting, bands, and on-demand queries of the same cycle
+ * evaluate the detector only once.
+ */
+ConflictData DaidalusCore::conflict_detection(const TrafficState& intruder, Detection3D* detector, double B, double T) {
+  int handle = memo_handle(intruder);
+  if (handle < 0) {
+    return detector->conflictDetectionWithTrafficState(ownship,intruder,B,T);
+  }
+  if (handle >= static_cast<int>(conflicts_acs_.size())) {
+    conflicts_acs_.resize(handle+1);
+  }
+  AircraftConflicts& conflicts = conflicts_acs_[handle];
+  if (conflicts.generation != conflict_generation_) {
+    conflicts.generation = conflict_generation_;
+    conflicts.memo.clear();
+  }
+  std::vector<ConflictMemo>::const_iterator memo_ptr;
+  for (memo_ptr = conflicts.memo.begin(); memo_ptr != conflicts.memo.end(); ++memo_ptr) {
+    if (memo_ptr->detector == detector && memo_ptr->B == B && memo_ptr->T == T) {
+      return memo_ptr->data;
+    }
+  }
+  ConflictMemo memo;
+  memo.detector = detector;
+  memo.B = B;
+  memo.T = T;
+  memo.data = detector->conflictDetectionWithTrafficState(ownship,intruder,B,T);
+  conflicts.memo.push_back(memo);
+  return memo.data;
+}
+
+/**
+ * Same as conflict_detection, but the memo is only read. When the conflict data is not
+ * memoized, the detector is called directly. This method doesn't modify the core, so
+ * it can be used by concurrent refreshes of bands.
+ */
+ConflictData DaidalusCore::memoized_conflict_detection(const TrafficState& intruder, Detection3D* detector, double B, double T) const {
+  int handle = memo_handle(intruder);
+  if (handle >= 0 && handle < static_cast<int>(conflicts_acs_.size()) &&
+      conflicts_acs_[handle].generation == conflict_generation_) {
+    const std::vector<ConflictMemo>& memo = conflicts_acs_[handle].memo;
+    std::vector<ConflictMemo>::const_iterator memo_ptr;
+    for (memo_ptr = memo.begin(); memo_ptr != memo.end(); ++memo_ptr) {
+      if (memo_ptr->detector == detector && memo_ptr->B == B && memo_ptr->T == T) {
+        return memo_ptr->data;
+      }
+    }
+  }
+  return detector->conflictDetectionWithTrafficState(ownship,intruder,B,T);
+}
+
+/*
+ * Handle of intruder in the conflict detection memo or -1, if intruder is not a
+ * state of the traffic list. Only states in the traffic list are memoized.
+ */
+int DaidalusCore::memo_handle(const TrafficState& intruder) const {
+  int handle = aircraft_ids_.find(intruder.getId());
+  if (handle < 0 || handle >= static_cast<int>(traffic_index_.size()) ||
+      traffic_index_[handle] < 0 || traffic_index_[handle] >= static_cast<int>(traffic.size()) ||
+      &traffic[traffic_index_[handle]] != &intruder) {
+    return -1;
+  }
+  return handle;
+}
+
 int DaidalusCore::epsilonH(const TrafficState& ownship, const TrafficState& ac) {
   if (ownship.isValid() && ac.isValid()) {
     Vect2 s = ownship.get_s().Sub(ac.get_s()).vect2();
@@ -668,59 +955,31 @@ TrafficState DaidalusCore::recovery_ac() {
 /**
  * Return true if and only if threshold values, defining an alerting level, are violated.
  */
-bool DaidalusCore::check_alerting_thresholds(const Alerter& alerter, int alert_level, const TrafficState& intruder, int turning, int accelerating, int climbing) {
+bool DaidalusCore::check_alerting_thresholds(DaidalusSpreadAlerting& spread, const Alerter& alerter, int alert_level, const TrafficState& intruder, int turning, int accelerating, int climbing) {
   const AlertThresholds& athr = alerter.getLevel(alert_level);
   if (athr.isValid()) {
     Detection3D* detector = athr.getCoreDetectionPtr();
-    std::map<std::string,HysteresisData>::iterator alerting_hysteresis_ptr = alerting_hysteresis_acs_.find(intruder.getId());
+    if (out_of_reach(intruder,detector)) {
+      return false;
+    }
+    const HysteresisData* alerting_hysteresis = find_hysteresis(alerting_hysteresis_acs_,intruder.getId());
     double alerting_time = alerter.getLevel(alert_level).getAlertingTime();
-    if (alerting_hysteresis_ptr != alerting_hysteresis_acs_.end() &&
-        !ISNAN(alerting_hysteresis_ptr->second.getLastTime()) &&
-        alerting_hysteresis_ptr->second.getLastTime() < current_time &&
-        alerting_hysteresis_ptr->second.getLastValue() == alert_level) {
+    if (alerting_hysteresis != NULL &&
+        !ISNAN(alerting_hysteresis->getLastTime()) &&
+        alerting_hysteresis->getLastTime() < current_time &&
+        alerting_hysteresis->getLastValue() == alert_level) {
       alerting_time = alerter.getLevel(alert_level).getEarlyAlertingTime();
     }
     int epsh = epsilonH(false,intruder);
     int epsv = epsilonV(false,intruder);
-    ConflictData det = detector->conflictDetectionWithTrafficState(ownship,intruder,0.0,parameters.getLookaheadTime());
+    ConflictData det = conflict_detection(intruder,detector,0.0,parameters.getLookaheadTime());
     if (det.conflictBefore(alerting_time)) {
       return true;
     }
-    if (athr.getHorizontalDirectionSpread() > 0 || athr.getHorizontalSpeedSpread() > 0 ||
-        athr.getVerticalSpeedSpread() > 0 || athr.getAltitudeSpread() > 0) {
-      if (athr.getHorizontalDirectionSpread() > 0) {
-        DaidalusDirBands dir_band;
-        dir_band.set_min_max_rel(turning <= 0 ? athr.getHorizontalDirectionSpread() : 0,
-            turning >= 0 ? athr.getHorizontalDirectionSpread() : 0);
-        if (dir_band.kinematic_conflict(parameters,ownship,intruder,detector,epsh,epsv,alerting_time,DTAStatus())) {
-          return true;
-        }
-      }
-      if (athr.getHorizontalSpeedSpread() > 0) {
-        DaidalusHsBands hs_band;
-        hs_band.set_min_max_rel(accelerating <= 0 ? athr.getHorizontalSpeedSpread() : 0,
-            accelerating >= 0 ? athr.getHorizontalSpeedSpread() : 0);
-        if (hs_band.kinematic_conflict(parameters,ownship,intruder,detector,epsh,epsv,alerting_time,DTAStatus())) {
-          return true;
-        }
-      }
-      if (athr.getVerticalSpeedSpread() > 0) {
-        DaidalusVsBands vs_band;
-        vs_band.set_min_max_rel(climbing <= 0 ? athr.getVerticalSpeedSpread() : 0,
-            climbing >= 0 ? athr.getVerticalSpeedSpread() : 0);
-        if (vs_band.kinematic_conflict(parameters,ownship,intruder,detector,epsh,epsv,alerting_time,DTAStatus())) {
-          return true;
-        }
-      }
-      if (athr.getAltitudeSpread() > 0) {
-        DaidalusAltBands alt_band;
-        alt_band.set_min_max_rel(climbing <= 0 ? athr.getAltitudeSpread() : 0,
-            climbing >= 0 ? athr.getAltitudeSpread() : 0);
-        if (alt_band.kinematic_conflict(parameters,ownship,intruder,detector,epsh,epsv,alerting_time,DTAStatus())) {
-          return true;
-        }
-      }
-    }
+    // DTA status depends on alerting. Therefore, the last computed status is used. This status is 0 while
+    // alert levels are refreshed.
+    return spread.conflict(parameters,ownship,intruder,athr,detector,epsh,epsv,alerting_time,dta_status_,
+        turning,accelerating,climbing);
   }
   return false;
 }
@@ -728,30 +987,115 @@ bool DaidalusCore::check_alerting_thresholds(const Alerter& alerter, int alert_l
 int DaidalusCore::alerting_hysteresis_current_value(const TrafficState& intruder, int turning, int accelerating, int climbing) {
   int alerter_idx = alerter_index_of(intruder);
   if (1 <= alerter_idx && alerter_idx <= parameters.numberOfAlerters()) {
-    std::map<std::string,HysteresisData>::iterator alerting_hysteresis_ptr = alerting_hysteresis_acs_.find(intruder.getId());
-    if (alerting_hysteresis_ptr == alerting_hysteresis_acs_.end()) {
-      HysteresisData alerting_hysteresis = HysteresisData(
-          parameters.getHysteresisTime(),
-          parameters.getPersistenceTime(),
-          parameters.getAlertingParameterM(),
-          parameters.getAlertingParameterN());
-      const Alerter& alerter = parameters.getAlerterAt(alerter_idx);
-      int raw_alert = raw_alert_level(alerter,intruder,turning,accelerating,climbing);
-      int actual_alert = alerting_hysteresis.applyHysteresisLogic(raw_alert,current_time);
-      alerting_hysteresis_acs_[intruder.getId()] = alerting_hysteresis;
-      return actual_alert;
-    } else if (alerting_hysteresis_ptr->second.isUpdatedAtCurrentTime(current_time)) {
-      return alerting_hysteresis_ptr->second.getLastValue();
+    HysteresisData* alerting_hysteresis_ptr = find_hysteresis(alerting_hysteresis_acs_,intruder.getId());
+    if (alerting_hysteresis_ptr != NULL && alerting_hysteresis_ptr->isUpdatedAtCurrentTime(current_time)) {
+      return alerting_hysteresis_ptr->getLastValue();
     } else {
       const Alerter& alerter = parameters.getAlerterAt(alerter_idx);
-      int raw_alert = raw_alert_level(alerter,intruder,turning,accelerating,climbing);
-      return alerting_hysteresis_ptr->second.applyHysteresisLogic(raw_alert,current_time);
+      int raw_alert = raw_alert_level(spread_alerting(0),alerter,intruder,turning,accelerating,climbing);
+      return apply_alerting_hysteresis(intruder,raw_alert);
     }
   } else {
     return -1;
   }
 }
 
+// Apply alerting hysteresis logic of intruder to raw alert level at current time
+int DaidalusCore::apply_alerting_hysteresis(const TrafficState& intruder, int raw_alert) {
+  HysteresisData* alerting_hysteresis_ptr = find_hysteresis(alerting_hysteresis_acs_,intruder.getId());
+  if (alerting_hysteresis_ptr == NULL) {
+    HysteresisData alerting_hysteresis = HysteresisData(
+        parameters.getHysteresisTime(),
+        parameters.getPersistenceTime(),
+        parameters.getAlertingParameterM(),
+        parameters.getAlertingParameterN());
+    int actual_alert = alerting_hysteresis.applyHysteresisLogic(raw_alert,current_time);
+    set_hysteresis(alerting_hysteresis_acs_,intruder.getId(),alerting_hysteresis);
+    return actual_alert;
+  } else {
+    return alerting_hysteresis_ptr->applyHysteresisLogic(raw_alert,current_time);
+  }
+}
+
+/**
+ * Input and output of the computation of the raw alert level of one traffic aircraft
+ */
+struct RawAlertJob {
+  int ac;
+  const Alerter* alerter;
+  int raw_alert;
+};
+
+/**
+ * Task that computes raw alert levels of traffic aircraft. Jobs are split in contiguous chunks
+ * and the i-th chunk uses the i-th checker of spread alerting thresholds. Besides checkers,
+ * memoized conflict data is the only state written by the jobs, and it's kept per aircraft.
+ * Therefore, different chunks can be executed concurrently.
+ */
+struct DaidalusCore::RawAlertTask : public WorkerTask {
+  DaidalusCore& core;
+  std::vector<RawAlertJob>& jobs;
+  int chunks;
+
+  RawAlertTask(DaidalusCore& c, std::vector<RawAlertJob>& j, int n) : core(c), jobs(j), chunks(n) {}
+
+  void execute(int i) {
+    int n = static_cast<int>(jobs.size());
+    DaidalusSpreadAlerting& spread = *core.spread_alerting_[i];
+    spread.begin(core.parameters,core.ownship);
+    for (int j = i*n/chunks; j < (i+1)*n/chunks; ++j) {
+      RawAlertJob& job = jobs[j];
+      job.raw_alert = core.raw_alert_level(spread,*job.alerter,core.traffic[job.ac],0,0,0);
+    }
+    spread.end();
+  }
+};
+
+/**
+ * Compute alert levels of all traffic aircraft at current time. When the worker pool is
+ * parallel, raw alert levels of traffic aircraft are computed concurrently. Alerter indices,
+ * which may update DTA hysteresis, and alerting hysteresis are computed serially in the
+ * order of the traffic list, so that the result is the same as in the serial computation.
+ */
+void DaidalusCore::refresh_alert_levels() {
+  WorkerPool& pool = worker_pool();
+  if (!pool.isParallel() || pool.isRunning() || traffic.size() < 2) {
+    DaidalusSpreadAlerting& spread = spread_alerting(0);
+    spread.begin(parameters,ownship);
+    for (int ac=0; ac < static_cast<int>(traffic.size()); ++ac) {
+      alert_level(ac,0,0,0);
+    }
+    spread.end();
+    return;
+  }
+  // Shared values read by the jobs are computed beforehand
+  refresh_mua_eps();
+  if (conflicts_acs_.size() < static_cast<std::vector<AircraftConflicts>::size_type>(aircraft_ids_.size())) {
+    conflicts_acs_.resize(aircraft_ids_.size());
+  }
+  std::vector<RawAlertJob> jobs;
+  for (int ac=0; ac < static_cast<int>(traffic.size()); ++ac) {
+    int alerter_idx = alerter_index_of(traffic[ac]);
+    if (1 <= alerter_idx && alerter_idx <= parameters.numberOfAlerters()) {
+      const HysteresisData* alerting_hysteresis_ptr = find_hysteresis(alerting_hysteresis_acs_,traffic[ac].getId());
+      if (alerting_hysteresis_ptr == NULL || !alerting_hysteresis_ptr->isUpdatedAtCurrentTime(current_time)) {
+        RawAlertJob job = {ac,&parameters.getAlerterAt(alerter_idx),0};
+        jobs.push_back(job);
+      }
+    }
+  }
+  int chunks = Util::min(pool.getNumberOfThreads(),static_cast<int>(jobs.size()));
+  if (chunks > 0) {
+    // Checkers are allocated before the jobs run
+    spread_alerting(chunks-1);
+    RawAlertTask task(*this,jobs,chunks);
+    pool.run(task,chunks);
+  }
+  for (int i=0; i < static_cast<int>(jobs.size()); ++i) {
+    apply_alerting_hysteresis(traffic[jobs[i].ac],jobs[i].raw_alert);
+  }
+}
+
 /**
  * Computes alerting type of ownship and an the idx-th aircraft in the traffic list
  * The number 0 means no alert. A negative number means
@@ -777,15 +1121,72 @@ int DaidalusCore::alert_level(int idx, int turning, int accelerating, int climbi
   }
 }
 
-int DaidalusCore::raw_alert_level(const Alerter& alerter, const TrafficState& intruder, int turning, int accelerating, int climbing) {
+/**
+ * Return i-th checker of spread alerting thresholds. Checkers are allocated on demand.
+ */
+DaidalusSpreadAlerting& DaidalusCore::spread_alerting(int i) {
+  while (static_cast<int>(spread_alerting_.size()) <= i) {
+    spread_alerting_.push_back(new DaidalusSpreadAlerting());
+  }
+  return *spread_alerting_[i];
+}
+
+int DaidalusCore::raw_alert_level(DaidalusSpreadAlerting& spread, const Alerter& alerter, const TrafficState& intruder, int turning, int accelerating, int climbing) {
   for (int alert_level=alerter.mostSevereAlertLevel(); alert_level > 0; --alert_level) {
-    if (check_alerting_thresholds(alerter,alert_level,intruder,turning,accelerating,climbing)) {
+    if (check_alerting_thresholds(spread,alerter,alert_level,intruder,turning,accelerating,climbing)) {
       return alert_level;
     }
   }
   return 0;
 }
 
+// Return hysteresis data of aircraft id in acs, or NULL if there is none
+HysteresisData* DaidalusCore::find_hysteresis(std::vector<AircraftHysteresis>& acs, const std::string& id) {
+  int handle = aircraft_ids_.find(id);
+  if (handle >= 0 && handle < static_cast<int>(acs.size()) && acs[handle].valid) {
+    return &acs[handle].data;
+  }
+  return NULL;
+}
+
+// Return hysteresis data of aircraft id in acs, or NULL if there is none
+const HysteresisData* DaidalusCore::find_hysteresis(const std::vector<AircraftHysteresis>& acs, const std::string& id) const {
+  int handle = aircraft_ids_.find(id);
+  if (handle >= 0 && handle < static_cast<int>(acs.size()) && acs[handle].valid) {
+    return &acs[handle].data;
+  }
+  return NULL;
+}
+
+// Set hysteresis data of aircraft id in acs
+void DaidalusCore::set_hysteresis(std::vector<AircraftHysteresis>& acs, const std::string& id, const HysteresisData& hysteresis) {
+  int handle = aircraft_ids_.intern(id);
+  if (handle >= static_cast<int>(acs.size())) {
+    acs.resize(handle+1);
+  }
+  acs[handle].valid = true;
+  acs[handle].data = hysteresis;
+}
+
+// Hysteresis data in acs listed by aircraft's id
+std::string DaidalusCore::hysteresisString(const std::string& name, const std::vector<AircraftHysteresis>& acs) const {
+  std::map<std::string,int> handles;
+  for (int handle = 0; handle < static_cast<int>(acs.size()); ++handle) {
+    if (acs[handle].valid) {
+      handles[aircraft_ids_.id(handle)] = handle;
+    }
+  }
+  std::string s = "";
+  std::map<std::string,int>::const_iterator entry_ptr;
+  for (entry_ptr = handles.begin(); entry_ptr != handles.end(); ++entry_ptr) {
+    s+=name+"["+entry_ptr->first+"] = "+acs[entry_ptr->second].data.toString();
+  }
+  if (!handles.empty()) {
+    s+="\n";
+  }
+  return s;
+}
+
 std::string DaidalusCore::outputStringAircraftStates(bool internal) const {
   std::string ualt = internal ? "m" : parameters.getUnitsOf("step_alt");
   std::string uhs = internal ? "m/s" : parameters.getUnitsOf("step_hs");
@@ -843,24 +1244,8 @@ std::string DaidalusCore::rawString() const {
     s += Fmb(bands4region_[conflict_region]);
   }
   s += "}\n";
-  std::map<std::string,HysteresisData>::const_iterator entry_ptr = alerting_hysteresis_acs_.begin();
-  while (entry_ptr != alerting_hysteresis_acs_.end()) {
-    s+="alerting_hysteresis_acs_["+entry_ptr->first+"] = "+
-        entry_ptr->second.toString();
-    ++entry_ptr;
-  }
-  if (!alerting_hysteresis_acs_.empty()) {
-    s+="\n";
-  }
-  entry_ptr = dta_hysteresis_acs_.begin();
-  while (entry_ptr != dta_hysteresis_acs_.end()) {
-    s+="dta_hysteresis_acs_["+entry_ptr->first+"] = "+
-        entry_ptr->second.toString();
-    ++entry_ptr;
-  }
-  if (!dta_hysteresis_acs_.empty()) {
-    s+="\n";
-  }
+  s+=hysteresisString("alerting_hysteresis_acs_",alerting_hysteresis_acs_);
+  s+=hysteresisString("dta_hysteresis_acs_",dta_hysteresis_acs_);
   s+="wind_vector = "+wind_vector.toString()+"\n";
   s+="## Ownship and Traffic Relative to Wind\n";
   s+=outputStringAircraftStates(true);
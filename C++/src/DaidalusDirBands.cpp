@@ -14,7 +14,9 @@
 #include "Tuple5.h"
 #include "Kinematics.h"
 #include "ProjectedKinematics.h"
+#include "CriticalVectors.h"
 #include <vector>
+#include <list>
 
 namespace larcfm {
 
@@ -80,6 +82,80 @@ std::pair<Vect3, Velocity> DaidalusDirBands::trajectory(const DaidalusParameters
   return std::pair<Vect3, Velocity>(ownship.pos_to_s(posvel.first),ownship.vel_to_v(posvel.first,posvel.second));
 }
 
+/**
+ * Velocities of a constant-rate turn at times i*tstep are rotations of the initial velocity by multiples of the
+ * same angle. Samples whose index is a multiple of the anchor period are computed exactly. The velocity of any other
+ * sample is the rotation of the velocity of the previous sample, which avoids trigonometric functions.
+ */
+void DaidalusDirBands::kinematic_trajectory_samples(std::vector<std::pair<Vect3,Velocity> >& samples, const DaidalusParameters& parameters,
+    const TrafficState& ownship, double tstep, bool dir, int maxk) const {
+  int i = static_cast<int>(samples.size());
+  if (i > maxk) {
+    return;
+  }
+  if (i == 0) {
+    samples.push_back(std::pair<Vect3, Velocity>(ownship.get_s(),ownship.get_v()));
+    ++i;
+  }
+  double gso = ownship.velocityXYZ().gs();
+  double bank = parameters.getTurnRate() == 0 ? parameters.getBankAngle() : std::abs(Kinematics::bankAngle(gso,parameters.getTurnRate()));
+  double R = Kinematics::turnRadius(gso,bank);
+  Vect3 so = ownship.positionXYZ().vect3();
+  const Velocity& vo = ownship.velocityXYZ();
+  int sgn = dir ? 1 : -1;
+  double omega = sgn*vo.gs()/R;
+  if (Util::almost_equals(R,0) || Util::almost_equals(omega,0)) {
+    // Not turning
+    for (; i <= maxk; ++i) {
+      samples.push_back(trajectory(parameters,ownship,i*tstep,dir,0,false));
+    }
+    return;
+  }
+  int period = get_anchor_period();
+  double c = std::cos(omega*tstep);
+  double s = std::sin(omega*tstep);
+  for (; i <= maxk; ++i) {
+    double t = i*tstep;
+    Velocity nv;
+    if (i % period == 0) {
+      nv = vo.mkAddTrk(omega*t);
+    } else {
+      const Velocity& pv = samples[i-1].second;
+      nv = Velocity::mkVxyz(pv.x*c+pv.y*s,-pv.x*s+pv.y*c,pv.z);
+    }
+    Vect3 ns = Vect3(so.x + (vo.y-nv.y)/omega,so.y + (-vo.x+nv.x)/omega,so.z + vo.z*t);
+    samples.push_back(std::pair<Vect3, Velocity>(ns,nv));
+  }
+}
+
+/**
+ * Critical steps are computed from critical tracks
+ */
+bool DaidalusDirBands::instantaneous_critical_steps(std::vector<double>& ks, const DaidalusParameters& parameters,
+    const TrafficState& ownship, const TrafficState& traffic, bool dir,
+    double D, double H, double B, double T, double TH, double TV, bool exact) const {
+  double step = get_step(parameters);
+  if (step <= 0) {
+    return false;
+  }
+  Vect3 s = ownship.get_s().Sub(traffic.get_s());
+  const Velocity& vo = ownship.get_v();
+  const Velocity& vi = traffic.get_v();
+  std::list<Vect2> trks;
+  if (exact) {
+    trks = CriticalVectors::tracks(s,vo,vi,D,H,B,T);
+  } else if (ISFINITE(D)) {
+    trks = CriticalVectors2D::tracks(s.vect2(),vo.vect2(),vi.vect2(),D,B,TH);
+  }
+  double trk = own_val(ownship);
+  for (std::list<Vect2>::const_iterator trk_ptr = trks.begin(); trk_ptr != trks.end(); ++trk_ptr) {
+    double k = Util::to_2pi((dir?1:-1)*(trk_ptr->compassAngle()-trk))/step;
+    ks.push_back(k);
+    ks.push_back(k+2*M_PI/step);
+  }
+  return true;
+}
+
 double DaidalusDirBands::max_delta_resolution(const DaidalusParameters& parameters) const {
   return parameters.getPersistencePreferredHorizontalDirectionResolution();
 }
@@ -10,22 +10,38 @@
  */
 
 #include "DaidalusFileWalker.h"
+#include <algorithm>
 
 namespace larcfm {
 
 DaidalusFileWalker::DaidalusFileWalker(const std::string& filename) {
-  sr_ = SequenceReader(filename);
+  open(filename);
   init();
 }
 
 void DaidalusFileWalker::resetInputFile(const std::string& filename) {
-  sr_ = SequenceReader(filename);
+  open(filename);
   init();
 }
 
+void DaidalusFileWalker::open(const std::string& filename) {
+  binary_ = DaidalusBinaryReader::isBinaryFile(filename);
+  if (binary_) {
+    sr_ = SequenceReader();
+    bin_.open(filename);
+  } else {
+    bin_.close();
+    sr_ = SequenceReader(filename);
+  }
+}
+
 void DaidalusFileWalker::init() {
-  sr_.setWindowSize(1);
   index_ = 0;
+  if (binary_) {
+    times_ = bin_.getTimes();
+    return;
+  }
+  sr_.setWindowSize(1);
   times_ = sr_.sequenceKeys();
   if (times_.size() > 0)
     sr_.setActive(times_[0]);
@@ -72,7 +88,9 @@ bool DaidalusFileWalker::goToTime(double t) {
 bool DaidalusFileWalker::goToTimeStep(int i) {
   if (0 <= i && (unsigned int)i < times_.size()) {
     index_ = i;
-    sr_.setActive(times_[index_]);
+    if (!binary_) {
+      sr_.setActive(times_[index_]);
+    }
     return true;
   }
   return false;
@@ -102,12 +120,8 @@ void DaidalusFileWalker::goPrev() {
 int DaidalusFileWalker::indexOfTime(double t) const {
   int i = -1;
   if (t >= firstTime() && t <= lastTime()) {
-    i = 0;
-    for (; (unsigned int)i < times_.size()-1; ++i) {
-      if (t >= times_[i] && t < times_[i+1]) {
-        break;
-      }
-    }
+    // Times are increasing, so the time step of t is the one before the first time greater than t
+    i = static_cast<int>(std::upper_bound(times_.begin(),times_.end(),t)-times_.begin())-1;
   }
   return i;
 }
@@ -131,7 +145,13 @@ ParameterData DaidalusFileWalker::extraColumnsToParameters(const SequenceReader&
 
 
 void DaidalusFileWalker::readExtraColumns(Daidalus& daa, const SequenceReader& sr, int ac_idx) {
-  ParameterData pcol = extraColumnsToParameters(sr,daa.getCurrentTime(),daa.getAircraftStateAt(ac_idx).getId());
+  readExtraColumns(daa,extraColumnsToParameters(sr,daa.getCurrentTime(),daa.getAircraftStateAt(ac_idx).getId()),ac_idx);
+}
+
+/**
+ * Set parameters and uncertainties of aircraft at index ac_idx from values of extra columns in pcol
+ */
+void DaidalusFileWalker::readExtraColumns(Daidalus& daa, const ParameterData& pcol, int ac_idx) {
   if (pcol.size() > 0) {
     daa.setParameterData(pcol);
     if (pcol.contains("alerter")) {
@@ -181,6 +201,22 @@ void DaidalusFileWalker::readState(Daidalus& daa) {
     daa.setParameterData(p_);
     daa.reset();
   }
+  if (binary_) {
+    int n = 0 <= index_ && index_ < bin_.numberOfSteps() ? bin_.size(index_) : 0;
+    for (int ac = 0; ac < n; ++ac) {
+      std::string ida = bin_.getName(index_,ac);
+      Position sa = bin_.getPosition(index_,ac);
+      Velocity va = bin_.getVelocity(index_,ac);
+      if (ac==0) {
+        daa.setOwnshipState(ida,sa,va,getTime());
+      } else {
+        daa.addTrafficState(ida,sa,va);
+      }
+      readExtraColumns(daa,bin_.getExtraColumns(index_,ac),ac);
+    }
+    goNext();
+    return;
+  }
   for (int ac = 0; ac < sr_.size();++ac) {
     std::string ida = sr_.getName(ac);
     Position sa = sr_.getPosition(ac);
@@ -195,22 +231,45 @@ void DaidalusFileWalker::readState(Daidalus& daa) {
   goNext();
 }
 
+bool DaidalusFileWalker::readTimeStep(DaidalusTimeStep& step) {
+  if (atEnd()) {
+    return false;
+  }
+  double time = getTime();
+  step.clear(time);
+  step.setParameters(p_);
+  if (binary_) {
+    int n = 0 <= index_ && index_ < bin_.numberOfSteps() ? bin_.size(index_) : 0;
+    for (int ac = 0; ac < n; ++ac) {
+      step.add(bin_.getName(index_,ac),bin_.getPosition(index_,ac),bin_.getVelocity(index_,ac),
+          bin_.getExtraColumns(index_,ac));
+    }
+  } else {
+    for (int ac = 0; ac < sr_.size(); ++ac) {
+      std::string ida = sr_.getName(ac);
+      step.add(ida,sr_.getPosition(ac),sr_.getVelocity(ac),extraColumnsToParameters(sr_,time,ida));
+    }
+  }
+  goNext();
+  return true;
+}
+
 // ErrorReporter Interface Methods
 
 bool DaidalusFileWalker::hasError() const {
-  return sr_.hasError();
+  return binary_ ? bin_.hasError() : sr_.hasError();
 }
 
 bool DaidalusFileWalker::hasMessage() const {
-  return sr_.hasMessage();
+  return binary_ ? bin_.hasMessage() : sr_.hasMessage();
 }
 
 std::string DaidalusFileWalker::getMessage() {
-  return sr_.getMessage();
+  return binary_ ? bin_.getMessage() : sr_.getMessage();
 }
 
 std::string DaidalusFileWalker::getMessageNoClear() const {
-  return sr_.getMessageNoClear();
+  return binary_ ? bin_.getMessageNoClear() : sr_.getMessageNoClear();
 }
 
 }
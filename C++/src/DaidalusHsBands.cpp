@@ -14,7 +14,9 @@
 #include "Tuple5.h"
 #include "Kinematics.h"
 #include "ProjectedKinematics.h"
+#include "CriticalVectors.h"
 #include <vector>
+#include <list>
 
 namespace larcfm {
 
@@ -72,6 +74,69 @@ std::pair<Vect3, Velocity> DaidalusHsBands::trajectory(const DaidalusParameters&
   return std::pair<Vect3, Velocity>(ownship.pos_to_s(posvel.first),ownship.vel_to_v(posvel.first,posvel.second));
 }
 
+/**
+ * Ground speed accelerations keep the direction of the initial velocity. Therefore, trigonometric functions
+ * of the direction are computed once for all samples.
+ */
+void DaidalusHsBands::kinematic_trajectory_samples(std::vector<std::pair<Vect3,Velocity> >& samples, const DaidalusParameters& parameters,
+    const TrafficState& ownship, double tstep, bool dir, int maxk) const {
+  int i = static_cast<int>(samples.size());
+  if (i > maxk) {
+    return;
+  }
+  if (i == 0) {
+    samples.push_back(std::pair<Vect3, Velocity>(ownship.get_s(),ownship.get_v()));
+    ++i;
+  }
+  double a = (dir?1:-1)*parameters.getHorizontalAcceleration();
+  Vect3 so = ownship.positionXYZ().vect3();
+  const Velocity& vo = ownship.velocityXYZ();
+  Vect2 so2 = so.vect2();
+  Vect2 vo2 = vo.vect2();
+  Vect2 uo = vo2.Hat();
+  double no = vo2.norm();
+  double gso = vo.gs();
+  double trk = vo.trk();
+  double sin_trk = std::sin(trk);
+  double cos_trk = std::cos(trk);
+  for (; i <= maxk; ++i) {
+    double t = i*tstep;
+    // Same as ProjectedKinematics::gsAccel
+    Vect3 ns = Vect3(so2.Add(uo.Scal(no*t+0.5*a*t*t)),so.z + vo.z*t);
+    double gs = gso+a*t;
+    Velocity nv = Velocity::mkVxyz(gs*sin_trk,gs*cos_trk,vo.vs());
+    samples.push_back(std::pair<Vect3, Velocity>(ns,nv));
+  }
+}
+
+/**
+ * Critical steps are computed from critical ground speeds. Ground speed 0 is also critical since
+ * the direction of ownship is lost.
+ */
+bool DaidalusHsBands::instantaneous_critical_steps(std::vector<double>& ks, const DaidalusParameters& parameters,
+    const TrafficState& ownship, const TrafficState& traffic, bool dir,
+    double D, double H, double B, double T, double TH, double TV, bool exact) const {
+  double step = get_step(parameters);
+  double gso = own_val(ownship);
+  if (step <= 0 || gso <= 0) {
+    return false;
+  }
+  Vect3 s = ownship.get_s().Sub(traffic.get_s());
+  const Velocity& vo = ownship.get_v();
+  const Velocity& vi = traffic.get_v();
+  std::list<Vect2> gss;
+  if (exact) {
+    gss = CriticalVectors::groundSpeeds(s,vo,vi,D,H,B,T);
+  } else if (ISFINITE(D)) {
+    gss = CriticalVectors2D::groundSpeeds(s.vect2(),vo.vect2(),vi.vect2(),D,B,TH);
+  }
+  for (std::list<Vect2>::const_iterator gs_ptr = gss.begin(); gs_ptr != gss.end(); ++gs_ptr) {
+    ks.push_back((dir?1:-1)*(gs_ptr->norm()-gso)/step);
+  }
+  ks.push_back((dir?1:-1)*(-gso)/step);
+  return true;
+}
+
 
 double DaidalusHsBands::max_delta_resolution(const DaidalusParameters& parameters) const {
   return parameters.getPersistencePreferredHorizontalSpeedResolution();
@@ -9,11 +9,236 @@
 #include "CriteriaCore.h"
 #include "TCASTable.h"
 #include "Util.h"
+#include "CD2D.h"
+#include "CD3D.h"
+#include "DetectionBatch.h"
 #include <vector>
 #include <string>
+#include <cmath>
+#include <cassert>
+#include <climits>
 
 namespace larcfm {
 
+DaidalusIntegerBands::DaidalusIntegerBands() :
+    traj_ownship_(NULL),
+    traj_tstep_(0),
+    traj_instantaneous_(false),
+    traj_maxk_(-1),
+    traj_frozen_(false),
+    search_stride_(1),
+    anchor_period_(1),
+    probe_memo_(NULL) {}
+
+/**
+ * Enable trajectory cache for ownship, where samples are taken at times k*tstep, for 0 <= k <= maxk.
+ * When instantaneous is true, only samples at time 0 are cached.
+ */
+void DaidalusIntegerBands::enable_trajectory_cache(const TrafficState& ownship, double tstep, bool instantaneous, int maxk) {
+  disable_trajectory_cache();
+  if (ownship.isValid() && ((instantaneous && tstep == 0) || (tstep > 0 && ISFINITE(tstep))) && maxk >= 0) {
+    traj_ownship_ = &ownship;
+    traj_tstep_ = tstep;
+    traj_instantaneous_ = instantaneous;
+    traj_maxk_ = instantaneous ? 0 : maxk;
+  }
+}
+
+/**
+ * Disable trajectory cache. Cached samples are cleared, but memory is kept for the next computation.
+ */
+void DaidalusIntegerBands::disable_trajectory_cache() {
+  traj_ownship_ = NULL;
+  traj_tstep_ = 0;
+  traj_instantaneous_ = false;
+  traj_maxk_ = -1;
+  traj_frozen_ = false;
+  std::vector<std::vector<std::pair<Vect3,Velocity> > >::iterator samples_ptr;
+  for (samples_ptr = traj_samples_.begin(); samples_ptr != traj_samples_.end(); ++samples_ptr) {
+    samples_ptr->clear();
+  }
+}
+
+/**
+ * Make the trajectory cache read-only (frozen == true) or writable (frozen == false).
+ */
+void DaidalusIntegerBands::freeze_trajectory_cache(bool frozen) {
+  traj_frozen_ = frozen;
+}
+
+/**
+ * Set stride, in number of steps, of the coarse-to-fine search of bands. Values less than 1 are treated as 1,
+ * i.e., exhaustive search.
+ */
+void DaidalusIntegerBands::set_search_stride(int stride) {
+  search_stride_ = stride < 1 ? 1 : stride;
+}
+
+/**
+ * Set period, in number of samples, at which incremental trajectory samples are computed exactly. Values less
+ * than 1 are treated as 1, i.e., every sample is computed exactly.
+ */
+void DaidalusIntegerBands::set_anchor_period(int period) {
+  anchor_period_ = period < 1 ? 1 : period;
+}
+
+int DaidalusIntegerBands::get_anchor_period() const {
+  return anchor_period_;
+}
+
+/**
+ * By default, every sample is computed by trajectory
+ */
+void DaidalusIntegerBands::kinematic_trajectory_samples(std::vector<std::pair<Vect3,Velocity> >& samples, const DaidalusParameters& parameters,
+    const TrafficState& ownship, double tstep, bool dir, int maxk) const {
+  for (int i = static_cast<int>(samples.size()); i <= maxk; ++i) {
+    samples.push_back(trajectory(parameters,ownship,i*tstep,dir,0,false));
+  }
+}
+
+/**
+ * Compute all kinematic samples of the trajectory cache in both directions, when samples are not computed exactly.
+ */
+void DaidalusIntegerBands::fill_trajectory_cache(const DaidalusParameters& parameters) const {
+  if (anchor_period_ > 1 && traj_ownship_ != NULL && !traj_instantaneous_ && !traj_frozen_) {
+    if (traj_samples_.size() < 2) {
+      traj_samples_.resize(2);
+    }
+    kinematic_trajectory_samples(traj_samples_[0],parameters,*traj_ownship_,traj_tstep_,false,traj_maxk_);
+    kinematic_trajectory_samples(traj_samples_[1],parameters,*traj_ownship_,traj_tstep_,true,traj_maxk_);
+  }
+}
+
+/**
+ * Set memo of conflict probes used by CD_future_traj and LOS_at. A NULL memo means that probes are not memoized.
+ */
+void DaidalusIntegerBands::set_conflict_probe_memo(ConflictProbeMemo* memo) {
+  probe_memo_ = memo;
+}
+
+/**
+ * Compute in green[k], for 0 <= k <= max, the value of status.green(k). When the search stride is greater than 1,
+ * a stride is skipped when status.steady_steps shows that the status doesn't change within it. Otherwise, every
+ * step of the stride is checked. When NDEBUG is not defined, the result is asserted to be the same as the one
+ * of the exhaustive search.
+ */
+void DaidalusIntegerBands::search_green_steps(std::vector<bool>& green, const StepStatus& status, int max) const {
+  green.assign(max < 0 ? 0 : max+1,false);
+  if (search_stride_ <= 1 || max < 2) {
+    for (int k = 0; k <= max; ++k) {
+      green[k] = status.green(k);
+    }
+    return;
+  }
+  int a = 0;
+  green[0] = status.green(0);
+  while (a < max) {
+    int b = Util::min(a+search_stride_,max);
+    if (status.steady_steps(a) >= b-a) {
+      for (int k = a+1; k <= b; ++k) {
+        green[k] = green[a];
+      }
+    } else {
+      for (int k = a+1; k <= b; ++k) {
+        green[k] = status.green(k);
+      }
+    }
+    a = b;
+  }
+#ifndef NDEBUG
+  for (int k = 0; k <= max; ++k) {
+    assert(green[k] == status.green(k));
+  }
+#endif
+}
+
+/**
+ * Returns true if traffic is horizontally out of reach of conflict_det and recovery_det, within lookahead time,
+ * for every trajectory of ownship, whose horizontal speed doesn't exceed the largest of the current ownship horizontal
+ * speed and the maximum horizontal speed, plus wind speed. In this case, no step is in conflict.
+ */
+bool DaidalusIntegerBands::out_of_reach(const Detection3D* conflict_det, const Detection3D* recovery_det,
+    const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic) const {
+  double vo = Util::max(ownship.getAirVelocity().gs(),parameters.getMaxHorizontalSpeed())+ownship.windVector().gs();
+  vo = Util::max(ownship.get_v().gs(),vo);
+  double vh = vo+traffic.get_v().gs();
+  double T = parameters.getLookaheadTime();
+  double distance = ownship.get_s().distanceH(traffic.get_s());
+  return distance > conflict_det->horizontalReachSUM(T,vh,ownship.sum(),traffic.sum()) &&
+      (recovery_det == NULL || distance > recovery_det->horizontalReachSUM(T,vh,ownship.sum(),traffic.sum()));
+}
+
+/**
+ * Same as trajectory, but when the trajectory cache is enabled for ownship, samples at times k*tstep,
+ * where tstep is the time step of the cache, are computed only once.
+ */
+/**
+ * Returns true if the trajectory cache is enabled for ownship, instantaneous, and target_step. In this case, k is set to
+ * the index of the sample at the given time, i.e., time = k*tstep, where tstep is the time step of the cache, or to -1 if
+ * that sample is not cached.
+ */
+bool DaidalusIntegerBands::cached_sample(const TrafficState& ownship, double time, int target_step, bool instantaneous, int& k) const {
+  if (traj_ownship_ == &ownship && instantaneous == traj_instantaneous_ && target_step >= 0) {
+    k = -1;
+    double kd = traj_tstep_ == 0 ? 0 : std::floor(time/traj_tstep_+0.5);
+    // Only samples at exact multiples of the time step are cached
+    if (0 <= kd && kd <= traj_maxk_ && kd*traj_tstep_ == time) {
+      k = static_cast<int>(kd);
+    }
+    return true;
+  }
+  return false;
+}
+
+std::pair<Vect3,Velocity> DaidalusIntegerBands::cached_trajectory(const DaidalusParameters& parameters, const TrafficState& ownship,
+    double time, bool dir, int target_step, bool instantaneous) const {
+  int k;
+  if (cached_sample(ownship,time,target_step,instantaneous,k) && k >= 0) {
+    int idx = 2*target_step+(dir?1:0);
+    if (traj_frozen_) {
+      if (idx < static_cast<int>(traj_samples_.size()) && k < static_cast<int>(traj_samples_[idx].size())) {
+        return traj_samples_[idx][k];
+      }
+      return trajectory(parameters,ownship,time,dir,target_step,instantaneous);
+    }
+    if (idx >= static_cast<int>(traj_samples_.size())) {
+      traj_samples_.resize(idx+1);
+    }
+    std::vector<std::pair<Vect3,Velocity> >& samples = traj_samples_[idx];
+    if (!instantaneous && target_step == 0) {
+      kinematic_trajectory_samples(samples,parameters,ownship,traj_tstep_,dir,k);
+    } else {
+      for (int i = static_cast<int>(samples.size()); i <= k; ++i) {
+        samples.push_back(trajectory(parameters,ownship,i*traj_tstep_,dir,target_step,instantaneous));
+      }
+    }
+    return samples[k];
+  }
+  return trajectory(parameters,ownship,time,dir,target_step,instantaneous);
+}
+
+/**
+ * Returns the memoized probes of traffic with det at the ownship trajectory sample at the given time, or NULL if
+ * probes are not memoized. Probes are only memoized for trajectories of the trajectory cache.
+ */
+ConflictProbeMemo::Probes* DaidalusIntegerBands::memoized_probes(const Detection3D* det, const TrafficState& ownship,
+    const TrafficState& traffic, double time, bool dir, int target_step, bool instantaneous) const {
+  int k;
+  if (probe_memo_ != NULL && cached_sample(ownship,time,target_step,instantaneous,k)) {
+    return probe_memo_->probes(traffic,det,2*target_step+(dir?1:0),k,time);
+  }
+  return NULL;
+}
+
+/**
+ * By default, critical steps are not available
+ */
+bool DaidalusIntegerBands::instantaneous_critical_steps(std::vector<double>& ks, const DaidalusParameters& parameters,
+    const TrafficState& ownship, const TrafficState& traffic, bool dir,
+    double D, double H, double B, double T, double TH, double TV, bool exact) const {
+  return false;
+}
+
 /**
  * In PVS: int_bands@CD_future_traj
  */
@@ -21,14 +246,26 @@ bool DaidalusIntegerBands::CD_future_traj(const Detection3D* det, double B, doub
     const DaidalusParameters& parameters,  const TrafficState& ownship, const TrafficState& traffic, int target_step, bool instantaneous) const {
   T = Util::min(parameters.getLookaheadTime(),T);
   if (tsk > T || B > T) return false;
-  std::pair<Vect3,Velocity> sovot = trajectory(parameters,ownship,tsk,trajdir,target_step,instantaneous);
+  double Bt = Util::max(B,tsk);
+  ConflictProbeMemo::Probes* probes = memoized_probes(det,ownship,traffic,tsk,trajdir,target_step,instantaneous);
+  bool conflict;
+  if (probes != NULL && probes->lookup(conflict,Bt,T)) {
+    return conflict;
+  }
+  std::pair<Vect3,Velocity> sovot = cached_trajectory(parameters,ownship,tsk,trajdir,target_step,instantaneous);
   Vect3 sot = sovot.first;
   Velocity vot = sovot.second;
   Vect3 sat = tsk == 0.0 ? sot : vot.ScalAdd(-tsk,sot);
-  TrafficState own = ownship;
-  own.setPosition(Position(sat));
-  own.setAirVelocity(vot);
-  return det->conflictWithTrafficState(own,traffic,Util::max(B,tsk),T);
+  // When det has a loss interval, it's computed once per sample and answers the probes of every pivot
+  if (probes != NULL && probes->store_profile(det,sat,vot,traffic.get_s(),traffic.get_v(),ownship.sum(),traffic.sum()) &&
+      probes->lookup(conflict,Bt,T)) {
+    return conflict;
+  }
+  conflict = det->conflictSUM(sat,vot,traffic.get_s(),traffic.get_v(),Bt,T,ownship.sum(),traffic.sum());
+  if (probes != NULL) {
+    probes->store(conflict,Bt,T);
+  }
+  return conflict;
 }
 
 /**
@@ -53,14 +290,24 @@ bool DaidalusIntegerBands::LOS_at(const Detection3D* det, bool trajdir, double t
   if (tsk >= parameters.getLookaheadTime()) {
       return false;
   }
-  std::pair<Vect3,Velocity> sovot = trajectory(parameters,ownship,tsk,trajdir,target_step,instantaneous);
+  ConflictProbeMemo::Probes* probes = memoized_probes(det,ownship,traffic,tsk,trajdir,target_step,instantaneous);
+  bool los;
+  if (probes != NULL && probes->lookup_los(los,tsk)) {
+    return los;
+  }
+  std::pair<Vect3,Velocity> sovot = cached_trajectory(parameters,ownship,tsk,trajdir,target_step,instantaneous);
   Vect3 sot = sovot.first;
   Velocity vot = sovot.second;
   Vect3 sat = vot.ScalAdd(-tsk,sot);
-  TrafficState own = ownship;
-  own.setPosition(Position(sat));
-  own.setAirVelocity(vot);
-  return det->violationAtWithTrafficState(own,traffic,tsk);
+  if (probes != NULL && probes->store_profile(det,sat,vot,traffic.get_s(),traffic.get_v(),ownship.sum(),traffic.sum()) &&
+      probes->lookup_los(los,tsk)) {
+    return los;
+  }
+  los = det->violationAtSUM(sat,vot,traffic.get_s(),traffic.get_v(),tsk,ownship.sum(),traffic.sum());
+  if (probes != NULL) {
+    probes->store_los(los);
+  }
+  return los;
 }
 
 // In PVS: int_bands@first_los_step
@@ -110,18 +357,116 @@ int DaidalusIntegerBands::kinematic_bands_search_index(const Detection3D* confli
 
 // In PVS: int_bands@traj_conflict_only_band, int_bands@nat_bands, and int_bands@nat_bands_rec
 
+/**
+ * Status of step k of a kinematic trajectory with respect to conflicts only
+ */
+class KinematicConflictOnlyStatus : public DaidalusIntegerBands::StepStatus {
+public:
+  const DaidalusIntegerBands& bands;
+  const Detection3D* conflict_det;
+  const Detection3D* recovery_det;
+  double tstep;
+  double B;
+  double T;
+  bool trajdir;
+  const DaidalusParameters& parameters;
+  const TrafficState& ownship;
+  const TrafficState& traffic;
+
+  bool unreachable; // True if no step is in conflict
+
+  KinematicConflictOnlyStatus(const DaidalusIntegerBands& b, const Detection3D* cd, const Detection3D* rd,
+      double ts, double B0, double T0, bool dir, const DaidalusParameters& p, const TrafficState& own, const TrafficState& ac,
+      bool u) :
+        bands(b), conflict_det(cd), recovery_det(rd), tstep(ts), B(B0), T(T0), trajdir(dir),
+        parameters(p), ownship(own), traffic(ac), unreachable(u) {}
+
+  bool green(int k) const {
+    double tsk = tstep*k;
+    return bands.no_CD_future_traj(conflict_det,recovery_det,B,T+tsk,trajdir,tsk,parameters,ownship,traffic,0,false);
+  }
+
+  // Every step has the same status when traffic is out of reach
+  int steady_steps(int k) const {
+    return unreachable ? INT_MAX : 0;
+  }
+};
+
+/**
+ * Compute in conflict[i] the value of CD_future_traj(det,B,T+(relative?tsk:0),trajdir,tsk,...,0,false), where
+ * tsk = tstep*steps[i]. Probes are evaluated by det as a single batch.
+ */
+void DaidalusIntegerBands::kinematic_CD_future_traj_batch(std::vector<bool>& conflict, const std::vector<int>& steps,
+    const Detection3D* det, double tstep, double B, double T, bool relative, bool trajdir,
+    const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic) const {
+  conflict.assign(steps.size(),false);
+  // Concurrent jobs use their own buffers
+  DetectionBatch job_batch;
+  std::vector<int> job_index;
+  std::vector<bool> job_conflict;
+  DetectionBatch& batch = traj_frozen_ ? job_batch : batch_;
+  std::vector<int>& index = traj_frozen_ ? job_index : batch_index_; // Index in steps of every element of the batch
+  std::vector<bool>& batch_conflict = traj_frozen_ ? job_conflict : batch_conflict_;
+  batch.clear();
+  index.clear();
+  for (int i = 0; i < static_cast<int>(steps.size()); ++i) {
+    double tsk = tstep*steps[i];
+    // Same as CD_future_traj
+    double Tk = Util::min(parameters.getLookaheadTime(),relative ? T+tsk : T);
+    if (tsk > Tk || B > Tk) continue;
+    std::pair<Vect3,Velocity> sovot = cached_trajectory(parameters,ownship,tsk,trajdir,0,false);
+    Vect3 sot = sovot.first;
+    Velocity vot = sovot.second;
+    Vect3 sat = tsk == 0.0 ? sot : vot.ScalAdd(-tsk,sot);
+    batch.add(sat,vot,Util::max(B,tsk),Tk);
+    index.push_back(i);
+  }
+  det->conflictBatchSUM(batch_conflict,batch,traffic.get_s(),traffic.get_v(),ownship.sum(),traffic.sum());
+  for (int j = 0; j < batch.size(); ++j) {
+    conflict[index[j]] = batch_conflict[j];
+  }
+}
+
 void DaidalusIntegerBands::kinematic_traj_conflict_only_bands(std::vector<Integerval>& l,
     const Detection3D* conflict_det, const Detection3D* recovery_det, double tstep, double B, double T,
     bool trajdir, int max,const DaidalusParameters& parameters,  const TrafficState& ownship, const TrafficState& traffic) const {
+  std::vector<bool> green;
+  if (search_stride_ <= 1 && probe_memo_ == NULL) {
+    // Exhaustive search: all steps are probed as a batch. Recovery detector only probes steps that are still green.
+    std::vector<int> steps;
+    for (int k = 0; k <= max; ++k) {
+      steps.push_back(k);
+    }
+    std::vector<bool> conflict;
+    kinematic_CD_future_traj_batch(conflict,steps,conflict_det,tstep,B,T,true,trajdir,parameters,ownship,traffic);
+    green.assign(max+1,false);
+    std::vector<int> green_steps;
+    for (int k = 0; k <= max; ++k) {
+      if (!conflict[k]) {
+        green[k] = true;
+        green_steps.push_back(k);
+      }
+    }
+    if (recovery_det != NULL && !green_steps.empty()) {
+      kinematic_CD_future_traj_batch(conflict,green_steps,recovery_det,tstep,0,B,false,trajdir,parameters,ownship,traffic);
+      for (int i = 0; i < static_cast<int>(green_steps.size()); ++i) {
+        if (conflict[i]) {
+          green[green_steps[i]] = false;
+        }
+      }
+    }
+  } else {
+    search_green_steps(green,KinematicConflictOnlyStatus(*this,conflict_det,recovery_det,tstep,B,T,trajdir,
+        parameters,ownship,traffic,search_stride_ > 1 && out_of_reach(conflict_det,recovery_det,parameters,ownship,traffic)),max);
+  }
   int d = -1; // Set to the first index with no conflict
   for (int k = 0; k <= max; ++k) {
-    double tsk = tstep*k;
-    if (d >=0 && no_CD_future_traj(conflict_det,recovery_det,B,T+tsk,trajdir,tsk,parameters,ownship,traffic,0,false)) {
+    if (d >=0 && green[k]) {
       continue;
     } else if (d >=0) {
       l.push_back( Integerval(d,k-1));
       d = -1;
-    } else if (no_CD_future_traj(conflict_det,recovery_det,B,T+tsk,trajdir,tsk,parameters,ownship,traffic,0,false)) {
+    } else if (green[k]) {
       d = k;
     }
   }
@@ -165,8 +510,8 @@ int DaidalusIntegerBands::first_kinematic_green(const Detection3D* conflict_det,
 }
 
 Vect3 DaidalusIntegerBands::kinematic_linvel(const DaidalusParameters& parameters, const TrafficState& ownship, double tstep, bool trajdir, int k) const {
-  Vect3 s1 = trajectory(parameters,ownship,(k+1)*tstep,trajdir,0,false).first;
-  Vect3 s0 = trajectory(parameters,ownship,k*tstep,trajdir,0,false).first;
+  Vect3 s1 = cached_trajectory(parameters,ownship,(k+1)*tstep,trajdir,0,false).first;
+  Vect3 s0 = cached_trajectory(parameters,ownship,k*tstep,trajdir,0,false).first;
   return s1.Sub(s0).Scal(1/tstep);
 }
 
@@ -176,7 +521,7 @@ bool DaidalusIntegerBands::kinematic_repulsive_at(double tstep, bool trajdir, in
   if (k==0) {
     return true;
   }
-  std::pair<Vect3,Velocity> sovo = trajectory(parameters,ownship,0,trajdir,0,false);
+  std::pair<Vect3,Velocity> sovo = cached_trajectory(parameters,ownship,0,trajdir,0,false);
   Vect2 so = sovo.first.vect2();
   Vect2 vo = sovo.second.vect2();
   Vect2 si = traffic.get_s().vect2();
@@ -186,7 +531,7 @@ bool DaidalusIntegerBands::kinematic_repulsive_at(double tstep, bool trajdir, in
     rep = CriteriaCore::horizontal_new_repulsive_criterion(so.Sub(si), vo, vi, kinematic_linvel(parameters,ownship,tstep,trajdir,0).vect2(), epsh);
   }
   if (rep) {
-    std::pair<Vect3,Velocity> sovot = trajectory(parameters,ownship,k*tstep,trajdir,0,false);
+    std::pair<Vect3,Velocity> sovot = cached_trajectory(parameters,ownship,k*tstep,trajdir,0,false);
     Vect2 sot = sovot.first.vect2();
     Vect2 vot = sovot.second.vect2();
     Vect2 sit = vi.ScalAdd(k*tstep,si);
@@ -216,7 +561,7 @@ bool DaidalusIntegerBands::kinematic_vert_repul_at(double tstep, bool trajdir, i
   if (k==0) {
     return true;
   }
-  std::pair<Vect3,Velocity> sovo = trajectory(parameters,ownship,0,trajdir,0,false);
+  std::pair<Vect3,Velocity> sovo = cached_trajectory(parameters,ownship,0,trajdir,0,false);
   Vect3 so = sovo.first;
   Vect3 vo = sovo.second;
   Vect3 si = traffic.get_s();
@@ -226,7 +571,7 @@ bool DaidalusIntegerBands::kinematic_vert_repul_at(double tstep, bool trajdir, i
     rep = CriteriaCore::vertical_new_repulsive_criterion(so.Sub(si),vo,vi,kinematic_linvel(parameters,ownship,tstep,trajdir,0),epsv);
   }
   if (rep) {
-    std::pair<Vect3,Velocity> sovot = trajectory(parameters,ownship,k*tstep,trajdir,0,false);
+    std::pair<Vect3,Velocity> sovot = cached_trajectory(parameters,ownship,k*tstep,trajdir,0,false);
     Vect3 sot = sovot.first;
     Vect3 vot = sovot.second;
     Vect3 sit = vi.ScalAdd(k*tstep,si);
@@ -287,13 +632,11 @@ int DaidalusIntegerBands::first_instantaneous_green(const Detection3D* conflict_
   return -1;
 }
 
-//In PVS: inst_bands@conflict_free_track_step, inst_bands@conflict_free_gs_step, inst_bands@conflict_free_vs_step
-bool DaidalusIntegerBands::no_instantaneous_conflict(const Detection3D* conflict_det, const Detection3D* recovery_det, double B, double T,
-    bool trajdir,const DaidalusParameters& parameters,  const TrafficState& ownship, const TrafficState& traffic,
-    int epsh, int epsv, int target_step) const {
+bool DaidalusIntegerBands::instantaneous_repulsive_at(bool trajdir, const DaidalusParameters& parameters,
+    const TrafficState& ownship, const TrafficState& traffic, int epsh, int epsv, int target_step) const {
   bool usehcrit = epsh != 0;
   bool usevcrit = epsv != 0;
-  std::pair<Vect3,Velocity> nsovo = trajectory(parameters,ownship,0,trajdir,target_step,true);
+  std::pair<Vect3,Velocity> nsovo = cached_trajectory(parameters,ownship,0,trajdir,target_step,true);
   Vect3 so = ownship.get_s();
   Velocity vo = ownship.get_v();
   Vect3 si = traffic.get_s();
@@ -302,24 +645,170 @@ bool DaidalusIntegerBands::no_instantaneous_conflict(const Detection3D* conflict
   Vect3 s = so.Sub(si);
   return
       (!usehcrit || CriteriaCore::horizontal_new_repulsive_criterion(s.vect2(),vo.vect2(),vi.vect2(),nvo.vect2(),epsh)) &&
-      (!usevcrit || CriteriaCore::vertical_new_repulsive_criterion(s,vo,vi,nvo,epsv)) &&
+      (!usevcrit || CriteriaCore::vertical_new_repulsive_criterion(s,vo,vi,nvo,epsv));
+}
+
+//In PVS: inst_bands@conflict_free_track_step, inst_bands@conflict_free_gs_step, inst_bands@conflict_free_vs_step
+bool DaidalusIntegerBands::no_instantaneous_conflict(const Detection3D* conflict_det, const Detection3D* recovery_det, double B, double T,
+    bool trajdir,const DaidalusParameters& parameters,  const TrafficState& ownship, const TrafficState& traffic,
+    int epsh, int epsv, int target_step) const {
+  return instantaneous_repulsive_at(trajdir,parameters,ownship,traffic,epsh,epsv,target_step) &&
       no_CD_future_traj(conflict_det,recovery_det,B,T,trajdir,0.0,parameters,ownship,traffic,target_step,true);
 }
 
+/**
+ * Compute in conflict[k], for 0 <= k <= max, the value of CD_future_traj(det,B,T,trajdir,0,...,k,true).
+ * Critical steps of the cylinder of det split [0,max] into runs of steps that are more than one step away from
+ * any critical step. Steps that are not in a run are checked with det. When the cylinder is exact, the conflict
+ * status is constant in a run and det is checked once per run. Otherwise, det is only checked in runs that
+ * may be in conflict with the cylinder. Returns false if det or these bands do not support critical steps.
+ */
+bool DaidalusIntegerBands::instantaneous_conflict_steps(std::vector<bool>& conflict, const Detection3D* det, double B, double T,
+    bool trajdir, int max, const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& traffic) const {
+  double D, H, TH, TV;
+  bool exact;
+  if (max < 0 || det == NULL || !det->criticalCylinder(D,H,TH,TV,exact)) {
+    return false;
+  }
+  double Tl = Util::min(parameters.getLookaheadTime(),T);
+  conflict.assign(max+1,false);
+  if (0 > Tl || B > Tl) {
+    // There are no conflicts for any step
+    return true;
+  }
+  if (Util::almost_equals(B,Tl)) {
+    // Violation at time B is checked by stepping
+    return false;
+  }
+  if (exact) {
+    TH = Tl;
+    TV = Tl;
+  } else {
+    // The bounding cylinder is enlarged to absorb numerical tolerances of the detector
+    D *= 1.01;
+    H *= 1.01;
+    TH = Tl+TH+1;
+    TV = Tl+TV+1;
+  }
+  std::vector<double> ks;
+  if (!instantaneous_critical_steps(ks,parameters,ownship,traffic,trajdir,D,H,B,Tl,TH,TV,exact)) {
+    return false;
+  }
+  std::vector<bool> check(max+1,false);
+  check[0] = true;
+  check[max] = true;
+  for (std::vector<double>::const_iterator c_ptr = ks.begin(); c_ptr != ks.end(); ++c_ptr) {
+    if (!ISFINITE(*c_ptr)) {
+      return false;
+    }
+    if (*c_ptr >= -1 && *c_ptr <= max+1) {
+      int lo = Util::max(0,static_cast<int>(std::floor(*c_ptr))-1);
+      int hi = Util::min(max,static_cast<int>(std::ceil(*c_ptr))+1);
+      for (int k = lo; k <= hi; ++k) {
+        check[k] = true;
+      }
+    }
+  }
+  Vect3 s = ownship.get_s().Sub(traffic.get_s());
+  const Velocity& vi = traffic.get_v();
+  int k = 0;
+  while (k <= max) {
+    if (check[k]) {
+      conflict[k] = CD_future_traj(det,B,T,trajdir,0.0,parameters,ownship,traffic,k,true);
+      ++k;
+      continue;
+    }
+    int end = k;
+    while (end < max && !check[end+1]) {
+      ++end;
+    }
+    int mid = (k+end)/2;
+    if (exact) {
+      bool mid_conflict = CD_future_traj(det,B,T,trajdir,0.0,parameters,ownship,traffic,mid,true);
+      for (int j = k; j <= end; ++j) {
+        conflict[j] = mid_conflict;
+      }
+    } else {
+      Velocity nvo = cached_trajectory(parameters,ownship,0,trajdir,mid,true).second;
+      bool hor = !ISFINITE(D) || CD2D::cd2d(s.vect2(),nvo.vect2(),vi.vect2(),D,B,TH);
+      if (hor && CD3D::cd3d(Vect3(0,0,s.z),Vect3(0,0,nvo.z),Vect3(0,0,vi.z),1,H,B,TV)) {
+        for (int j = k; j <= end; ++j) {
+          conflict[j] = CD_future_traj(det,B,T,trajdir,0.0,parameters,ownship,traffic,j,true);
+        }
+      }
+    }
+    k = end+1;
+  }
+  return true;
+}
+
+/**
+ * Status of instantaneous step k
+ */
+class InstantaneousStatus : public DaidalusIntegerBands::StepStatus {
+public:
+  const DaidalusIntegerBands& bands;
+  const Detection3D* conflict_det;
+  const Detection3D* recovery_det;
+  double B;
+  double T;
+  bool trajdir;
+  const DaidalusParameters& parameters;
+  const TrafficState& ownship;
+  const TrafficState& traffic;
+  int epsh;
+  int epsv;
+
+  InstantaneousStatus(const DaidalusIntegerBands& b, const Detection3D* cd, const Detection3D* rd,
+      double B0, double T0, bool dir, const DaidalusParameters& p, const TrafficState& own, const TrafficState& ac,
+      int eh, int ev) :
+        bands(b), conflict_det(cd), recovery_det(rd), B(B0), T(T0), trajdir(dir),
+        parameters(p), ownship(own), traffic(ac), epsh(eh), epsv(ev) {}
+
+  bool green(int k) const {
+    return bands.no_instantaneous_conflict(conflict_det,recovery_det,B,T,trajdir,parameters,ownship,traffic,epsh,epsv,k);
+  }
+};
+
+/**
+ * Compute in green[k], for 0 <= k <= max, the value of no_instantaneous_conflict(...,k). Conflicts are
+ * computed from critical steps when the detectors support them. Otherwise, steps are searched.
+ */
+void DaidalusIntegerBands::instantaneous_green_steps(std::vector<bool>& green,
+    const Detection3D* conflict_det, const Detection3D* recovery_det, double B, double T,
+    bool trajdir, int max,const DaidalusParameters& parameters,  const TrafficState& ownship, const TrafficState& traffic,
+    int epsh, int epsv) const {
+  green.assign(max < 0 ? 0 : max+1,false);
+  std::vector<bool> conflict;
+  std::vector<bool> recovery;
+  if (instantaneous_conflict_steps(conflict,conflict_det,B,T,trajdir,max,parameters,ownship,traffic) &&
+      (recovery_det == NULL || instantaneous_conflict_steps(recovery,recovery_det,0,B,trajdir,max,parameters,ownship,traffic))) {
+    for (int k = 0; k <= max; ++k) {
+      green[k] = !conflict[k] && !(recovery_det != NULL && recovery[k]) &&
+          instantaneous_repulsive_at(trajdir,parameters,ownship,traffic,epsh,epsv,k);
+    }
+  } else {
+    search_green_steps(green,InstantaneousStatus(*this,conflict_det,recovery_det,B,T,trajdir,
+        parameters,ownship,traffic,epsh,epsv),max);
+  }
+}
+
 //In PVS: int_bands@nat_bands, int_bands@nat_bands_rec
 void DaidalusIntegerBands::instantaneous_bands(std::vector<Integerval>& l,
     const Detection3D* conflict_det, const Detection3D* recovery_det, double B, double T,
     bool trajdir, int max,const DaidalusParameters& parameters,  const TrafficState& ownship, const TrafficState& traffic,
     int epsh, int epsv) const {
+  std::vector<bool> green;
+  instantaneous_green_steps(green,conflict_det,recovery_det,B,T,trajdir,max,parameters,ownship,traffic,epsh,epsv);
   int d = -1; // Set to the first index with no conflict
   for (int k = 0; k <= max; ++k) {
-    if (d >=0 && no_instantaneous_conflict(conflict_det,recovery_det,B,T,trajdir,parameters,ownship,traffic,epsh,epsv,k)) {
+    if (d >=0 && green[k]) {
       continue;
     } else if (d >=0) {
       Integerval iv = Integerval(d,k-1);
       l.push_back(iv);
       d = -1;
-    } else if (no_instantaneous_conflict(conflict_det,recovery_det,B,T,trajdir,parameters,ownship,traffic,epsh,epsv,k)) {
+    } else if (green[k]) {
       d = k;
     }
   }
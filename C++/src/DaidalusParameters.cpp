@@ -198,6 +198,7 @@ DaidalusParameters::DaidalusParameters() : error("DaidalusParameters") {
   dta_height_ = 0.0;
   units_["dta_height"] = "ft";
   dta_alerter_  = 0;
+  updateDTAPosition();
 
   // Alerting logic
   ownship_centric_alerting_ = true;
@@ -207,27 +208,30 @@ DaidalusParameters::DaidalusParameters() : error("DaidalusParameters") {
   init();
 }
 
-const DaidalusParameters::aliasestype& DaidalusParameters::getAliases() {
-  static aliasestype aliases_;
-  if (aliases_.empty()) {
-    // Aliases of parameters (for compatibility between different versions of DAIDALUS)
-    aliases_["left_hdir"].push_back("left_trk");
-    aliases_["right_hdir"].push_back("right_trk");
-    aliases_["min_hs"].push_back("min_gs");
-    aliases_["max_hs"].push_back("max_gs");
-    aliases_["step_hdir"].push_back("trk_step");
-    aliases_["step_hs"].push_back("gs_step");
-    aliases_["step_vs"].push_back("vs_step");
-    aliases_["step_alt"].push_back("alt_step");
-    aliases_["recovery_hdir"].push_back("recovery_trk");
-    aliases_["recovery_hs"].push_back("recovery_gs");
-    aliases_["hysteresis_time"].push_back("resolution_hysteresis_time");
-    aliases_["persistence_preferred_hdir"].push_back("max_delta_resolution_hdir");
-    aliases_["persistence_preferred_hs"].push_back("max_delta_resolution_hs");
-    aliases_["persistence_preferred_vs"].push_back("max_delta_resolution_vs");
-    aliases_["persistence_preferred_alt"].push_back("max_delta_resolution_alt");
+// Aliases of parameters (for compatibility between different versions of DAIDALUS)
+static DaidalusParameters::aliasestype makeAliases() {
+  DaidalusParameters::aliasestype aliases;
+  aliases["left_hdir"].push_back("left_trk");
+  aliases["right_hdir"].push_back("right_trk");
+  aliases["min_hs"].push_back("min_gs");
+  aliases["max_hs"].push_back("max_gs");
+  aliases["step_hdir"].push_back("trk_step");
+  aliases["step_hs"].push_back("gs_step");
+  aliases["step_vs"].push_back("vs_step");
+  aliases["step_alt"].push_back("alt_step");
+  aliases["recovery_hdir"].push_back("recovery_trk");
+  aliases["recovery_hs"].push_back("recovery_gs");
+  aliases["hysteresis_time"].push_back("resolution_hysteresis_time");
+  aliases["persistence_preferred_hdir"].push_back("max_delta_resolution_hdir");
+  aliases["persistence_preferred_hs"].push_back("max_delta_resolution_hs");
+  aliases["persistence_preferred_vs"].push_back("max_delta_resolution_vs");
+  aliases["persistence_preferred_alt"].push_back("max_delta_resolution_alt");
+  return aliases;
+}
 
-  }
+const DaidalusParameters::aliasestype& DaidalusParameters::getAliases() {
+  // Initialization of static locals is thread-safe
+  static const aliasestype aliases_ = makeAliases();
   return aliases_;
 }
 
@@ -1654,24 +1658,23 @@ void DaidalusParameters::setDTALogic(int dta_logic) {
  * Get DAA Terminal Area (DTA) position (lat/lon)
  */
 const Position& DaidalusParameters::getDTAPosition() const {
-  static Position dta_position;
-  if (dta_latitude_ != dta_position.lat() ||
-      dta_longitude_ != dta_position.lon()) {
-    std::string ulat = getUnitsOf("dta_latitude");
-    std::string ulon = getUnitsOf("dta_longitude");
-    if (Units::isCompatible(ulat,ulon)) {
-      if (Units::isCompatible("m",ulat)) {
-        dta_position = Position::mkXYZ(dta_latitude_,dta_longitude_,0.0);
-      } else if (Units::isCompatible("deg",ulat)) {
-        dta_position = Position::mkLatLonAlt(dta_latitude_,dta_longitude_,0.0);
-      } else {
-        dta_position = Position::INVALID();
-      }
+  return dta_position_;
+}
+
+void DaidalusParameters::updateDTAPosition() {
+  std::string ulat = getUnitsOf("dta_latitude");
+  std::string ulon = getUnitsOf("dta_longitude");
+  if (Units::isCompatible(ulat,ulon)) {
+    if (Units::isCompatible("m",ulat)) {
+      dta_position_ = Position::mkXYZ(dta_latitude_,dta_longitude_,0.0);
+    } else if (Units::isCompatible("deg",ulat)) {
+      dta_position_ = Position::mkLatLonAlt(dta_latitude_,dta_longitude_,0.0);
     } else {
-      dta_position = Position::INVALID();
+      dta_position_ = Position::INVALID();
     }
+  } else {
+    dta_position_ = Position::INVALID();
   }
-  return dta_position;
 }
 
 /**
@@ -1679,15 +1682,15 @@ const Position& DaidalusParameters::getDTAPosition() const {
  */
 void DaidalusParameters::setDTALatitude(double lat) {
   dta_latitude_ = lat;
+  updateDTAPosition();
 }
 
 /**
  * Set DAA Terminal Area (DTA) latitude in given units
  */
 void DaidalusParameters::setDTALatitude(double lat, const std::string& ulat) {
-  setDTALatitude(Units::from(ulat,lat));
   units_["dta_latitude"] =  ulat;
-
+  setDTALatitude(Units::from(ulat,lat));
 }
 
 /**
@@ -1695,14 +1698,15 @@ void DaidalusParameters::setDTALatitude(double lat, const std::string& ulat) {
  */
 void DaidalusParameters::setDTALongitude(double lon) {
   dta_longitude_ = lon;
+  updateDTAPosition();
 }
 
 /**
  * Set DAA Terminal Area (DTA) longitude in given units
  */
 void DaidalusParameters::setDTALongitude(double lon, const std::string& ulon) {
-  setDTALongitude(Units::from(ulon,lon));
   units_["dta_longitude"] = ulon;
+  setDTALongitude(Units::from(ulon,lon));
 }
 
 /**
@@ -2472,13 +2476,13 @@ bool DaidalusParameters::setParameterData(const ParameterData& p) {
     setit = true;
   }
   if (contains(p,"dta_latitude")) {
-    setDTALatitude(getValue(p,"dta_latitude"));
     units_["dta_latitude"] = getUnit(p,"dta_latitude");
+    setDTALatitude(getValue(p,"dta_latitude"));
     setit = true;
   }
   if (contains(p,"dta_longitude")) {
-    setDTALongitude(getValue(p,"dta_longitude"));
     units_["dta_longitude"] = getUnit(p,"dta_longitude");
+    setDTALongitude(getValue(p,"dta_longitude"));
     setit = true;
   }
   if (contains(p,"dta_radius")) {
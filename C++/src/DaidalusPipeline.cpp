@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2015-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+/*
+ * DaidalusPipeline.cpp
+ *
+ */
+
+#include "DaidalusPipeline.h"
+#include <deque>
+#include <utility>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace larcfm {
+
+struct DaidalusPipeline::Impl {
+  DaidalusTimeStepSource* source;
+  size_t capacity;
+  std::deque<DaidalusTimeStep> steps;
+  std::deque<std::pair<std::ostream*,std::string> > outputs;
+  std::mutex mtx;
+  std::condition_variable steps_ready;
+  std::condition_variable steps_space;
+  std::condition_variable outputs_ready;
+  std::condition_variable outputs_space;
+  // No more time steps are read when stop_reading is set, no more outputs are queued when stop_writing is set
+  bool stop_reading;
+  bool reading_done;
+  bool stop_writing;
+  std::thread reader;
+  std::thread writer;
+
+  Impl(DaidalusTimeStepSource* s, size_t c) : source(s), capacity(c),
+      stop_reading(false), reading_done(false), stop_writing(false) {}
+
+  void read() {
+    DaidalusTimeStep step;
+    std::unique_lock<std::mutex> lock(mtx);
+    while (!stop_reading) {
+      lock.unlock();
+      bool ok = source->readTimeStep(step);
+      lock.lock();
+      if (!ok) {
+        break;
+      }
+      while (!stop_reading && steps.size() >= capacity) {
+        steps_space.wait(lock);
+      }
+      if (stop_reading) {
+        break;
+      }
+      steps.push_back(std::move(step));
+      steps_ready.notify_one();
+    }
+    reading_done = true;
+    steps_ready.notify_one();
+  }
+
+  void write() {
+    std::unique_lock<std::mutex> lock(mtx);
+    while (true) {
+      while (!stop_writing && outputs.empty()) {
+        outputs_ready.wait(lock);
+      }
+      if (outputs.empty()) {
+        return;
+      }
+      std::pair<std::ostream*,std::string> output;
+      output.first = outputs.front().first;
+      output.second.swap(outputs.front().second);
+      outputs.pop_front();
+      outputs_space.notify_one();
+      lock.unlock();
+      (*output.first) << output.second;
+      lock.lock();
+    }
+  }
+};
+
+DaidalusPipeline::DaidalusPipeline(int capacity) : impl_(NULL), capacity_(capacity < 1 ? 1 : capacity) {}
+
+DaidalusPipeline::~DaidalusPipeline() {
+  finish();
+}
+
+void DaidalusPipeline::start(DaidalusTimeStepSource& source) {
+  finish();
+  impl_ = new Impl(&source,static_cast<size_t>(capacity_));
+  impl_->reader = std::thread(&Impl::read,impl_);
+  impl_->writer = std::thread(&Impl::write,impl_);
+}
+
+bool DaidalusPipeline::readState(Daidalus& daa) {
+  if (impl_ == NULL) {
+    return false;
+  }
+  DaidalusTimeStep step;
+  {
+    std::unique_lock<std::mutex> lock(impl_->mtx);
+    while (!impl_->reading_done && impl_->steps.empty()) {
+      impl_->steps_ready.wait(lock);
+    }
+    if (impl_->steps.empty()) {
+      return false;
+    }
+    step = std::move(impl_->steps.front());
+    impl_->steps.pop_front();
+    impl_->steps_space.notify_one();
+  }
+  step.readState(daa);
+  return true;
+}
+
+void DaidalusPipeline::write(std::ostream& out, const std::string& str) {
+  if (impl_ == NULL) {
+    out << str;
+    return;
+  }
+  std::unique_lock<std::mutex> lock(impl_->mtx);
+  while (impl_->outputs.size() >= impl_->capacity) {
+    impl_->outputs_space.wait(lock);
+  }
+  impl_->outputs.push_back(std::make_pair(&out,str));
+  impl_->outputs_ready.notify_one();
+}
+
+void DaidalusPipeline::finish() {
+  if (impl_ == NULL) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(impl_->mtx);
+    impl_->stop_reading = true;
+  }
+  impl_->steps_space.notify_one();
+  impl_->reader.join();
+  {
+    std::lock_guard<std::mutex> lock(impl_->mtx);
+    impl_->stop_writing = true;
+  }
+  impl_->outputs_ready.notify_one();
+  impl_->writer.join();
+  delete impl_;
+  impl_ = NULL;
+}
+
+bool DaidalusPipeline::isRunning() const {
+  return impl_ != NULL;
+}
+
+}
@@ -19,6 +19,7 @@
 #include "DaidalusCore.h"
 #include "DaidalusParameters.h"
 #include "RecoveryInformation.h"
+#include "ConflictProbeMemo.h"
 
 #include <cmath>
 #include <vector>
@@ -166,6 +167,44 @@ bool DaidalusRealBands::kinematic_conflict(const DaidalusParameters& parameters,
       any_red(detector,NULL,epsh,epsv,0.0,alerting_time,parameters,ownship,traffic);
 }
 
+/**
+ * Start a sequence of spread conflict checks for ownship, where relative values are at most max_spread.
+ * Ownship trajectory samples are shared by all checks in the sequence.
+ */
+void DaidalusRealBands::begin_spread_conflicts(const DaidalusParameters& parameters, const TrafficState& ownship, double max_spread) {
+  double step = get_step(parameters);
+  bool instantaneous = instantaneous_bands(parameters);
+  if (step <= 0 || !ownship.isValid()) {
+    disable_trajectory_cache();
+  } else if (instantaneous) {
+    enable_trajectory_cache(ownship,0.0,instantaneous,0);
+  } else {
+    double tstep = time_step(parameters,ownship);
+    if (tstep > 0 && ISFINITE(tstep)) {
+      enable_trajectory_cache(ownship,tstep,instantaneous,
+          static_cast<int>(std::ceil(max_spread/step))+1+
+          static_cast<int>(std::ceil(parameters.getLookaheadTime()/tstep)));
+    } else {
+      disable_trajectory_cache();
+    }
+  }
+}
+
+/**
+ * End a sequence of spread conflict checks
+ */
+void DaidalusRealBands::end_spread_conflicts() {
+  disable_trajectory_cache();
+}
+
+bool DaidalusRealBands::spread_conflict(double min_rel, double max_rel, const DaidalusParameters& parameters, const TrafficState& ownship,
+    const TrafficState& traffic, Detection3D* detector, int epsh, int epsv, double alerting_time, int dta_status) {
+  set_min_max_rel(min_rel,max_rel);
+  // Input values depend on relative values, so they are checked again
+  checked_ = -1;
+  return kinematic_conflict(parameters,ownship,traffic,detector,epsh,epsv,alerting_time,dta_status);
+}
+
 int DaidalusRealBands::length(DaidalusCore& core) {
   refresh(core);
   return static_cast<int>(ranges_.size());
@@ -229,6 +268,15 @@ void DaidalusRealBands::stale() {
  */
 void DaidalusRealBands::clear_hysteresis() {
   bands_hysteresis_.reset();
+  reset();
+}
+
+/**
+ * Set cached values to stale conditions and clear cached none sets. This method
+ * is called when parameters change.
+ */
+void DaidalusRealBands::reset() {
+  none_sets_cache_.clear();
   stale();
 }
 
@@ -243,8 +291,30 @@ bool DaidalusRealBands::isFresh() const {
  * Refresh cached values
  */
 void DaidalusRealBands::refresh(DaidalusCore& core) {
+  if (outdated_) {
+    core.refresh();
+    refresh_with(core);
+  }
+}
+
+/**
+ * Requires a fresh core. Refresh cached values, only reading the core. Several bands
+ * objects can be refreshed concurrently with the same fresh core.
+ */
+void DaidalusRealBands::refresh_with(const DaidalusCore& core) {
   if (outdated_) {
     if (set_input(core.parameters,core.ownship,core.DTAStatus())) {
+      none_sets_cache_.begin(core.ownship,min_val_,max_val_,min_relative_,max_relative_,circular_);
+      // Ownship trajectory is the same for all traffic aircraft, conflict regions, and recovery computations
+      bool instantaneous = instantaneous_bands(core.parameters);
+      double tstep = instantaneous ? 0.0 : time_step(core.parameters,core.ownship);
+      if (instantaneous) {
+        enable_trajectory_cache(core.ownship,tstep,instantaneous,0);
+      } else if (tstep > 0 && ISFINITE(tstep)) {
+        enable_trajectory_cache(core.ownship,tstep,instantaneous,
+            Util::max(maxdown(core.parameters,core.ownship),maxup(core.parameters,core.ownship))+1+
+            static_cast<int>(std::ceil(core.parameters.getLookaheadTime()/tstep)));
+      }
       for (int conflict_region=0; conflict_region < BandsRegion::NUMBER_OF_CONFLICT_BANDS; ++conflict_region) {
         acs_bands_[conflict_region] = core.acs_conflict_bands(conflict_region);
         if (core.bands_for(conflict_region)) {
@@ -252,7 +322,11 @@ void DaidalusRealBands::refresh(DaidalusCore& core) {
           acs_bands_[conflict_region].insert(acs_bands_[conflict_region].end(), acs_peripheral_bands_[conflict_region].begin(), acs_peripheral_bands_[conflict_region].end());
         }
       }
+      set_search_stride(core.search_stride());
+      set_anchor_period(core.trajectory_anchor_period());
       compute(core);
+      disable_trajectory_cache();
+      none_sets_cache_.end();
     }
     outdated_ = false;
   }
@@ -270,7 +344,7 @@ void DaidalusRealBands::force_compute(DaidalusCore& core) {
  * Requires 0 <= conflict_region < CONFICT_BANDS and acs_peripheral_bands_ is empty
  * Put in acs_peripheral_bands_ the list of aircraft predicted to have a peripheral band for the given region.
  */
-void DaidalusRealBands::peripheral_aircraft(DaidalusCore& core, int conflict_region) {
+void DaidalusRealBands::peripheral_aircraft(const DaidalusCore& core, int conflict_region) {
   // Iterate on all traffic aircraft
   for (int ac = 0; ac < static_cast<int>(core.traffic.size()); ++ac) {
     const TrafficState& intruder = core.traffic[ac];
@@ -282,9 +356,12 @@ void DaidalusRealBands::peripheral_aircraft(DaidalusCore& core, int conflict_reg
       int alert_level = alerter.alertLevelForRegion(region);
       if (alert_level > 0) {
         Detection3D* detector = alerter.getLevel(alert_level).getCoreDetectionPtr();
+        if (core.out_of_reach(intruder,detector)) {
+          continue;
+        }
         double alerting_time = Util::min(core.parameters.getLookaheadTime(),
             alerter.getLevel(alert_level).getAlertingTime());
-        ConflictData det = detector->conflictDetectionWithTrafficState(core.ownship,intruder,0.0,core.parameters.getLookaheadTime());
+        ConflictData det = core.memoized_conflict_detection(intruder,detector,0.0,core.parameters.getLookaheadTime());
         if (!det.conflictBefore(alerting_time) && kinematic_conflict(core.parameters,core.ownship,intruder,detector,
             core.epsilonH(false,intruder),core.epsilonV(false,intruder),alerting_time,
             core.DTAStatus())) {
@@ -327,7 +404,7 @@ const std::vector<BandsRange>& DaidalusRealBands::ranges(DaidalusCore& core) {
  * Ensure that the intervals are "complete", filling in missing intervals and ensuring the
  * bands end at the proper bounds.
  */
-void DaidalusRealBands::color_values(std::vector<ColorValue>& lcvs, const std::vector<IntervalSet>& none_sets, DaidalusCore& core, bool recovery,
+void DaidalusRealBands::color_values(std::vector<ColorValue>& lcvs, const std::vector<IntervalSet>& none_sets, const DaidalusCore& core, bool recovery,
     int last_region) {
   if (mod_ == 0) {
     ColorValue::init(lcvs,get_min(core.parameters),get_max(core.parameters),min_val_,max_val_,BandsRegion::NONE);
@@ -367,47 +444,137 @@ void DaidalusRealBands::saturateNoneIntervalSet(IntervalSet& noneset) const {
   }
 }
 
+/**
+ * Input of a call to none_bands for one traffic aircraft. If intruder is NULL, the none set
+ * of the aircraft is already known and none_bands is not called.
+ */
+struct NoneBandsJob {
+  const TrafficState* intruder;
+  const Detection3D* conflict_det;
+  const Detection3D* recovery_det;
+  int epsh;
+  int epsv;
+  double B;
+  double T;
+  bool store; // True if the none set is stored in the none sets cache
+};
+
+/**
+ * Task that computes the none sets of a batch of traffic aircraft. Jobs only read the
+ * bands object and the core. Therefore, they can be executed concurrently.
+ */
+class NoneBandsTask : public WorkerTask {
+public:
+  const DaidalusRealBands& bands;
+  const DaidalusCore& core;
+  const std::vector<NoneBandsJob>& jobs;
+  std::vector<IntervalSet>& nonesets;
+
+  NoneBandsTask(const DaidalusRealBands& b, const DaidalusCore& c,
+      const std::vector<NoneBandsJob>& j, std::vector<IntervalSet>& n) :
+        bands(b), core(c), jobs(j), nonesets(n) {}
+
+  void execute(int i) {
+    const NoneBandsJob& job = jobs[i];
+    if (job.intruder != NULL) {
+      bands.none_bands(nonesets[i],job.conflict_det,job.recovery_det,job.epsh,job.epsv,job.B,job.T,
+          core.parameters,core.ownship,*job.intruder);
+    }
+  }
+};
+
 /**
  * Compute none bands for a const std::vector<IndexLevelT>& ilts of IndexLevelT in none_set_region.
  * The none_set_region is initiated as a saturated green band.
  * Uses aircraft detector if parameter detector is none.
  * The epsilon parameters for coordinations are handled according to the recovery_case flag.
+ * When the worker pool of the core is parallel, none sets of traffic aircraft are computed concurrently
+ * in batches. The none sets of a batch are intersected in the order of ilts, so that the result is
+ * the same as in the serial computation.
  */
 void DaidalusRealBands::compute_none_bands(IntervalSet& none_set_region, const std::vector<IndexLevelT>& ilts,
     Detection3D* det, Detection3D* recovery,
-    bool recovery_case, double B, DaidalusCore& core) {
+    bool recovery_case, double B, const DaidalusCore& core) {
   saturateNoneIntervalSet(none_set_region);
-  // Compute bands for given region
-  std::vector<IndexLevelT>::const_iterator ilt_ptr;
-  for (ilt_ptr = ilts.begin(); ilt_ptr != ilts.end(); ++ilt_ptr) {
-    const TrafficState& intruder = core.traffic[ilt_ptr->index];
-    int alerter_idx = core.alerter_index_of(intruder);
-    if (1 <= alerter_idx && alerter_idx <= core.parameters.numberOfAlerters()) {
-      const Alerter& alerter = core.parameters.getAlerterAt(alerter_idx);
-      Detection3D* detector = (det == NULL ? alerter.getLevel(ilt_ptr->level).getCoreDetectionPtr() : det);
-      IntervalSet noneset2 = IntervalSet();
-      double T = ilt_ptr->time_horizon;
-      if (B > T) {
-        // This case corresponds to recovery bands, where B is a recovery time.
-        // If recovery time is greater than lookahead time for aircraft, then only
-        // the internal cylinder is checked until this time.
-        if (recovery != NULL) {
-          none_bands(noneset2,recovery,NULL,
-              core.epsilonH(recovery_case,intruder),core.epsilonV(recovery_case,intruder),0,T,
-              core.parameters,core.ownship,intruder);
-        } else {
-          saturateNoneIntervalSet(noneset2);
+  WorkerPool& pool = core.worker_pool();
+  int batch_size = pool.isParallel() && !pool.isRunning() ? pool.getNumberOfThreads() : 1;
+  // The first batch has only one aircraft, which populates the trajectory cache
+  // that is shared by concurrent jobs
+  int batch = 1;
+  // None sets computed with recovery detectors are not cached since these detectors are local
+  // objects of compute_recovery_bands
+  bool cacheable = det == NULL && recovery == NULL;
+  std::vector<NoneBandsJob> jobs;
+  std::vector<IntervalSet> nonesets;
+  std::vector<IndexLevelT>::const_iterator ilt_ptr = ilts.begin();
+  while (ilt_ptr != ilts.end()) {
+    jobs.clear();
+    int computed = 0;
+    // Compute bands for given region
+    for (; ilt_ptr != ilts.end() && computed < batch; ++ilt_ptr) {
+      const TrafficState& intruder = core.traffic[ilt_ptr->index];
+      int alerter_idx = core.alerter_index_of(intruder);
+      if (1 <= alerter_idx && alerter_idx <= core.parameters.numberOfAlerters()) {
+        if (nonesets.size() <= jobs.size()) {
+          nonesets.push_back(IntervalSet());
         }
-      } else if (B <= T) {
-        none_bands(noneset2,detector,recovery,
-            core.epsilonH(recovery_case,intruder),core.epsilonV(recovery_case,intruder),B,T,
-            core.parameters,core.ownship,intruder);
+        IntervalSet& noneset2 = nonesets[jobs.size()];
+        noneset2.clear();
+        const Alerter& alerter = core.parameters.getAlerterAt(alerter_idx);
+        Detection3D* detector = (det == NULL ? alerter.getLevel(ilt_ptr->level).getCoreDetectionPtr() : det);
+        NoneBandsJob job = {NULL,NULL,NULL,0,0,0.0,0.0,false};
+        double T = ilt_ptr->time_horizon;
+        if (B > T) {
+          // This case corresponds to recovery bands, where B is a recovery time.
+          // If recovery time is greater than lookahead time for aircraft, then only
+          // the internal cylinder is checked until this time.
+          if (recovery != NULL) {
+            NoneBandsJob rjob = {&intruder,recovery,NULL,
+                core.epsilonH(recovery_case,intruder),core.epsilonV(recovery_case,intruder),0,T,false};
+            job = rjob;
+          } else {
+            saturateNoneIntervalSet(noneset2);
+          }
+        } else if (B <= T) {
+          NoneBandsJob cjob = {&intruder,detector,recovery,
+              core.epsilonH(recovery_case,intruder),core.epsilonV(recovery_case,intruder),B,T,cacheable};
+          job = cjob;
+          if (cacheable && none_sets_cache_.lookup(noneset2,intruder,job.conflict_det,job.recovery_det,
+              job.epsh,job.epsv,job.B,job.T)) {
+            job.intruder = NULL;
+            job.store = false;
+          }
+        }
+        if (job.intruder != NULL) {
+          ++computed;
+        }
+        jobs.push_back(job);
+      }
+    }
+    NoneBandsTask task(*this,core,jobs,nonesets);
+    if (computed > 1) {
+      fill_trajectory_cache(core.parameters);
+      freeze_trajectory_cache(true);
+      pool.run(task,static_cast<int>(jobs.size()));
+      freeze_trajectory_cache(false);
+    } else {
+      for (int i=0; i < static_cast<int>(jobs.size()); ++i) {
+        task.execute(i);
+      }
+    }
+    for (int i=0; i < static_cast<int>(jobs.size()); ++i) {
+      if (jobs[i].store) {
+        none_sets_cache_.store(nonesets[i],*jobs[i].intruder,jobs[i].conflict_det,jobs[i].recovery_det,
+            jobs[i].epsh,jobs[i].epsv,jobs[i].B,jobs[i].T);
       }
-      none_set_region.almost_intersect(noneset2,DaidalusParameters::ALMOST_);
+    }
+    for (int i=0; i < static_cast<int>(jobs.size()); ++i) {
+      none_set_region.almost_intersect(nonesets[i],DaidalusParameters::ALMOST_);
       if (none_set_region.isEmpty()) {
-        break; // No need to compute more bands. This region is currently saturated.
+        return; // No need to compute more bands. This region is currently saturated.
       }
     }
+    batch = batch_size;
   }
 }
 
@@ -417,7 +584,7 @@ void DaidalusRealBands::compute_none_bands(IntervalSet& none_set_region, const s
  * Return true if non-saturated recovery bands where computed
  */
 bool DaidalusRealBands::compute_recovery_bands(IntervalSet& none_set_region, const std::vector<IndexLevelT>& ilts,
-    DaidalusCore& core) {
+    const DaidalusCore& core) {
   recovery_time_ = NINFINITY;
   recovery_nfactor_ = 0;
   recovery_horizontal_distance_ = NINFINITY;
@@ -434,12 +601,23 @@ bool DaidalusRealBands::compute_recovery_bands(IntervalSet& none_set_region, con
     cd3d = CDCylinder::mk(core.minHorizontalRecovery(),core.minVerticalRecovery());
     ocd3d = &cd3d;
     double factor = 1-core.parameters.getCollisionAvoidanceBandsFactor();
+    // Conflict probes with the recovery cylinder and with the conflict detectors are memoized per aircraft, so that
+    // each pivot of the search of the recovery time only computes the probes that do not follow from previous ones.
+    // The loss interval of the cylinder is computed once per trajectory step and answers the probes of every pivot.
+    // Since the cylinder is modified at each iteration, the memo is only valid during one iteration.
+    ConflictProbeMemo memo;
     while (cd3d.getHorizontalSeparation()  > core.parameters.getHorizontalNMAC() ||
         cd3d.getVerticalSeparation() > core.parameters.getVerticalNMAC()) {
+      memo.clear();
+      for (std::vector<IndexLevelT>::const_iterator ilt_ptr = ilts.begin(); ilt_ptr != ilts.end(); ++ilt_ptr) {
+        memo.add(core.traffic[ilt_ptr->index]);
+      }
+      set_conflict_probe_memo(&memo);
       compute_none_bands(none_set_region,ilts,ocd3d,NULL,true,0.0,core);
       bool solidred = none_set_region.isEmpty();
       if (solidred && !core.parameters.isEnabledCollisionAvoidanceBands()) {
         // Saturated band and collision avoidance is not enabled. Nothing to do here.
+        set_conflict_probe_memo(NULL);
         return false;
       } else if (!solidred) {
         // Find first green band
@@ -465,6 +643,7 @@ bool DaidalusRealBands::compute_recovery_bands(IntervalSet& none_set_region, con
         }
         compute_none_bands(none_set_region,ilts,NULL,ocd3d,true,
             recovery_time,core);
+        set_conflict_probe_memo(NULL);
         solidred = none_set_region.isEmpty();
         if (!solidred) {
           recovery_time_ = recovery_time;
@@ -476,6 +655,7 @@ bool DaidalusRealBands::compute_recovery_bands(IntervalSet& none_set_region, con
           return false;
         }
       }
+      set_conflict_probe_memo(NULL);
       ++recovery_nfactor_;
       cd3d.setHorizontalSeparation(std::max(core.parameters.getHorizontalNMAC(),cd3d.getHorizontalSeparation()*factor));
       cd3d.setVerticalSeparation(std::max(core.parameters.getVerticalNMAC(),cd3d.getVerticalSeparation()*factor));
@@ -488,7 +668,7 @@ bool DaidalusRealBands::compute_recovery_bands(IntervalSet& none_set_region, con
  * Requires: compute_bands(conflict_region) = true && 0 <= conflict_region < CONFLICT_BANDS
  * Compute bands for one region. Return true iff recovery bands were computed.
  */
-bool DaidalusRealBands::compute_region(std::vector<IntervalSet>& none_sets, int conflict_region, int corrective_region, DaidalusCore& core) {
+bool DaidalusRealBands::compute_region(std::vector<IntervalSet>& none_sets, int conflict_region, int corrective_region, const DaidalusCore& core) {
   if (saturate_corrective_bands(core.parameters,core.DTAStatus()) && conflict_region <= corrective_region) {
     none_sets[conflict_region].clear();
     return false;
@@ -517,7 +697,7 @@ bool DaidalusRealBands::compute_region(std::vector<IntervalSet>& none_sets, int
 /**
  * Compute all bands.
  */
-void DaidalusRealBands::compute(DaidalusCore& core) {
+void DaidalusRealBands::compute(const DaidalusCore& core) {
   recovery_time_ = NaN;
   recovery_horizontal_distance_ = NaN;
   recovery_vertical_distance_ = NaN;
@@ -617,7 +797,7 @@ double DaidalusRealBands::last_time_to_maneuver(DaidalusCore& core, const Traffi
   if (set_input(core.parameters,core.ownship,core.DTAStatus()) && alert_level > 0) {
     const AlertThresholds& alertthr = core.parameters.getAlerterAt(alert_idx).getLevel(alert_level);
     Detection3D* detector = alertthr.getCoreDetectionPtr();
-    ConflictData det = detector->conflictDetectionWithTrafficState(core.ownship,intruder,0.0,core.parameters.getLookaheadTime());
+    ConflictData det = core.memoized_conflict_detection(intruder,detector,0.0,core.parameters.getLookaheadTime());
     if (det.conflict()) {
       double pivot_red = det.getTimeIn();
       if (pivot_red == 0) {
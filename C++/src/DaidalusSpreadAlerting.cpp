@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2015-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+#include "DaidalusSpreadAlerting.h"
+#include "Alerter.h"
+#include "Util.h"
+
+namespace larcfm {
+
+DaidalusSpreadAlerting::DaidalusSpreadAlerting() {}
+
+/**
+ * Start a sequence of checks for ownship. Trajectory samples are shared for the largest
+ * spread of every dimension. Altitude trajectories depend on the spread, since they are
+ * relative to the minimum altitude of the range, so they are not shared.
+ */
+void DaidalusSpreadAlerting::begin(const DaidalusParameters& parameters, const TrafficState& ownship) {
+  double dir_spread = 0;
+  double hs_spread = 0;
+  double vs_spread = 0;
+  for (int alerter_idx=1; alerter_idx <= parameters.numberOfAlerters(); ++alerter_idx) {
+    const Alerter& alerter = parameters.getAlerterAt(alerter_idx);
+    for (int alert_level=1; alert_level <= alerter.mostSevereAlertLevel(); ++alert_level) {
+      const AlertThresholds& athr = alerter.getLevel(alert_level);
+      dir_spread = Util::max(dir_spread,athr.getHorizontalDirectionSpread());
+      hs_spread = Util::max(hs_spread,athr.getHorizontalSpeedSpread());
+      vs_spread = Util::max(vs_spread,athr.getVerticalSpeedSpread());
+    }
+  }
+  if (dir_spread > 0) {
+    dir_band_.begin_spread_conflicts(parameters,ownship,dir_spread);
+  }
+  if (hs_spread > 0) {
+    hs_band_.begin_spread_conflicts(parameters,ownship,hs_spread);
+  }
+  if (vs_spread > 0) {
+    vs_band_.begin_spread_conflicts(parameters,ownship,vs_spread);
+  }
+}
+
+/**
+ * End a sequence of checks
+ */
+void DaidalusSpreadAlerting::end() {
+  dir_band_.end_spread_conflicts();
+  hs_band_.end_spread_conflicts();
+  vs_band_.end_spread_conflicts();
+}
+
+bool DaidalusSpreadAlerting::conflict(const DaidalusParameters& parameters, const TrafficState& ownship, const TrafficState& intruder,
+    const AlertThresholds& athr, Detection3D* detector, int epsh, int epsv, double alerting_time, int dta_status,
+    int turning, int accelerating, int climbing) {
+  if (athr.getHorizontalDirectionSpread() > 0 &&
+      dir_band_.spread_conflict(turning <= 0 ? athr.getHorizontalDirectionSpread() : 0,
+          turning >= 0 ? athr.getHorizontalDirectionSpread() : 0,
+          parameters,ownship,intruder,detector,epsh,epsv,alerting_time,dta_status)) {
+    return true;
+  }
+  if (athr.getHorizontalSpeedSpread() > 0 &&
+      hs_band_.spread_conflict(accelerating <= 0 ? athr.getHorizontalSpeedSpread() : 0,
+          accelerating >= 0 ? athr.getHorizontalSpeedSpread() : 0,
+          parameters,ownship,intruder,detector,epsh,epsv,alerting_time,dta_status)) {
+    return true;
+  }
+  if (athr.getVerticalSpeedSpread() > 0 &&
+      vs_band_.spread_conflict(climbing <= 0 ? athr.getVerticalSpeedSpread() : 0,
+          climbing >= 0 ? athr.getVerticalSpeedSpread() : 0,
+          parameters,ownship,intruder,detector,epsh,epsv,alerting_time,dta_status)) {
+    return true;
+  }
+  if (athr.getAltitudeSpread() > 0 &&
+      alt_band_.spread_conflict(climbing <= 0 ? athr.getAltitudeSpread() : 0,
+          climbing >= 0 ? athr.getAltitudeSpread() : 0,
+          parameters,ownship,intruder,detector,epsh,epsv,alerting_time,dta_status)) {
+    return true;
+  }
+  return false;
+}
+
+}
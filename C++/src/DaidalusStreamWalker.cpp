@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2015-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+/*
+ * DaidalusStreamWalker.cpp
+ *
+ */
+
+#include "DaidalusStreamWalker.h"
+#include "DaidalusFileWalker.h"
+
+namespace larcfm {
+
+DaidalusStreamWalker::DaidalusStreamWalker(const std::string& filename, int window) {
+  sr_.setWindowSize(window);
+  sr_.open(filename);
+  init();
+}
+
+void DaidalusStreamWalker::resetInputFile(const std::string& filename) {
+  sr_.open(filename);
+  init();
+}
+
+void DaidalusStreamWalker::init() {
+  index_ = 0;
+  sr_.readNext();
+}
+
+int DaidalusStreamWalker::getWindowSize() const {
+  return sr_.getWindowSize();
+}
+
+int DaidalusStreamWalker::getIndex() const {
+  return index_;
+}
+
+double DaidalusStreamWalker::getTime() const {
+  return sr_.activeTime();
+}
+
+bool DaidalusStreamWalker::atBeginning() const {
+  return index_ == 0;
+}
+
+bool DaidalusStreamWalker::atEnd() const {
+  return sr_.size() == 0 && sr_.atEnd();
+}
+
+void DaidalusStreamWalker::goNext() {
+  if (!atEnd()) {
+    ++index_;
+    sr_.readNext();
+  }
+}
+
+const SequenceStreamReader& DaidalusStreamWalker::getReader() const {
+  return sr_;
+}
+
+ParameterData DaidalusStreamWalker::extraColumnsToParameters(const StateReader& sr, int ac) {
+  ParameterData pd;
+  std::vector<std::string> columns = sr.getExtraColumnList();
+  std::vector<std::string>::const_iterator col_ptr;
+  for (col_ptr = columns.begin(); col_ptr != columns.end(); ++col_ptr) {
+    if (sr.hasExtraColumnData(ac,*col_ptr)) {
+      std::string units = sr.getExtraColumnUnits(*col_ptr);
+      if (units == "unitless" || units == "unspecified") {
+        pd.set(*col_ptr, sr.getExtraColumnString(ac,*col_ptr));
+      } else {
+        pd.setInternal(*col_ptr, sr.getExtraColumnValue(ac,*col_ptr), units);
+      }
+    }
+  }
+  return pd;
+}
+
+void DaidalusStreamWalker::readState(Daidalus& daa) {
+  double time = getTime();
+  int ac_idx = 0;
+  for (int ac = 0; ac < sr_.size(); ++ac) {
+    // Aircraft in the look-behind window that are not in the current time step are skipped
+    if (sr_.getTime(ac) != time) {
+      continue;
+    }
+    std::string ida = sr_.getName(ac);
+    Position sa = sr_.getPosition(ac);
+    Velocity va = sr_.getVelocity(ac);
+    if (ac_idx == 0) {
+      daa.setOwnshipState(ida,sa,va,time);
+    } else {
+      daa.addTrafficState(ida,sa,va);
+    }
+    DaidalusFileWalker::readExtraColumns(daa,extraColumnsToParameters(sr_,ac),ac_idx);
+    ++ac_idx;
+  }
+  goNext();
+}
+
+bool DaidalusStreamWalker::readTimeStep(DaidalusTimeStep& step) {
+  if (atEnd()) {
+    return false;
+  }
+  double time = getTime();
+  step.clear(time);
+  for (int ac = 0; ac < sr_.size(); ++ac) {
+    // Aircraft in the look-behind window that are not in the current time step are skipped
+    if (sr_.getTime(ac) == time) {
+      step.add(sr_.getName(ac),sr_.getPosition(ac),sr_.getVelocity(ac),extraColumnsToParameters(sr_,ac));
+    }
+  }
+  goNext();
+  return true;
+}
+
+// ErrorReporter Interface Methods
+
+bool DaidalusStreamWalker::hasError() const {
+  return sr_.hasError();
+}
+
+bool DaidalusStreamWalker::hasMessage() const {
+  return sr_.hasMessage();
+}
+
+std::string DaidalusStreamWalker::getMessage() {
+  return sr_.getMessage();
+}
+
+std::string DaidalusStreamWalker::getMessageNoClear() const {
+  return sr_.getMessageNoClear();
+}
+
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2015-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+/*
+ * DaidalusTimeStep.cpp
+ *
+ */
+
+#include "DaidalusTimeStep.h"
+#include "DaidalusFileWalker.h"
+
+namespace larcfm {
+
+DaidalusTimeStep::DaidalusTimeStep() : time_(0.0) {}
+
+void DaidalusTimeStep::clear(double time) {
+  time_ = time;
+  parameters_ = ParameterData();
+  ids_.clear();
+  positions_.clear();
+  velocities_.clear();
+  columns_.clear();
+}
+
+double DaidalusTimeStep::getTime() const {
+  return time_;
+}
+
+void DaidalusTimeStep::setParameters(const ParameterData& parameters) {
+  parameters_ = parameters;
+}
+
+void DaidalusTimeStep::add(const std::string& id, const Position& pos, const Velocity& vel, const ParameterData& columns) {
+  ids_.push_back(id);
+  positions_.push_back(pos);
+  velocities_.push_back(vel);
+  columns_.push_back(columns);
+}
+
+int DaidalusTimeStep::size() const {
+  return static_cast<int>(ids_.size());
+}
+
+void DaidalusTimeStep::readState(Daidalus& daa) const {
+  if (parameters_.size() > 0) {
+    daa.setParameterData(parameters_);
+    daa.reset();
+  }
+  for (int ac = 0; ac < size(); ++ac) {
+    if (ac == 0) {
+      daa.setOwnshipState(ids_[ac],positions_[ac],velocities_[ac],time_);
+    } else {
+      daa.addTrafficState(ids_[ac],positions_[ac],velocities_[ac]);
+    }
+    DaidalusFileWalker::readExtraColumns(daa,columns_[ac],ac);
+  }
+}
+
+}
@@ -14,7 +14,9 @@
 #include "Tuple5.h"
 #include "Kinematics.h"
 #include "ProjectedKinematics.h"
+#include "CriticalVectors.h"
 #include <vector>
+#include <list>
 
 namespace larcfm {
 
@@ -77,6 +79,56 @@ std::pair<Vect3, Velocity> DaidalusVsBands::trajectory(const DaidalusParameters&
   return std::pair<Vect3, Velocity>(ownship.pos_to_s(posvel.first),ownship.vel_to_v(posvel.first,posvel.second));
 }
 
+/**
+ * Vertical speed accelerations only change the vertical component of the trajectory, so samples are computed
+ * directly in the ownship frame.
+ */
+void DaidalusVsBands::kinematic_trajectory_samples(std::vector<std::pair<Vect3,Velocity> >& samples, const DaidalusParameters& parameters,
+    const TrafficState& ownship, double tstep, bool dir, int maxk) const {
+  int i = static_cast<int>(samples.size());
+  if (i > maxk) {
+    return;
+  }
+  if (i == 0) {
+    samples.push_back(std::pair<Vect3, Velocity>(ownship.get_s(),ownship.get_v()));
+    ++i;
+  }
+  double a = (dir?1:-1)*parameters.getVerticalAcceleration();
+  Vect3 so = ownship.positionXYZ().vect3();
+  const Velocity& vo = ownship.velocityXYZ();
+  for (; i <= maxk; ++i) {
+    double t = i*tstep;
+    // Same as ProjectedKinematics::vsAccel
+    samples.push_back(std::pair<Vect3, Velocity>(Kinematics::vsAccelPos(so,vo,t,a),Velocity::mkVxyz(vo.x,vo.y,vo.z+a*t)));
+  }
+}
+
+/**
+ * Critical steps are computed from critical vertical speeds
+ */
+bool DaidalusVsBands::instantaneous_critical_steps(std::vector<double>& ks, const DaidalusParameters& parameters,
+    const TrafficState& ownship, const TrafficState& traffic, bool dir,
+    double D, double H, double B, double T, double TH, double TV, bool exact) const {
+  double step = get_step(parameters);
+  if (step <= 0) {
+    return false;
+  }
+  Vect3 s = ownship.get_s().Sub(traffic.get_s());
+  const Velocity& vo = ownship.get_v();
+  const Velocity& vi = traffic.get_v();
+  std::list<double> vss;
+  if (exact) {
+    vss = CriticalVectors::verticalSpeeds(s,vo,vi,D,H,B,T);
+  } else {
+    vss = CriticalVectors::verticalSpeeds1D(s.z,vi.z,H,B,TV);
+  }
+  double vso = own_val(ownship);
+  for (std::list<double>::const_iterator vs_ptr = vss.begin(); vs_ptr != vss.end(); ++vs_ptr) {
+    ks.push_back((dir?1:-1)*(*vs_ptr-vso)/step);
+  }
+  return true;
+}
+
 double DaidalusVsBands::max_delta_resolution(const DaidalusParameters& parameters) const {
   return parameters.getPersistencePreferredVerticalSpeedResolution();
 }
@@ -7,9 +7,26 @@
 
 #include "Detection3D.h"
 #include "ConflictData.h"
+#include <atomic>
 
 namespace larcfm {
 
+// Serial numbers of instances, which may be created concurrently by different threads
+static std::atomic<unsigned long> serial_count(0);
+
+Detection3D::Detection3D() : serial_number_(serial_count++) {}
+
+Detection3D::Detection3D(const Detection3D& det) : ParameterAcceptor(det), serial_number_(serial_count++) {}
+
+Detection3D& Detection3D::operator=(const Detection3D& det) {
+  serial_number_ = serial_count++;
+  return *this;
+}
+
+unsigned long Detection3D::getSerialNumber() const {
+  return serial_number_;
+}
+
 /**
  * This functional call returns true if there is a violation given the current states.
  * @param so  ownship position
@@ -84,7 +101,153 @@ bool Detection3D::conflictWithTrafficState(const TrafficState& ownship, const Tr
  * @return a ConflictData object detailing the conflict
  */
 ConflictData Detection3D::conflictDetectionWithTrafficState(const TrafficState& ownship, const TrafficState& intruder, double B, double T) const {
-  return conflictDetection(ownship.get_s(),ownship.get_v(),intruder.get_s(),intruder.get_v(),B,T);
+  return conflictDetectionSUM(ownship.get_s(),ownship.get_v(),intruder.get_s(),intruder.get_v(),B,T,ownship.sum(),intruder.sum());
+}
+
+/**
+ * This functional call returns true if there is a violation at time t.
+ * @param so  ownship position
+ * @param vo  ownship velocity
+ * @param si  intruder position
+ * @param vi  intruder velocity
+ * @param t   time in seconds
+ * @param own_sum  ownship's SUM data
+ * @param ac_sum   intruder's SUM data
+ * @return    true if there is a violation at time t
+ */
+bool Detection3D::violationAtSUM(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double t,
+    const SUMData& own_sum, const SUMData& ac_sum) const {
+  return conflictSUM(so,vo,si,vi,t,t,own_sum,ac_sum);
+}
+
+/**
+ * This functional call returns true if there will be a violation between times B and T from now (relative).
+ * @param so  ownship position
+ * @param vo  ownship velocity
+ * @param si  intruder position
+ * @param vi  intruder velocity
+ * @param B   beginning of detection time (>=0)
+ * @param T   end of detection time (if T < 0 then use an "infinite" lookahead time)
+ * @param own_sum  ownship's SUM data
+ * @param ac_sum   intruder's SUM data
+ * @return true if there is a conflict within times B to T
+ */
+bool Detection3D::conflictSUM(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T,
+    const SUMData& own_sum, const SUMData& ac_sum) const {
+  double end;
+  return probeInterval(B,T,end) && probeConflict(conflictIntervalSUM(so,vo,si,vi,B,end,own_sum,ac_sum),B,T);
+}
+
+/**
+ * The conflict status of conflictSUM in [B,T] is decided by the conflict interval in [B,end]. Returns false
+ * if there is no conflict in [B,T] for any detector.
+ */
+bool Detection3D::probeInterval(double B, double T, double& end) {
+  if (Util::almost_equals(B,T)) {
+    end = B+1;
+    return true;
+  }
+  if (B > T) {
+    return false;
+  }
+  end = T;
+  return true;
+}
+
+/**
+ * Conflict status of conflictSUM in [B,T], given the conflict interval in [B,end], where end is set by probeInterval.
+ */
+bool Detection3D::probeConflict(const LossData& interval, double B, double T) {
+  if (Util::almost_equals(B,T)) {
+    return interval.conflict() && Util::almost_equals(interval.getTimeIn(),B);
+  }
+  return interval.conflict();
+}
+
+/**
+ * This functional call returns a ConflictData object detailing the conflict between times B and T from now (relative), if any.
+ * By default, SUM data is ignored.
+ * @param so  ownship position
+ * @param vo  ownship velocity
+ * @param si  intruder position
+ * @param vi  intruder velocity
+ * @param B   beginning of detection time (>=0)
+ * @param T   end of detection time (if T < 0 then use an "infinite" lookahead time)
+ * @param own_sum  ownship's SUM data
+ * @param ac_sum   intruder's SUM data
+ * @return a ConflictData object detailing the conflict
+ */
+ConflictData Detection3D::conflictDetectionSUM(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T,
+    const SUMData& own_sum, const SUMData& ac_sum) const {
+  return conflictDetection(so,vo,si,vi,B,T);
+}
+
+/**
+ * This functional call returns the conflict interval between times B and T from now (relative), if any. This is
+ * the interval of conflictDetectionSUM, but critical time and distance are not computed.
+ * @param so  ownship position
+ * @param vo  ownship velocity
+ * @param si  intruder position
+ * @param vi  intruder velocity
+ * @param B   beginning of detection time (>=0)
+ * @param T   end of detection time (if T < 0 then use an "infinite" lookahead time)
+ * @param own_sum  ownship's SUM data
+ * @param ac_sum   intruder's SUM data
+ * @return a LossData object with the conflict interval
+ */
+LossData Detection3D::conflictIntervalSUM(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T,
+    const SUMData& own_sum, const SUMData& ac_sum) const {
+  return conflictDetectionSUM(so,vo,si,vi,B,T,own_sum,ac_sum);
+}
+
+/**
+ * Computes in conflicts[i], for every element i of batch, the value of
+ * conflictSUM(batch.so(i),batch.vo(i),si,vi,batch.B(i),batch.T(i),own_sum,ac_sum).
+ * @param conflicts output vector, resized to the size of the batch
+ * @param batch  ownship states and detection times
+ * @param si  intruder position
+ * @param vi  intruder velocity
+ * @param own_sum  ownship's SUM data
+ * @param ac_sum   intruder's SUM data
+ */
+void Detection3D::conflictBatchSUM(std::vector<bool>& conflicts, const DetectionBatch& batch, const Vect3& si, const Velocity& vi,
+    const SUMData& own_sum, const SUMData& ac_sum) const {
+  conflicts.resize(batch.size());
+  for (int i = 0; i < batch.size(); ++i) {
+    conflicts[i] = conflictSUM(batch.so(i),batch.vo(i),si,vi,batch.B(i),batch.T(i),own_sum,ac_sum);
+  }
+}
+
+/**
+ * Loss interval, not bounded in time, whose clipping to [B,T] is the conflict interval of conflictIntervalSUM.
+ * By default, conflicts are not characterized by such an interval.
+ */
+bool Detection3D::lossIntervalSUM(LossData& interval, const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi,
+    const SUMData& own_sum, const SUMData& ac_sum) const {
+  return false;
+}
+
+/**
+ * Cylinder that characterizes the conflicts of this detector for the computation of critical vectors.
+ * By default, there is no such cylinder.
+ */
+bool Detection3D::criticalCylinder(double& D, double& H, double& TH, double& TV, bool& exact) const {
+  return false;
+}
+
+/**
+ * Upper bound on the current horizontal distance between two aircraft that may be in conflict at some time
+ * in [0,T], when their relative horizontal speed is at most vh at all times in [0,T]. By default, the bound is
+ * derived from the critical cylinder of this detector, i.e., a conflict in [0,T] implies a horizontal conflict
+ * with the cylinder in [0,T+TH].
+ */
+double Detection3D::horizontalReachSUM(double T, double vh, const SUMData& own_sum, const SUMData& ac_sum) const {
+  double D,H,TH,TV;
+  bool exact;
+  if (criticalCylinder(D,H,TH,TV,exact)) {
+    return D+vh*(T+TH);
+  }
+  return INFINITY;
 }
 
 void Detection3D::add_blob(std::vector<std::vector<Position> >& blobs, std::vector<Position>& vin, std::vector<Position>& vout) {
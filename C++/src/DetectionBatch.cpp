@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2015-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+#include "DetectionBatch.h"
+#include <vector>
+
+namespace larcfm {
+
+/**
+ * Remove all elements. Memory is kept for the next batch.
+ */
+void DetectionBatch::clear() {
+  sx_.clear();
+  sy_.clear();
+  sz_.clear();
+  vx_.clear();
+  vy_.clear();
+  vz_.clear();
+  B_.clear();
+  T_.clear();
+}
+
+/**
+ * Add ownship position so, ownship velocity vo, and detection interval [B,T] to this batch.
+ */
+void DetectionBatch::add(const Vect3& so, const Velocity& vo, double B, double T) {
+  sx_.push_back(so.x);
+  sy_.push_back(so.y);
+  sz_.push_back(so.z);
+  vx_.push_back(vo.x);
+  vy_.push_back(vo.y);
+  vz_.push_back(vo.z);
+  B_.push_back(B);
+  T_.push_back(T);
+}
+
+int DetectionBatch::size() const {
+  return static_cast<int>(B_.size());
+}
+
+Vect3 DetectionBatch::so(int i) const {
+  return Vect3(sx_[i],sy_[i],sz_[i]);
+}
+
+Velocity DetectionBatch::vo(int i) const {
+  return Velocity::mkVxyz(vx_[i],vy_[i],vz_[i]);
+}
+
+double DetectionBatch::B(int i) const {
+  return B_[i];
+}
+
+double DetectionBatch::T(int i) const {
+  return T_[i];
+}
+
+}
@@ -16,32 +16,52 @@
 #include "ErrorLog.h"
 #include <iostream>
 #include <cstdlib>
-#include <cstring>
+#include <algorithm>
 #include <vector>
 
 using namespace std;
 using namespace larcfm;
 
 IntervalSet::IntervalSet() {
+	r = inline_r;
 	length = 0;
+	capacity = inline_capacity;
 }
 
 IntervalSet::IntervalSet(const IntervalSet& l) {
-	length = l.length;
-
-	memcpy(r,l.r,sizeof(Interval)*length);
+	r = inline_r;
+	length = 0;
+	capacity = inline_capacity;
+	assign(l.r,l.length);
 }
 
 IntervalSet::IntervalSet(const std::vector<Interval>& v) {//: error("IntervalSet") {
-	length = static_cast<int>(v.size());
-	memcpy(r,&v[0],sizeof(Interval)*length);
+	r = inline_r;
+	length = 0;
+	capacity = inline_capacity;
+	if (!v.empty()) {
+		assign(&v[0],static_cast<int>(v.size()));
+	}
+}
+
+IntervalSet& IntervalSet::operator=(const IntervalSet& l) {
+	if (&l != this) {
+		assign(l.r,l.length);
+	}
+	return *this;
+}
+
+IntervalSet::~IntervalSet() {
+	if (r != inline_r) {
+		delete[] r;
+	}
 }
 
 std::vector<Interval> IntervalSet::toVector() const {
 	std::vector<Interval> v = std::vector<Interval>();
 	v.reserve(length); // note: reserve() is appropriate because we exclusively use push_back to populate the vector
 	for (int i = 0; i < length; i++) {
-		v.push_back(v[i]);
+		v.push_back(r[i]);
 	}
 	return v;
 }
@@ -128,6 +148,14 @@ void IntervalSet::almost_add(double l, double u) {
 	almost_add(l,u,PRECISION_DEFAULT);
 }
 
+/*
+ * True if interval ii almost overlaps [l,u]
+ */
+static bool almost_overlaps(const Interval& ii, double l, double u, INT64FM maxUlps) {
+	return (Util::almost_leq(ii.low,l,maxUlps) && Util::almost_leq(l,ii.up,maxUlps)) ||
+			(Util::almost_leq(l,ii.low,maxUlps) && Util::almost_leq(ii.low,u,maxUlps));
+}
+
 /**
  * Add the given interval into this set. If this interval overlaps any
  * interval in the set, then the intervals are merged.
@@ -135,27 +163,23 @@ void IntervalSet::almost_add(double l, double u) {
  */
 void IntervalSet::almost_add(double l, double u, INT64FM maxUlps) {
 	if (Util::almost_less(l,u,maxUlps)) {
-		IntervalSet m = IntervalSet(*this);
-		clear();
-		bool go = false;
-		for (int i=0; i < m.size(); ++i) {
-			Interval ii = m.getInterval(i);
-			if (go) {
-				unions(ii);
-			} else if ((Util::almost_leq(ii.low,l,maxUlps) && Util::almost_leq(l,ii.up,maxUlps)) ||
-					(Util::almost_leq(l,ii.low,maxUlps) && Util::almost_leq(ii.low,u,maxUlps))) {
-				l = Util::min(ii.low,l);
-				u = Util::max(ii.up,u);
-			} else if (Util::almost_less(u,ii.low,maxUlps)) {
-				unions(Interval(l,u));
-				unions(ii);
-				go = true;
-			} else {
-				unions(ii);
-			}
+		int i = 0;
+		// Skip intervals that are before [l,u]
+		while (i < length && !almost_overlaps(r[i],l,u,maxUlps) && !Util::almost_less(u,r[i].low,maxUlps)) {
+			++i;
+		}
+		int start = i;
+		// Merge intervals that overlap [l,u]
+		while (i < length && almost_overlaps(r[i],l,u,maxUlps)) {
+			l = Util::min(r[i].low,l);
+			u = Util::max(r[i].up,u);
+			++i;
 		}
-		if (!go) {
-			unions(Interval(l,u));
+		if (i == start) {
+			insert(start,Interval(l,u));
+		} else {
+			r[start] = Interval(l,u);
+			remove(start+1,i-start-1);
 		}
 	}
 }
@@ -173,37 +197,49 @@ void IntervalSet::almost_intersect(const IntervalSet& n) {
  * unmodified. This method uses "almost" inequalities to compute the intersection.
  */
 void IntervalSet::almost_intersect(const IntervalSet& n, INT64FM maxUlps) {
-	IntervalSet m = IntervalSet(*this);
-	clear();
-	if (!m.isEmpty() && !n.isEmpty()) {
-		int i=0;
-		int j=0;
-		while (i < m.size() && j < n.size()) {
-			Interval ii = m.getInterval(i);
-			Interval jj = n.getInterval(j);
-			if (Util::almost_leq(jj.low,ii.low,maxUlps) &&
-					Util::almost_less(ii.low,jj.up,maxUlps)) {
-				if (Util::almost_leq(ii.up,jj.up,maxUlps)) {
-					unions(ii);
-					++i;
-				} else {
-					unions(Interval(ii.low,jj.up));
-					++j;
-				}
-			} else if (Util::almost_leq(ii.low,jj.low,maxUlps) &&
-					Util::almost_less(jj.low,ii.up,maxUlps)) {
-				if (Util::almost_leq(jj.up,ii.up,maxUlps)) {
-					unions(jj);
-					++j;
-				} else {
-					unions(Interval(jj.low,ii.up));
-					++i;
-				}
-			} else if (Util::almost_leq(ii.up,jj.low,maxUlps)){
+	if (isEmpty() || n.isEmpty()) {
+		clear();
+		return;
+	}
+	if (&n == this) {
+		return;
+	}
+	// Result is built in place in a single linear pass over both sets. The intervals of
+	// this set are first moved n.length positions to the right. Every step of the pass
+	// advances the read cursor i or j, and appends at most one interval at the write
+	// cursor length, so that the write cursor stays behind the read cursor i.
+	int off = n.length;
+	int end = off+length;
+	reserve(end);
+	std::copy_backward(r,r+length,r+end);
+	length = 0;
+	int i=off;
+	int j=0;
+	while (i < end && j < n.length) {
+		const Interval& ii = r[i];
+		const Interval& jj = n.r[j];
+		if (Util::almost_leq(jj.low,ii.low,maxUlps) &&
+				Util::almost_less(ii.low,jj.up,maxUlps)) {
+			if (Util::almost_leq(ii.up,jj.up,maxUlps)) {
+				append(ii);
 				++i;
-			} else if (Util::almost_leq(jj.up,ii.low,maxUlps)){
+			} else {
+				append(Interval(ii.low,jj.up));
 				++j;
 			}
+		} else if (Util::almost_leq(ii.low,jj.low,maxUlps) &&
+				Util::almost_less(jj.low,ii.up,maxUlps)) {
+			if (Util::almost_leq(jj.up,ii.up,maxUlps)) {
+				append(jj);
+				++j;
+			} else {
+				append(Interval(jj.low,ii.up));
+				++i;
+			}
+		} else if (Util::almost_leq(ii.up,jj.low,maxUlps)){
+			++i;
+		} else if (Util::almost_leq(jj.up,ii.low,maxUlps)){
+			++j;
 		}
 	}
 }
@@ -291,6 +327,53 @@ void IntervalSet::sweepBreaks(double width) {
 }
 
 
+/*
+ * Ensure that this set can hold n intervals.
+ */
+void IntervalSet::reserve(int n) {
+	if (n > capacity) {
+		int c = Util::max(2*capacity,n);
+		Interval* nr = new Interval[c];
+		std::copy(r,r+length,nr);
+		if (r != inline_r) {
+			delete[] r;
+		}
+		r = nr;
+		capacity = c;
+	}
+}
+
+/*
+ * Replace the contents of this set by the n intervals in v.
+ */
+void IntervalSet::assign(const Interval* v, int n) {
+	length = 0;
+	reserve(n);
+	std::copy(v,v+n,r);
+	length = n;
+}
+
+/*
+ * Union the given interval into this set. This is the same as unions, but
+ * it is done in constant time when rn is not before the last interval of the set.
+ */
+void IntervalSet::append(const Interval& rn) {
+	if (rn.isEmpty()) {
+		return;
+	}
+	if (length == 0 || r[length-1].up < rn.low) {
+		reserve(length+1);
+		r[length] = rn;
+		length++;
+	} else if (r[length-1].low <= rn.low) {
+		if (!(rn.up <= r[length-1].up)) {
+			r[length-1] = Interval(r[length-1].low,rn.up);
+		}
+	} else {
+		unions(rn);
+	}
+}
+
 /* 
  * Insert the given interval at point i.  If the point i is greater than
  * the number of Intervals in the list, then add this interval to the
@@ -309,55 +392,31 @@ void IntervalSet::insert(int i, const Interval& region) {
 		i = length;
 	}
 
-	if (i == length && length < max_intervals) {
-		r[length] = region;
-		length++;
-	} else {
-		length++;
-		int c = length;
-
-		if (length >= max_intervals) {
-			std::cout << "ERROR: IntervalSet is full, fixing this requires a recompile" << endl;
-			exit(1);
-		}
-
-		while (i < c) {
-			r[c] = r[c-1];
-			c--;
-		}
-
-		r[i] = region;
-	}
+	reserve(length+1);
+	std::copy_backward(r+i,r+length,r+length+1);
+	r[i] = region;
+	length++;
 } // insert
 
 /* 
  * Remove Interval i and return it
  */
 void IntervalSet::remove(int i) {
-	if (i < 0 || i >= length ) {
-		return;
-		//return Interval();
-	}
-
-	//	Interval t = r[i];
-
-	while (i + 1 < length) {
-		r[i] = r[i+1];
-		i++;
-	}
-
-	length--;
-
-	//return t;
+	remove(i,1);
 }
 
 /* 
  * Remove the len number of intervals starting at i.
  */
 void IntervalSet::remove(int i, int len) {
-	for( int j = 0; j < len; j++) {
-		remove(i);
+	if (i < 0 || i >= length || len <= 0) {
+		return;
+	}
+	if (len > length-i) {
+		len = length-i;
 	}
+	std::copy(r+i+len,r+length,r+i);
+	length -= len;
 }
 
 /* 
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2015-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+#include "MappedFile.h"
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iterator>
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace larcfm {
+
+MappedFile::MappedFile() : data_(NULL), size_(0), open_(false), mapped_(false) {}
+
+MappedFile::MappedFile(const std::string& filename) : data_(NULL), size_(0), open_(false), mapped_(false) {
+  open(filename);
+}
+
+MappedFile::~MappedFile() {
+  close();
+}
+
+/**
+ * Open file. Any previously opened file is closed.
+ * @return true if the file was successfully opened
+ */
+bool MappedFile::open(const std::string& filename) {
+  close();
+#if !defined(_WIN32)
+  int fd = ::open(filename.c_str(),O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd,&st) != 0 || !S_ISREG(st.st_mode)) {
+    ::close(fd);
+    return false;
+  }
+  if (st.st_size > 0) {
+    void* addr = mmap(NULL,static_cast<std::size_t>(st.st_size),PROT_READ,MAP_PRIVATE,fd,0);
+    if (addr != MAP_FAILED) {
+      madvise(addr,static_cast<std::size_t>(st.st_size),MADV_SEQUENTIAL);
+      data_ = static_cast<const char*>(addr);
+      size_ = static_cast<std::size_t>(st.st_size);
+      mapped_ = true;
+    }
+  }
+  ::close(fd);
+  if (st.st_size > 0 && !mapped_) {
+    return false;
+  }
+#else
+  std::ifstream in(filename.c_str(),std::ios::in | std::ios::binary);
+  if (in.fail()) {
+    return false;
+  }
+  buffer_.assign(std::istreambuf_iterator<char>(in),std::istreambuf_iterator<char>());
+  data_ = buffer_.empty() ? NULL : &buffer_[0];
+  size_ = buffer_.size();
+#endif
+  open_ = true;
+  return true;
+}
+
+void MappedFile::close() {
+#if !defined(_WIN32)
+  if (mapped_) {
+    munmap(const_cast<char*>(data_),size_);
+  }
+#endif
+  buffer_.clear();
+  data_ = NULL;
+  size_ = 0;
+  open_ = false;
+  mapped_ = false;
+}
+
+bool MappedFile::isOpen() const {
+  return open_;
+}
+
+/**
+ * @return pointer to first character of the file
+ */
+const char* MappedFile::begin() const {
+  return data_;
+}
+
+/**
+ * @return pointer past the last character of the file
+ */
+const char* MappedFile::end() const {
+  return data_+size_;
+}
+
+std::size_t MappedFile::size() const {
+  return size_;
+}
+
+}
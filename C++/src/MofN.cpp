@@ -13,7 +13,6 @@
 #include "Util.h"
 #include "format.h"
 
-#include <vector>
 
 namespace larcfm {
 
@@ -22,7 +21,7 @@ namespace larcfm {
  */
 void MofN::setMofN(int m, int n, int val) {
   m_ = m;
-  n_ = n;
+  n_ = n < 0 ? 0 : (n > MAX_N ? MAX_N : n);
   reset(val);
 }
 
@@ -46,16 +45,72 @@ MofN::MofN() {
  * Creates a copy of M of N object
  */
 MofN::MofN(const MofN& mofn) : m_(mofn.m_), n_(mofn.n_), max_(mofn.max_),
-    queue_(mofn.queue_) {}
+    head_(mofn.head_) {
+  for (int k=0;k<n_;++k) {
+    ring_[k] = mofn.ring_[k];
+  }
+  for (int i=0;i<LEVELS;++i) {
+    levels_[i] = mofn.levels_[i];
+  }
+}
+
+/*
+ * Set the k-th value of the ring
+ */
+void MofN::set(int k, int val) {
+  ring_[k] = val;
+  unsigned long long bit = 1ULL << k;
+  for (int i=0;i<LEVELS;++i) {
+    if (i <= val) {
+      levels_[i] |= bit;
+    } else {
+      levels_[i] &= ~bit;
+    }
+  }
+}
+
+/*
+ * Number of values in the ring that are greater than or equal to i, where i >= 0
+ */
+int MofN::count(int i) const {
+  if (i < LEVELS) {
+#ifdef __GNUC__
+    return __builtin_popcountll(levels_[i]);
+#else
+    int c = 0;
+    for (unsigned long long bits = levels_[i]; bits != 0; bits &= bits-1) {
+      ++c;
+    }
+    return c;
+#endif
+  }
+  int c = 0;
+  for (int k=0;k<n_;++k) {
+    if (ring_[k] >= i) {
+      ++c;
+    }
+  }
+  return c;
+}
+
+/*
+ * i-th oldest value in the ring
+ */
+int MofN::at(int i) const {
+  return ring_[(head_+i)%n_];
+}
 
 /*
  * Reset M of N object with a given initial value
  */
 void MofN::reset(int val) {
-  queue_.clear();
   max_ = val;
-  for (int i=0;i<n_;++i) {
-    queue_.push_back(i < m_ ? val : -1);
+  head_ = 0;
+  for (int i=0;i<LEVELS;++i) {
+    levels_[i] = 0;
+  }
+  for (int k=0;k<n_;++k) {
+    set(k,k < m_ ? val : -1);
   }
 }
 
@@ -63,7 +118,7 @@ void MofN::reset(int val) {
  * Returns true if this object is able to perform M of N logic.
  */
 bool MofN::isValid() const {
-  return !queue_.empty() && m_ > 0 && m_ <= n_;
+  return n_ > 0 && m_ > 0 && m_ <= n_;
 }
 
 /*
@@ -79,19 +134,14 @@ int MofN::m_of_n(int value) {
   if (value > max_) {
     max_ = value;
   }
-  queue_.pop_front();
-  queue_.push_back(value);
+  // The oldest value is replaced by the new one
+  set(head_,value);
+  head_ = (head_+1)%n_;
   if (max_ < 0) {
     return max_;
   }
-  std::vector<int> count(max_+1,0);
-  for (std::deque<int>::const_iterator val_ptr = queue_.begin(); val_ptr != queue_.end(); ++val_ptr) {
-    for (int i=*val_ptr;i >= 0;--i) {
-      count[i]++;
-    }
-  }
   for (int i=max_; i >= 0; --i) {
-    if (count[i] >= m_) {
+    if (count(i) >= m_) {
       return i;
     }
   }
@@ -99,17 +149,13 @@ int MofN::m_of_n(int value) {
 }
 
 bool MofN::sameAs(const MofN& mofn) const {
-  if (max_ != mofn.max_  && queue_.size() != mofn.queue_.size()) {
+  if (max_ != mofn.max_  && n_ != mofn.n_) {
       return false;
   }
-  std::deque<int>::const_iterator it1_ptr = queue_.begin();
-  std::deque<int>::const_iterator it2_ptr = mofn.queue_.begin();
-  while (it1_ptr != queue_.end() && it2_ptr != mofn.queue_.end()) {
-      if (*it1_ptr != *it2_ptr) {
+  for (int i=0; i < n_ && i < mofn.n_; ++i) {
+      if (at(i) != mofn.at(i)) {
           return false;
       }
-      ++it1_ptr;
-      ++it2_ptr;
   }
   return true;
 }
@@ -117,13 +163,13 @@ bool MofN::sameAs(const MofN& mofn) const {
 std::string MofN::toString() const {
   std::string s=Fmi(m_)+" of "+Fmi(n_)+": [";
   bool comma = false;
-  for (std::deque<int>::const_iterator val_ptr = queue_.begin(); val_ptr != queue_.end(); ++val_ptr) {
+  for (int i=0;i<n_;++i) {
     if (comma) {
       s+=",";
     } else {
       comma = true;
     }
-    s += Fmi(*val_ptr);
+    s += Fmi(at(i));
   }
   s+="]";
   return s;
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2015-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+#include "NoneSetCache.h"
+#include "SUMData.h"
+#include <map>
+#include <vector>
+#include <string>
+
+namespace larcfm {
+
+NoneSetCache::NoneSetCache() : valid_(false) {}
+
+NoneSetCache::NoneSetCache(const NoneSetCache& cache) : valid_(false) {}
+
+NoneSetCache& NoneSetCache::operator=(const NoneSetCache& cache) {
+  clear();
+  return *this;
+}
+
+void NoneSetCache::set_sum(double sum[4], const SUMData& data) {
+  sum[0] = data.getHorizontalPositionError();
+  sum[1] = data.getVerticalPositionError();
+  sum[2] = data.getHorizontalSpeedError();
+  sum[3] = data.getVerticalSpeedError();
+}
+
+// Values are compared with strict equality
+bool NoneSetCache::equals(const OwnKey& k1, const OwnKey& k2) {
+  for (int i=0; i < 4; ++i) {
+    if (k1.sum[i] != k2.sum[i]) {
+      return false;
+    }
+  }
+  for (int i=0; i < 5; ++i) {
+    if (k1.config[i] != k2.config[i]) {
+      return false;
+    }
+  }
+  return k1.pos == k2.pos && k1.gvel == k2.gvel && k1.avel == k2.avel &&
+      k1.posxyz == k2.posxyz && k1.velxyz == k2.velxyz && k1.s == k2.s && k1.v == k2.v;
+}
+
+// Values are compared with strict equality
+bool NoneSetCache::equals(const Key& k1, const Key& k2) {
+  for (int i=0; i < 4; ++i) {
+    if (k1.sum[i] != k2.sum[i]) {
+      return false;
+    }
+  }
+  return k1.conflict_det == k2.conflict_det && k1.recovery_det == k2.recovery_det &&
+      k1.epsh == k2.epsh && k1.epsv == k2.epsv && k1.B == k2.B && k1.T == k2.T &&
+      k1.pos == k2.pos && k1.avel == k2.avel && k1.s == k2.s && k1.v == k2.v;
+}
+
+unsigned long NoneSetCache::detector_key(const Detection3D* det) {
+  return det == NULL ? 0 : det->getSerialNumber()+1;
+}
+
+void NoneSetCache::set_key(Key& key, const TrafficState& traffic, const Detection3D* conflict_det,
+    const Detection3D* recovery_det, int epsh, int epsv, double B, double T) {
+  key.pos = traffic.getPosition();
+  key.avel = traffic.getAirVelocity();
+  key.s = traffic.get_s();
+  key.v = traffic.get_v();
+  set_sum(key.sum,traffic.sum());
+  key.conflict_det = detector_key(conflict_det);
+  key.recovery_det = detector_key(recovery_det);
+  key.epsh = epsh;
+  key.epsv = epsv;
+  key.B = B;
+  key.T = T;
+}
+
+/**
+ * Remove all entries.
+ */
+void NoneSetCache::clear() {
+  valid_ = false;
+  entries_.clear();
+}
+
+/**
+ * Start a computation of bands for ownship. If ownship state or range are different from the ones
+ * of the previous computation, all entries are removed.
+ */
+void NoneSetCache::begin(const TrafficState& ownship, double min_val, double max_val,
+    double min_relative, double max_relative, bool circular) {
+  OwnKey own;
+  own.pos = ownship.getPosition();
+  own.gvel = ownship.getGroundVelocity();
+  own.avel = ownship.getAirVelocity();
+  own.posxyz = ownship.positionXYZ();
+  own.velxyz = ownship.velocityXYZ();
+  own.s = ownship.get_s();
+  own.v = ownship.get_v();
+  set_sum(own.sum,ownship.sum());
+  own.config[0] = min_val;
+  own.config[1] = max_val;
+  own.config[2] = min_relative;
+  own.config[3] = max_relative;
+  own.config[4] = circular ? 1 : 0;
+  if (!valid_ || !equals(own,own_)) {
+    entries_.clear();
+    own_ = own;
+    valid_ = true;
+  }
+  std::map<std::string,std::vector<Entry> >::iterator ac_ptr;
+  for (ac_ptr = entries_.begin(); ac_ptr != entries_.end(); ++ac_ptr) {
+    std::vector<Entry>::iterator entry_ptr;
+    for (entry_ptr = ac_ptr->second.begin(); entry_ptr != ac_ptr->second.end(); ++entry_ptr) {
+      entry_ptr->used = false;
+    }
+  }
+}
+
+/**
+ * Finish a computation of bands. Entries that were not used since begin are removed.
+ */
+void NoneSetCache::end() {
+  std::map<std::string,std::vector<Entry> >::iterator ac_ptr = entries_.begin();
+  while (ac_ptr != entries_.end()) {
+    std::vector<Entry>& entries = ac_ptr->second;
+    int n = 0;
+    for (int i=0; i < static_cast<int>(entries.size()); ++i) {
+      if (entries[i].used) {
+        if (n != i) {
+          entries[n] = entries[i];
+        }
+        ++n;
+      }
+    }
+    entries.resize(n);
+    if (entries.empty()) {
+      entries_.erase(ac_ptr++);
+    } else {
+      ++ac_ptr;
+    }
+  }
+}
+
+/**
+ * If there is an entry for the given inputs, copy its none set into noneset and return true.
+ * Otherwise, return false.
+ */
+bool NoneSetCache::lookup(IntervalSet& noneset, const TrafficState& traffic, const Detection3D* conflict_det,
+    const Detection3D* recovery_det, int epsh, int epsv, double B, double T) {
+  if (!valid_) {
+    return false;
+  }
+  std::map<std::string,std::vector<Entry> >::iterator ac_ptr = entries_.find(traffic.getId());
+  if (ac_ptr == entries_.end()) {
+    return false;
+  }
+  Key key;
+  set_key(key,traffic,conflict_det,recovery_det,epsh,epsv,B,T);
+  std::vector<Entry>::iterator entry_ptr;
+  for (entry_ptr = ac_ptr->second.begin(); entry_ptr != ac_ptr->second.end(); ++entry_ptr) {
+    if (equals(entry_ptr->key,key)) {
+      entry_ptr->used = true;
+      noneset = entry_ptr->noneset;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Store the none set computed for the given inputs.
+ */
+void NoneSetCache::store(const IntervalSet& noneset, const TrafficState& traffic, const Detection3D* conflict_det,
+    const Detection3D* recovery_det, int epsh, int epsv, double B, double T) {
+  if (!valid_) {
+    return;
+  }
+  Entry entry;
+  set_key(entry.key,traffic,conflict_det,recovery_det,epsh,epsv,B,T);
+  entry.noneset = noneset;
+  entry.used = true;
+  std::vector<Entry>& entries = entries_[traffic.getId()];
+  std::vector<Entry>::iterator entry_ptr;
+  for (entry_ptr = entries.begin(); entry_ptr != entries.end(); ++entry_ptr) {
+    if (equals(entry_ptr->key,entry.key)) {
+      *entry_ptr = entry;
+      return;
+    }
+  }
+  entries.push_back(entry);
+}
+
+}
@@ -11,10 +11,16 @@
 #include "format.h"
 #include "string_util.h"
 #include <sstream>
+#include <atomic>
 
 namespace larcfm {
 
-long ParameterEntry::count = 0;
+// Creation order of entries, which may be created concurrently by different threads
+static std::atomic<long> entry_count(0);
+
+long ParameterEntry::nextOrder() {
+	return entry_count++;
+}
 
 ParameterEntry::ParameterEntry() :
 	sval(""),
@@ -22,7 +28,7 @@ ParameterEntry::ParameterEntry() :
 	units("unspecified"),
 	bval(false),
 	comment(""),
-	order(count++) {
+	order(nextOrder()) {
 }
 
 ParameterEntry::~ParameterEntry() {
@@ -40,7 +46,7 @@ ParameterEntry::ParameterEntry(const std::string& s, double d, const std::string
 
 ParameterEntry ParameterEntry::make(const std::string& s, double d, const std::string& u,
 	bool b, const std::string& msg) {
-	return ParameterEntry(s, d, u, b, msg, count++);
+	return ParameterEntry(s, d, u, b, msg, nextOrder());
 }
 
 ParameterEntry ParameterEntry::make(const ParameterEntry& entry) {
@@ -51,16 +57,16 @@ ParameterEntry ParameterEntry::make(const ParameterEntry& entry) {
 // Make boolean entry
 ParameterEntry ParameterEntry::makeBoolEntry(bool b) {
 	return ParameterEntry(b ? "true" : "false",0,
-			"unitless", b, "", count++);
+			"unitless", b, "", nextOrder());
 }
 
 // New double entry
 ParameterEntry ParameterEntry::makeDoubleEntry(double d, const std::string& u, int p) {
-	return ParameterEntry(format(u,d,p),d,u,false,"", count++);
+	return ParameterEntry(format(u,d,p),d,u,false,"", nextOrder());
 }
 // New integer entry
 ParameterEntry ParameterEntry::makeIntEntry(int i){
-	return ParameterEntry(to_string(i),i,"unitless",false,"",count++);
+	return ParameterEntry(to_string(i),i,"unitless",false,"",nextOrder());
 }
 
 std::string ParameterEntry::format(const std::string& u, double d, int p) {
@@ -34,6 +34,16 @@ using std::map;
 using std::cout;
 using std::endl;
 
+// Characters removed by trim from both ends of a line
+static bool is_blank(char c) {
+	return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// Characters matched by the default delimiter pattern Constants::wsPatternBase
+static bool is_delimiter(char c) {
+	return c == ' ' || c == '\t' || c == ',' || c == ';';
+}
+
 SeparatedInput::SeparatedInputException::SeparatedInputException(
 		const std::string& s) :
 						std::logic_error(s) {
@@ -47,6 +57,12 @@ SeparatedInput::SeparatedInput() :
 	parameters = ParameterData();
 	patternStr = Constants::wsPatternBase;
 	reader = 0;
+	data_begin = data_end = data_pos = NULL;
+	data_eof = true;
+	line_in_buf = true;
+	line_offset = 0;
+	line_length = 0;
+	cols_in_line = false;
 	linenum = 0;
 	fixed_width = false;
 	quoteCharDefined = false;
@@ -58,6 +74,12 @@ SeparatedInput::SeparatedInput() :
 SeparatedInput::SeparatedInput(std::istream* ins) :
 						error("SeparatedInput") {
 	reader = ins;
+	data_begin = data_end = data_pos = NULL;
+	data_eof = true;
+	line_in_buf = true;
+	line_offset = 0;
+	line_length = 0;
+	cols_in_line = false;
 	header = false;
 	bunits = false;
 	caseSensitive = true;
@@ -75,11 +97,50 @@ SeparatedInput::SeparatedInput(std::istream* ins) :
 
 }
 
+// characters must remain valid while lines are read
+SeparatedInput::SeparatedInput(const char* begin, const char* end) :
+						error("SeparatedInput") {
+	reader = 0;
+	data_begin = begin;
+	data_end = end;
+	data_pos = begin;
+	data_eof = false;
+	line_in_buf = true;
+	line_offset = 0;
+	line_length = 0;
+	cols_in_line = false;
+	header = false;
+	bunits = false;
+	caseSensitive = true;
+	header_str.reserve(10); // note: reserve() is appropriate because we exclusively use push_back to populate the vectors
+	units_str.reserve(10);
+	units_factor.reserve(10);
+	line_str.reserve(10);
+	linenum = 0;
+	patternStr = Constants::wsPatternBase;
+	fixed_width = false;
+	parameters = ParameterData();
+	quoteCharDefined = false;
+	quoteCharacter = '"'; // not needed, just to eliminate warnings
+	preambleImage = "";
+}
+
 // This should never be used, it should exit
 SeparatedInput::SeparatedInput(const SeparatedInput& x) :
 						error("SeparatedInputError") {
 	error = x.error;
 	reader = x.reader;
+	data_begin = x.data_begin;
+	data_end = x.data_end;
+	data_pos = x.data_pos;
+	data_eof = x.data_eof;
+	line_buf = x.line_buf;
+	line_in_buf = x.line_in_buf;
+	line_offset = x.line_offset;
+	line_length = x.line_length;
+	line_cols = x.line_cols;
+	cols_in_line = x.cols_in_line;
+	default_factors = x.default_factors;
 	header = x.header;
 	bunits = x.bunits;
 	caseSensitive = x.caseSensitive;
@@ -104,6 +165,17 @@ SeparatedInput::SeparatedInput(const SeparatedInput& x) :
 SeparatedInput& SeparatedInput::operator=(const SeparatedInput& x) {
 	error = x.error;
 	reader = x.reader;
+	data_begin = x.data_begin;
+	data_end = x.data_end;
+	data_pos = x.data_pos;
+	data_eof = x.data_eof;
+	line_buf = x.line_buf;
+	line_in_buf = x.line_in_buf;
+	line_offset = x.line_offset;
+	line_length = x.line_length;
+	line_cols = x.line_cols;
+	cols_in_line = x.cols_in_line;
+	default_factors = x.default_factors;
 	header = x.header;
 	bunits = x.bunits;
 	caseSensitive = x.caseSensitive;
@@ -266,38 +338,81 @@ bool SeparatedInput::getCaseSensitive() const {
 
 double SeparatedInput::getUnitFactor(int i) const {
 	if (!bunits || i < 0 || (unsigned int) i >= units_str.size()) {
-		return Units::getFactor("unspecified");
+		return getDefaultFactor("unspecified");
 	}
 	return units_factor[i];
 }
 
+/**
+ * Same as Units::getFactor(unit), but each unit is only resolved once
+ */
+double SeparatedInput::getDefaultFactor(const std::string& unit) const {
+	std::map<std::string,double>::const_iterator factor_ptr = default_factors.find(unit);
+	if (factor_ptr != default_factors.end()) {
+		return factor_ptr->second;
+	}
+	double factor = Units::getFactor(unit);
+	default_factors[unit] = factor;
+	return factor;
+}
+
+/**
+ * Number of columns of the last line read
+ */
+int SeparatedInput::columns() const {
+	return static_cast<int>(cols_in_line ? line_cols.size() : line_str.size());
+}
+
+/**
+ * Characters [begin,end) of column i of the last line read. Requires 0 <= i < columns().
+ */
+void SeparatedInput::column(int i, const char*& begin, const char*& end) const {
+	if (cols_in_line) {
+		begin = lineBegin()+line_cols[i].first;
+		end = begin+line_cols[i].second;
+	} else {
+		begin = line_str[i].data();
+		end = begin+line_str[i].size();
+	}
+}
 
 bool SeparatedInput::columnHasValue(int i) const {
-	return (i >= 0 && i < (int) line_str.size() && !equals(line_str[i], "")
-			&& !equals(line_str[i], "-"));
+	if (i < 0 || i >= columns()) {
+		return false;
+	}
+	const char* begin;
+	const char* end;
+	column(i,begin,end);
+	return begin != end && !(end-begin == 1 && *begin == '-');
 }
 
 string SeparatedInput::getColumnString(int i) const {
-	if (i < 0 || (unsigned int) i >= line_str.size()) {
+	if (i < 0 || i >= columns()) {
 		error.addWarning(
 				"getColumnString index " + Fm0(i) + ", line " + Fm0(linenum)
 				+ " out of bounds");
 		return "";
 	}
-	return line_str[i];
+	const char* begin;
+	const char* end;
+	column(i,begin,end);
+	return string(begin,end);
 }
 
 double SeparatedInput::getColumn(int i, double defaultValue, bool verbose) const {
-	if (i < 0 || (unsigned int) i >= line_str.size()) {
+	if (i < 0 || i >= columns()) {
 		if (verbose) error.addWarning("getColumn index " + Fm0(i) + ", line " + Fm0(linenum) + " out of bounds");
 		return defaultValue;
 	}
 	double rtn = defaultValue;
+	const char* begin;
+	const char* end;
+	column(i,begin,end);
 	try {
-		rtn = Units::from(getUnitFactor(i), Util::parse_double(line_str[i]));
+		rtn = Units::from(getUnitFactor(i), Util::parse_double(begin,end));
 	}
 	catch (std::runtime_error e) {
-		if (verbose) error.addWarning("could not parse double (" + Fm0(i) + "), line " + Fm0(linenum) + ": " + line_str[i]);
+		if (verbose) error.addWarning("could not parse double (" + Fm0(i) + "), line " + Fm0(linenum) + ": " + string(begin,end));
 		rtn = defaultValue;  // arbitrary value
 	}
 	return rtn;
@@ -309,8 +424,8 @@ double SeparatedInput::getColumn(int i) const {
 
 
 double SeparatedInput::getColumn(int i, const std::string& default_unit) const {
-	if (getUnit(i) == "unspecified") {
-		return Units::from(default_unit, getColumn(i, 0.0, true));
+	if (!bunits || i < 0 || (unsigned int) i >= units_str.size() || units_str[i] == "unspecified") {
+		return Units::from(getDefaultFactor(default_unit), getColumn(i, 0.0, true));
 	}
 
 	return getColumn(i, 0.0, true);
@@ -322,55 +437,47 @@ double SeparatedInput::getColumn(int i, const std::string& default_unit) const {
 
 
 bool SeparatedInput::readLine() {
-	//char* linestr = new char[maxLineSize];
-	string str;
-	str.reserve(maxLineSize);
-	str.clear();
+	bool found = false;
 	try {
-		while( ! reader->eof()) {
-//		while ( ! reader->eof()) {
-//			//reader->getline(linestr, maxLineSize);
-//			getline(*reader, str);
-//			++linenum;
+		while ( ! atEof()) {
+			readFullLine();
 
-			str = readFullLine(reader);
-
-			string lineRead = str + "\n";
+			const char* begin = lineBegin();
+			const char* end = begin+line_length;
+			const char* line_end = end;
 
 			// Remove comments from line
-			size_t comment_num = str.find('#');
-			if (comment_num != string::npos) {   //if (comment_num >= 0) {
-				str = str.substr(0,comment_num);
-			}
-			trim(str);
+			const char* comment = std::find(begin, end, '#');
+			end = comment;
+			while (begin < end && is_blank(*begin)) ++begin;
+			while (begin < end && is_blank(*(end-1))) --end;
 			// Skip empty lines
-			if (str.size() == 0) {
-				str.clear();
-				if (!header) preambleImage += lineRead; // store image
+			if (begin == end) {
+				if (!header) preambleImage += string(lineBegin(),line_end) + "\n"; // store image
 				continue;
 			}
 
-
 			if (!header) {
-				header = process_preamble(str);
+				header = process_preamble(string(begin,end));
 				if (!header) {
-					preambleImage += lineRead;
+					preambleImage += string(lineBegin(),line_end) + "\n";
 				}
 			} else if ( ! bunits) {
 				try {
-					bunits = process_units(str);
+					bunits = process_units(string(begin,end));
 				}
 				catch (SeparatedInputException e) {
 					// use default units
 					bunits = false;
-					process_line(str);
+					process_line(begin,end);
+					found = true;
 					break;
 				}
 			} else {
-				process_line(str);
+				process_line(begin,end);
+				found = true;
 				break;
 			}
-			str.clear();
 		}  //while
 	}
 	catch (std::runtime_error e) {
@@ -379,13 +486,72 @@ bool SeparatedInput::readLine() {
 				+ "The error was:" + e.what());
 		// ERROR CLEANUP
 	}
-	if (str.size() == 0) {
-		return true;
+	return !found;
+}
+
+bool SeparatedInput::atEof() const {
+	return reader != 0 ? reader->eof() : data_eof;
+}
+
+/**
+ * First character of the current line
+ */
+const char* SeparatedInput::lineBegin() const {
+	return line_in_buf ? line_buf.data() : data_begin+line_offset;
+}
+
+/**
+ * Read next line of the input in memory as the range [begin,end), which doesn't include the
+ * end of line. Following getline, eof is reached when a line isn't terminated by an end of line.
+ * @return true if eof has been reached
+ */
+bool SeparatedInput::readMemoryLine(const char*& begin, const char*& end) {
+	begin = data_pos;
+	end = std::find(data_pos, data_end, '\n');
+	++linenum;
+	if (end == data_end) {
+		data_pos = data_end;
+		data_eof = true;
 	} else {
-		return false;
+		data_pos = end+1;
 	}
+	return data_eof;
 }
 
+/**
+ * Read next line, joining lines when a quoted string spans several of them, into the current line.
+ * Lines of the input in memory are not copied.
+ */
+void SeparatedInput::readFullLine() {
+	if (reader != 0) {
+		line_buf = readFullLine(reader);
+		line_in_buf = true;
+		line_length = line_buf.size();
+		return;
+	}
+	const char* begin;
+	const char* end;
+	line_in_buf = false;
+	line_offset = 0;
+	line_length = 0;
+	if (readMemoryLine(begin,end)) {
+		line_offset = begin-data_begin;
+		line_length = end-begin;
+		return;
+	}
+	if (quoteCharDefined) {
+		do {
+			if (std::count(begin, end, quoteCharacter) % 2 == 0) break;
+			const char* begin2;
+			const char* end2;
+			if (readMemoryLine(begin2,end2)) break;
+			// Lines are contiguous in memory, joined by the end of line
+			end = end2;
+		} while (true);
+	}
+	line_offset = begin-data_begin;
+	line_length = end-begin;
+}
 
 string SeparatedInput::readFullLine(std::istream* reader) {
 //		while ( ! reader->eof()) {
@@ -444,7 +610,7 @@ bool SeparatedInput::process_preamble(string str) {
 		return false;
 	} else {
 		//fields = split(str, patternStr);
-		fields = split_regex(str, patternStr);
+		fields = split_fields(str);
 		if ( ! caseSensitive) {
 			for (unsigned int i = 0; i < fields.size(); i++) {
 				fields[i] = toLowerCase(fields[i]);
@@ -458,7 +624,7 @@ bool SeparatedInput::process_preamble(string str) {
 
 bool SeparatedInput::process_units(const string& str) {
 	//vector<string> fields = split(str, patternStr);
-	vector<string> fields = split_regex(str, patternStr);
+	vector<string> fields = split_fields(str);
 
 	// if units are optional, we need to determine if any were read in...
 	// a unit line is considered true if AT LEASE HALF of the fields read in are interpreted as valid units
@@ -477,13 +643,16 @@ bool SeparatedInput::process_units(const string& str) {
 		if (equals(u,"unspecified")) {
 			notFound++;
 			units_str.push_back("unspecified");
-			units_factor.push_back(Units::getFactor("unspecified"));
+			units_factor.push_back(getDefaultFactor("unspecified"));
 		} else {
 			units_str.push_back(u);
 			units_factor.push_back(factor);
 		}
 	}
 	if (notFound > fields.size() / 2 || notFound+dash == fields.size()) {
+		// this wasn't a units line, forget the units read from it
+		units_str.resize(units_str.size()-fields.size());
+		units_factor.resize(units_factor.size()-fields.size());
 		throw SeparatedInputException("default units");
 	}
 	return true;
@@ -516,6 +685,64 @@ void SeparatedInput::process_line(const string& str) {
 		}
 	}
 	line_str = fields;
+	cols_in_line = false;
+}
+
+/**
+ * Process data line [begin,end), which is a range of the current line. When columns are
+ * separated by the default delimiters, they are recorded as ranges of the current line,
+ * without copying them.
+ */
+void SeparatedInput::process_line(const char* begin, const char* end) {
+	if (fixed_width || quoteCharDefined || !default_delimiters()) {
+		process_line(string(begin,end));
+		return;
+	}
+	// Same fields as split_regex(string(begin,end),patternStr)
+	int base = static_cast<int>(begin-lineBegin());
+	line_cols.clear();
+	const char* field = begin;
+	while (field < end) {
+		const char* delim = std::find_if(field, end, is_delimiter);
+		line_cols.push_back(std::make_pair(base+static_cast<int>(field-begin),static_cast<int>(delim-field)));
+		if (delim == end) {
+			break;
+		}
+		field = delim;
+		while (field < end && is_delimiter(*field)) ++field;
+		if (field == end) {
+			line_cols.push_back(std::make_pair(base+static_cast<int>(end-begin),0));
+		}
+	}
+	cols_in_line = true;
+}
+
+/**
+ * True if columns are separated by the default pattern, which is split without regular expressions
+ */
+bool SeparatedInput::default_delimiters() const {
+	return patternStr == Constants::wsPatternBase;
+}
+
+vector<string> SeparatedInput::split_fields(const string& str) const {
+	if (!default_delimiters()) {
+		return split_regex(str, patternStr);
+	}
+	vector<string> fields;
+	string::const_iterator field = str.begin();
+	while (field != str.end()) {
+		string::const_iterator delim = std::find_if(field, str.end(), is_delimiter);
+		fields.push_back(string(field,delim));
+		if (delim == str.end()) {
+			break;
+		}
+		field = delim;
+		while (field != str.end() && is_delimiter(*field)) ++field;
+		if (field == str.end()) {
+			fields.push_back("");
+		}
+	}
+	return fields;
 }
 
 vector<string> SeparatedInput::processQuotes(const string& str) const {
@@ -575,11 +802,14 @@ vector<string> SeparatedInput::processQuotes(const string& str) const {
 
 string SeparatedInput::getLine() const {
 	string s = "";
-	if (line_str.size() > 0) {
-		s = line_str[0];
-	}
-	for (int i = 1; i < (int) line_str.size(); i++) {
-		s += ", "+line_str[i];
+	for (int i = 0; i < columns(); i++) {
+		const char* begin;
+		const char* end;
+		column(i,begin,end);
+		if (i > 0) {
+			s += ", ";
+		}
+		s.append(begin,end);
 	}
 	return s;
 }
@@ -12,6 +12,7 @@
 #include "ErrorLog.h"
 #include "ErrorReporter.h"
 #include "SeparatedInput.h"
+#include "MappedFile.h"
 #include "StateReader.h"
 #include "SequenceReader.h"
 #include "AircraftState.h"
@@ -20,6 +21,7 @@
 #include "Velocity.h"
 #include "Constants.h"
 #include "format.h"
+#include "Util.h"
 #include <string>
 #include <vector>
 #include <set>
@@ -51,39 +53,34 @@ SequenceReader::SequenceReader() {
 SequenceReader::SequenceReader(const string& filename) {
 	error = ErrorLog("SequenceReader("+filename+")");
 	windowSize = AircraftState::DEFAULT_BUFFER_SIZE;
-	std::ifstream in;
-
-	in.open(filename.c_str());
-	if ( in.fail() ) {
+	// the file is parsed in place, without copying its lines
+	MappedFile file;
+	if ( ! file.open(filename) ) {
 		error.addError("File "+filename+" read protected or not found");
 		return;
 	}
-	input = SeparatedInput(&in);
+	input = SeparatedInput(file.begin(),file.end());
 	input.setCaseSensitive(false);            // headers & parameters are lower case
 	loadfile();
 }
 
 void SequenceReader::open(const string& filename) {
-	std::ifstream in;
-	in.open(filename.c_str());
-	if ( in.fail() ) {
+	// the file is parsed in place, without copying its lines
+	MappedFile file;
+	if ( ! file.open(filename) ) {
 		error.addError("File "+filename+" read protected or not found");
 		sequenceTable.clear();
 		return;
 	}
 	error = ErrorLog("SequenceReader("+filename+")");
-	SeparatedInput si(&in);
-	si.setCaseSensitive(false);            // headers & parameters are lower case
-	vector<string> params = input.getParametersRef().getKeyList();
-	for (unsigned int i = 0; i < params.size(); i++) {
-		si.getParametersRef().set(params[i], input.getParametersRef().getString(params[i]));
-	}
-	input = si;
-	loadfile();
+	openInput(SeparatedInput(file.begin(),file.end()));
 }
 
 void SequenceReader::open(std::istream* in) {
-	SeparatedInput si(in);
+	openInput(SeparatedInput(in));
+}
+
+void SequenceReader::openInput(SeparatedInput si) {
 	si.setCaseSensitive(false);            // headers & parameters are lower case
 	vector<string> params = input.getParametersRef().getKeyList();
 	for (unsigned int i = 0; i < params.size(); i++) {
@@ -252,10 +249,17 @@ void SequenceReader::loadfile() {
 
 
 	}
-	// reset accuracy parameters to their previous values
-	Constants::set_horizontal_accuracy(h);
-	Constants::set_vertical_accuracy(v);
-	Constants::set_time_accuracy(t);
+	// reset accuracy parameters to their previous values. Global accuracies are only written
+	// when the file sets them, so that files without them can be read concurrently.
+	if (this->getParametersRef().contains("horizontalAccuracy")) {
+		Constants::set_horizontal_accuracy(h);
+	}
+	if (this->getParametersRef().contains("verticalAccuracy")) {
+		Constants::set_vertical_accuracy(v);
+	}
+	if (this->getParametersRef().contains("timeAccuracy")) {
+		Constants::set_time_accuracy(t);
+	}
 
 
 	// we initially load the LAST sequent as the active one
@@ -306,7 +310,7 @@ void SequenceReader::buildActive(double tm) {
 		string name = nameIndex[i];
 		for (int j = 0; j < (signed int)times.size(); j++) { // for each name, work through the times in the window
 			double time = times[j];
-			SequenceEntry sequenceEntry = sequenceTable[time];
+			SequenceEntry& sequenceEntry = sequenceTable[time];
 			if (sequenceEntry.find(name) != sequenceEntry.end()) {	// name has an entry at this time
 				if (included.find(name) == included.end()) {  // name has not been added to the states list yet
 					// build a new AircraftState
@@ -382,18 +386,17 @@ vector<double> SequenceReader::sequenceKeys() {
 
 /** a list of n > 0 sequence keys, stopping at the given time (inclusive) */
 vector<double> SequenceReader::sequenceKeysUpTo(int n, double tm) {
+	// keys of the table are sorted, so the window is the n keys before the first key greater than tm
 	vector<double> arl;
-	SequenceEntryMap::iterator pos;
-	for (pos = sequenceTable.begin(); pos != sequenceTable.end(); ++pos) {
-		if (pos->first <= tm) {
-			arl.push_back(pos->first);
-		}
+	if (ISNAN(tm)) {
+		return arl;
 	}
-	sort(arl.begin(),arl.end());
-	// limit to window size
-	while ((signed int)arl.size() > n) {
-		arl.erase(arl.begin());
+	SequenceEntryMap::iterator pos = sequenceTable.upper_bound(tm);
+	while (pos != sequenceTable.begin() && (signed int)arl.size() < n) {
+		--pos;
+		arl.push_back(pos->first);
 	}
+	std::reverse(arl.begin(),arl.end());
 	return arl;
 }
 
@@ -0,0 +1,365 @@
+/*
+ * SequenceStreamReader
+ *
+ * Copyright (c) 2011-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+#include "SequenceStreamReader.h"
+#include "ErrorLog.h"
+#include "SeparatedInput.h"
+#include "AircraftState.h"
+#include "LatLonAlt.h"
+#include "string_util.h"
+#include "Util.h"
+#include "format.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <algorithm>
+
+namespace larcfm {
+using std::string;
+using std::vector;
+
+/** A new, empty reader. */
+SequenceStreamReader::SequenceStreamReader() {
+	error = ErrorLog("SequenceStreamReader(no file)");
+	windowSize = 1;
+	input.setCaseSensitive(false);            // headers & parameters are lower case
+	init();
+	done = true;
+}
+
+SequenceStreamReader::SequenceStreamReader(const string& filename) {
+	windowSize = 1;
+	open(filename);
+}
+
+void SequenceStreamReader::open(const string& filename) {
+	error = ErrorLog("SequenceStreamReader("+filename+")");
+	if ( ! file.open(filename) ) {
+		error.addError("File "+filename+" read protected or not found");
+		init();
+		done = true;
+		return;
+	}
+	openInput(SeparatedInput(file.begin(),file.end()));
+}
+
+void SequenceStreamReader::open(std::istream* in) {
+	openInput(SeparatedInput(in));
+}
+
+void SequenceStreamReader::openInput(SeparatedInput si) {
+	si.setCaseSensitive(false);            // headers & parameters are lower case
+	vector<string> params = input.getParametersRef().getKeyList();
+	for (unsigned int i = 0; i < params.size(); i++) {
+		si.getParametersRef().set(params[i], input.getParametersRef().getString(params[i]));
+	}
+	input = si;
+	init();
+}
+
+void SequenceStreamReader::init() {
+	hasRead = false;
+	clock = true;
+	head.assign(definedColumns,-1);
+	states.clear();
+	extracolumnValues.clear();
+	handles.clear();
+	names.clear();
+	nextHandle = 0;
+	lastName = "";
+	window.clear();
+	pending = false;
+	done = false;
+}
+
+/**
+ * Sets the window size, i.e., number of time steps kept in memory
+ * @param s > 0
+ */
+void SequenceStreamReader::setWindowSize(int s) {
+	if (s > 0) windowSize = s;
+}
+
+/**
+ * Returns the current window size
+ */
+int SequenceStreamReader::getWindowSize() const {
+	return windowSize;
+}
+
+/**
+ * Read next data line. The first call also processes the heading.
+ * @return false if end of file
+ */
+bool SequenceStreamReader::readDataLine() {
+	if (input.readLine()) {
+		return false;
+	}
+	if (!hasRead) {
+
+		// process heading
+		latlon = (altHeadings("lat", "lon", "long", "latitude") >= 0);
+		clock = (altHeadings("clock", "") >= 0);
+		trkgsvs = (altHeadings("trk","track") >= 0);
+
+		head[NAME] =   altHeadings("name", "aircraft", "id");
+		head[LAT_SX] = altHeadings("sx", "lat", "latitude");
+		head[LON_SY] = altHeadings("sy", "lon", "long", "longitude");
+		head[ALT_SZ] = altHeadings("sz", "alt", "altitude");
+		head[TRK_VX] = altHeadings("trk", "vx", "track");
+		head[GS_VY] = altHeadings("gs", "vy", "groundspeed", "groundspd");
+		head[VS_VZ] = altHeadings("vs", "vz", "verticalspeed", "hdot");
+		head[TM_CLK] = altHeadings("clock", "time", "tm", "st");
+
+		if (this->getParametersRef().contains("filetype")) {
+			string sval = this->getParametersRef().getString("filetype");
+			if (!equalsIgnoreCase(sval, "state") && !equalsIgnoreCase(sval, "history") && !equalsIgnoreCase(sval, "sequence")) {
+				error.addError("Wrong filetype: "+sval);
+				return false;
+			}
+		}
+
+		// add new user column headings
+		for (int i = 0; i < input.size(); i++) {
+			std::string hd = input.getHeading(i);
+			if (!equals(hd,"")) {
+				int headingindex = input.findHeading(hd);
+				if (std::find(head.begin(), head.end(), headingindex) == head.end()) {
+					head.push_back(headingindex);
+				}
+			}
+		}
+
+		hasRead = true;
+		for (int i = 0; i <= TM_CLK; i++) {
+			if (head[i] < 0) error.addError("This appears to be an invalid state file (missing header definitions)");
+		}
+	}
+	return true;
+}
+
+/**
+ * Parse the last data line into time tm, aircraft handle, and data point dp.
+ * @return false if the line has an error
+ */
+bool SequenceStreamReader::processDataLine(double& tm, int& handle, DataPoint& dp) {
+	string thisName = input.getColumnString(head[NAME]);
+
+	if (equals(thisName,"\"") && !equals(lastName,"")) {
+		thisName = lastName;
+	} else if ((equals(thisName,"\"") && equals(lastName,"")) || equals(thisName,"")) {
+		error.addError("Cannot find first aircraft");
+		return false;
+	} else if (handles.find(thisName) == handles.end()) {
+		lastName = thisName;
+	}
+	handle = handleOf(thisName);
+
+	tm = 0.0;
+	if (head[TM_CLK] >= 0) {
+		tm = parseClockTime(input.getColumnString(head[TM_CLK]));
+	}
+
+	if (input.hasError()) {
+		error.addError(input.getMessage());
+		return false;
+	}
+
+	if (latlon) {
+		dp.p = Position(LatLonAlt::mk(input.getColumn(head[LAT_SX], "deg"),
+				input.getColumn(head[LON_SY], "deg"),
+				input.getColumn(head[ALT_SZ], "ft")));
+	} else {
+		dp.p = Position(Vect3(
+				input.getColumn(head[LAT_SX], "nmi"),
+				input.getColumn(head[LON_SY], "nmi"),
+				input.getColumn(head[ALT_SZ], "ft")));
+	}
+
+	if (trkgsvs) {
+		dp.v = Velocity::mkTrkGsVs(
+				input.getColumn(head[TRK_VX], "deg"),
+				input.getColumn(head[GS_VY], "knot"),
+				input.getColumn(head[VS_VZ], "fpm"));
+	} else {
+		dp.v = Velocity::mkVxyz(
+				input.getColumn(head[TRK_VX], "knot"),
+				input.getColumn(head[GS_VY], "knot"),
+				input.getColumn(head[VS_VZ], "fpm"));
+	}
+
+	// handle extra columns
+	dp.extra.clear();
+	for (int i = definedColumns; i < (int) head.size(); i++) {
+		int colnum = head[i];
+		if (input.columnHasValue(colnum)) {
+			std::string str = input.getColumnString(colnum);
+			double val = input.getColumn(colnum, NaN, false);
+			bool bol = false;
+			if (equalsIgnoreCase(str, "true")) {
+				bol = true;
+			}
+			dp.extra[colnum] = Triple<double,bool,std::string>(val, bol, str);
+		}
+	}
+	return true;
+}
+
+/**
+ * @return handle of aircraft name. A new handle is assigned if the aircraft is not in the window.
+ */
+int SequenceStreamReader::handleOf(const string& name) {
+	std::map<string,int>::const_iterator ptr = handles.find(name);
+	if (ptr != handles.end()) {
+		return ptr->second;
+	}
+	int handle = nextHandle++;
+	handles[name] = handle;
+	names[handle] = name;
+	return handle;
+}
+
+/**
+ * Forget the names of the aircraft in the entries of a time step that has left the window, unless they
+ * are still in the window or read ahead. Therefore, the number of names kept doesn't depend on the length
+ * of the file.
+ */
+void SequenceStreamReader::evict(const SequenceEntry& entries) {
+	SequenceEntry::const_iterator entry_ptr;
+	for (entry_ptr = entries.begin(); entry_ptr != entries.end(); ++entry_ptr) {
+		int handle = entry_ptr->first;
+		bool used = pending && pendingHandle == handle;
+		std::deque<TimeStep>::const_iterator step_ptr;
+		for (step_ptr = window.begin(); !used && step_ptr != window.end(); ++step_ptr) {
+			used = step_ptr->entries.find(handle) != step_ptr->entries.end();
+		}
+		if (!used) {
+			std::map<int,string>::iterator name_ptr = names.find(handle);
+			handles.erase(name_ptr->second);
+			names.erase(name_ptr);
+		}
+	}
+}
+
+/**
+ * Read the next time step and make it the active set of states.
+ * @return false if there are no more time steps, in which case the active set is empty
+ */
+bool SequenceStreamReader::readNext() {
+	TimeStep step;
+	bool found = false;
+	if (pending) {
+		step.time = pendingTime;
+		step.entries[pendingHandle] = pendingPoint;
+		pending = false;
+		found = true;
+	}
+	bool fatal = false;
+	while (!done) {
+		double tm;
+		int handle;
+		if (!readDataLine()) {
+			done = true;
+		} else if (!processDataLine(tm,handle,pendingPoint)) {
+			fatal = true;
+			done = true;
+		} else if (!found) {
+			step.time = tm;
+			step.entries[handle] = pendingPoint;
+			found = true;
+		} else if (tm == step.time) {
+			step.entries[handle] = pendingPoint;
+		} else if (tm > step.time) {
+			pendingTime = tm;
+			pendingHandle = handle;
+			pending = true;
+			break;
+		} else {
+			error.addError("Time "+FmPrecision(tm)+" is not increasing (line "+Fmi(input.lineNumber())+")");
+			fatal = true;
+			done = true;
+		}
+	}
+	if (fatal) {
+		// Partial time steps are discarded
+		found = false;
+	}
+
+	if (!found) {
+		window.clear();
+		handles.clear();
+		names.clear();
+		states.clear();
+		extracolumnValues.clear();
+		return false;
+	}
+	window.push_back(step);
+	while ((int)window.size() > windowSize) {
+		SequenceEntry old;
+		old.swap(window.front().entries);
+		window.pop_front();
+		evict(old);
+	}
+	buildActive();
+	return true;
+}
+
+/**
+ * @return true if there are no more time steps to read
+ */
+bool SequenceStreamReader::atEnd() const {
+	return done && !pending;
+}
+
+/**
+ * @return time of the last time step read or NaN if none
+ */
+double SequenceStreamReader::activeTime() const {
+	if (window.empty()) {
+		return NaN;
+	}
+	return window.back().time;
+}
+
+// As in SequenceReader, aircraft are ordered by appearance in the file. States include all entries
+// in the window, but extra column values are the ones of the last time step.
+void SequenceStreamReader::buildActive() {
+	vector<int> active;
+	std::deque<TimeStep>::const_iterator step_ptr;
+	SequenceEntry::const_iterator entry_ptr;
+	for (step_ptr = window.begin(); step_ptr != window.end(); ++step_ptr) {
+		for (entry_ptr = step_ptr->entries.begin(); entry_ptr != step_ptr->entries.end(); ++entry_ptr) {
+			active.push_back(entry_ptr->first);
+		}
+	}
+	std::sort(active.begin(),active.end());
+	active.erase(std::unique(active.begin(),active.end()),active.end());
+	states.clear();
+	extracolumnValues.clear();
+	const SequenceEntry& last = window.back().entries;
+	for (int i = 0; i < (int)active.size(); ++i) {
+		states.push_back(AircraftState(names[active[i]]));
+		for (step_ptr = window.begin(); step_ptr != window.end(); ++step_ptr) {
+			entry_ptr = step_ptr->entries.find(active[i]);
+			if (entry_ptr != step_ptr->entries.end()) {
+				states[i].add(entry_ptr->second.p, entry_ptr->second.v, step_ptr->time);
+			}
+		}
+		entry_ptr = last.find(active[i]);
+		if (entry_ptr != last.end()) {
+			ExtraEntry::const_iterator extra_ptr;
+			for (extra_ptr = entry_ptr->second.extra.begin(); extra_ptr != entry_ptr->second.extra.end(); ++extra_ptr) {
+				extracolumnValues[std::pair<int,int>(i,extra_ptr->first)] = extra_ptr->second;
+			}
+		}
+	}
+}
+
+}
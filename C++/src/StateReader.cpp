@@ -21,6 +21,7 @@
 #include "ErrorLog.h"
 #include "ErrorReporter.h"
 #include "SeparatedInput.h"
+#include "MappedFile.h"
 #include "AircraftState.h"
 #include "Position.h"
 #include "Velocity.h"
@@ -75,20 +76,22 @@ namespace larcfm {
 //  }
 //
   void StateReader::open(const string& filename) {
-    std::ifstream in;
-    in.open(filename.c_str());
-    if ( in.fail() ) {
+    // the file is parsed in place, without copying its lines
+    MappedFile file;
+    if ( ! file.open(filename) ) {
       error.addError("File "+filename+" read protected or not found");
       states.clear();
       return;
     } 
     error = ErrorLog("StateReader("+filename+")");
-    open(&in);
-    in.close();
+    openInput(SeparatedInput(file.begin(),file.end()));
   }
 
   void StateReader::open(std::istream* in) {
-    SeparatedInput si(in);
+    openInput(SeparatedInput(in));
+  }
+
+  void StateReader::openInput(SeparatedInput si) {
     si.setCaseSensitive(false);            // headers & parameters are lower case
     vector<string> params = input.getParametersRef().getKeyList();
     for (unsigned int i = 0; i < params.size(); i++) {
@@ -275,10 +278,17 @@ namespace larcfm {
       lastTime = tm;
       
     }
-    // reset accuracy parameters to their previous values
-    Constants::set_horizontal_accuracy(h);
-    Constants::set_vertical_accuracy(v);
-    Constants::set_time_accuracy(t);
+    // reset accuracy parameters to their previous values. Global accuracies are only written
+    // when the file sets them, so that files without them can be read concurrently.
+    if (this->getParametersRef().contains("horizontalAccuracy")) {
+      Constants::set_horizontal_accuracy(h);
+    }
+    if (this->getParametersRef().contains("verticalAccuracy")) {
+      Constants::set_vertical_accuracy(v);
+    }
+    if (this->getParametersRef().contains("timeAccuracy")) {
+      Constants::set_time_accuracy(t);
+    }
 
   }
   
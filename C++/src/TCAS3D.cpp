@@ -92,6 +92,26 @@ ConflictData TCAS3D::conflictDetection(const Vect3& so, const Velocity& vo, cons
   return RA3D(so,vo,si,vi,B,T);
 }
 
+bool TCAS3D::criticalCylinder(double& D, double& H, double& TH, double& TV, bool& exact) const {
+  D = 0;
+  H = 0;
+  TH = 0;
+  TV = 0;
+  for (int sl=1; sl <= table_.getMaxSensitivityLevel(); ++sl) {
+    if (table_.isValidSensitivityLevel(sl)) {
+      D = Util::max(D,Util::max(table_.getDMOD(sl),table_.getHMD(sl)));
+      H = Util::max(H,table_.getZTHR(sl));
+      TH = Util::max(TH,table_.getTAU(sl));
+      TV = Util::max(TV,table_.getTCOA(sl));
+    }
+  }
+  if (!table_.getHMDFilter()) {
+    D = INFINITY;
+  }
+  exact = false;
+  return true;
+}
+
 // pointer to new instance of this object
 TCAS3D* TCAS3D::make() const {
   return new TCAS3D();
@@ -18,137 +18,129 @@ namespace larcfm {
 
 /* Default levels in internal units */
 const std::vector<double>& TCASTable::default_levels() {
-  static std::vector<double> default_levels_;
-  if (default_levels_.empty()) {
-    default_levels_.resize(7); // use resize since we are then using subscript assignment
-    default_levels_[0] = Units::from(Units::ft,0);     // Upper bound of SL 1
-    default_levels_[1] = Units::from(Units::ft,1000);  // Upper bound of SL 2
-    default_levels_[2] = Units::from(Units::ft,2350);  // Upper bound of SL 3
-    default_levels_[3] = Units::from(Units::ft,5000);  // Upper bound of SL 4
-    default_levels_[4] = Units::from(Units::ft,10000); // Upper bound of SL 5
-    default_levels_[5] = Units::from(Units::ft,20000); // Upper bound of SL 6
-    default_levels_[6] = Units::from(Units::ft,42000); // Upper bound of SL 7
-  }
+  static const double values[7] = {
+    Units::from(Units::ft,0),     // Upper bound of SL 1
+    Units::from(Units::ft,1000),  // Upper bound of SL 2
+    Units::from(Units::ft,2350),  // Upper bound of SL 3
+    Units::from(Units::ft,5000),  // Upper bound of SL 4
+    Units::from(Units::ft,10000), // Upper bound of SL 5
+    Units::from(Units::ft,20000), // Upper bound of SL 6
+    Units::from(Units::ft,42000)  // Upper bound of SL 7
+  };
+  static const std::vector<double> default_levels_(values,values+7);
   return default_levels_;
 } // Note that this array has only 7 entries.
 //It is understood that there is one additional level with an infinite upper bound.
 
 /* TA TAU Threshold in seconds */
 const std::vector<double>& TCASTable::TA_TAU() {
-  static std::vector<double> TA_TAU_;
-  if (TA_TAU_.empty()) {
-    TA_TAU_.resize(8); // use resize since we are then using subscript assignment
-    TA_TAU_[0] = 0;   // SL 1
-    TA_TAU_[1] = 20;  // SL 2
-    TA_TAU_[2] = 25;  // SL 3
-    TA_TAU_[3] = 30;  // SL 4
-    TA_TAU_[4] = 40;  // SL 5
-    TA_TAU_[5] = 45;  // SL 6
-    TA_TAU_[6] = 48;  // SL 7
-    TA_TAU_[7] = 48;  // SL 8
-  }
+  static const double values[8] = {
+    0,  // SL 1
+    20, // SL 2
+    25, // SL 3
+    30, // SL 4
+    40, // SL 5
+    45, // SL 6
+    48, // SL 7
+    48  // SL 8
+  };
+  static const std::vector<double> TA_TAU_(values,values+8);
   return TA_TAU_;
 }
 
 /* RA TAU Threshold in seconds */
 const std::vector<double>& TCASTable::RA_TAU() {
-  static std::vector<double> RA_TAU_;
-  if (RA_TAU_.empty()) {
-    RA_TAU_.resize(8); // use resize since we are then using subscript assignment
-    RA_TAU_[0] = 0;  // SL 1
-    RA_TAU_[1] = 0;  // SL 2
-    RA_TAU_[2] = 15; // SL 3
-    RA_TAU_[3] = 20; // SL 4
-    RA_TAU_[4] = 25; // SL 5
-    RA_TAU_[5] = 30; // SL 6
-    RA_TAU_[6] = 35; // SL 7
-    RA_TAU_[7] = 35; // SL 8
-  }
+  static const double values[8] = {
+    0,  // SL 1
+    0,  // SL 2
+    15, // SL 3
+    20, // SL 4
+    25, // SL 5
+    30, // SL 6
+    35, // SL 7
+    35  // SL 8
+  };
+  static const std::vector<double> RA_TAU_(values,values+8);
   return RA_TAU_;
 }
 
 /* TA DMOD in internal units (0 if N/A) */
 const std::vector<double>& TCASTable::TA_DMOD() {
-  static std::vector<double> TA_DMOD_;
-  if (TA_DMOD_.empty()) {
-    TA_DMOD_.resize(8); // use resize since we are then using subscript assignment
-    TA_DMOD_[0] = 0;                             // SL 1
-    TA_DMOD_[1] = Units::from(Units::NM,0.30);   // SL 2
-    TA_DMOD_[2] = Units::from(Units::NM,0.33);   // SL 3
-    TA_DMOD_[3] = Units::from(Units::NM,0.48);   // SL 4
-    TA_DMOD_[4] = Units::from(Units::NM,0.75);   // SL 5
-    TA_DMOD_[5] = Units::from(Units::NM,1.0);    // SL 6
-    TA_DMOD_[6] = Units::from(Units::NM,1.3);    // SL 7
-    TA_DMOD_[7] = Units::from(Units::NM,1.3);    // SL 8
-  }
+  static const double values[8] = {
+    0,                           // SL 1
+    Units::from(Units::NM,0.30), // SL 2
+    Units::from(Units::NM,0.33), // SL 3
+    Units::from(Units::NM,0.48), // SL 4
+    Units::from(Units::NM,0.75), // SL 5
+    Units::from(Units::NM,1.0),  // SL 6
+    Units::from(Units::NM,1.3),  // SL 7
+    Units::from(Units::NM,1.3)   // SL 8
+  };
+  static const std::vector<double> TA_DMOD_(values,values+8);
   return TA_DMOD_;
 }
 
 /* RA DMOD in internal units (0 if N/A) */
 const std::vector<double>& TCASTable::RA_DMOD() {
-  static std::vector<double> RA_DMOD_;
-  if (RA_DMOD_.empty()) {
-    RA_DMOD_.resize(8); // use resize since we are then using subscript assignment
-    RA_DMOD_[0] = 0;                               // SL 1
-    RA_DMOD_[1] = 0;                               // SL 2
-    RA_DMOD_[2] = Units::from(Units::NM,0.2);      // SL 3
-    RA_DMOD_[3] = Units::from(Units::NM,0.35);     // SL 4
-    RA_DMOD_[4] = Units::from(Units::NM,0.55);     // SL 5
-    RA_DMOD_[5] = Units::from(Units::NM,0.8);      // SL 6
-    RA_DMOD_[6] = Units::from(Units::NM,1.1);      // SL 7
-    RA_DMOD_[7] = Units::from(Units::NM,1.1);      // SL 8
-  }
+  static const double values[8] = {
+    0,                           // SL 1
+    0,                           // SL 2
+    Units::from(Units::NM,0.2),  // SL 3
+    Units::from(Units::NM,0.35), // SL 4
+    Units::from(Units::NM,0.55), // SL 5
+    Units::from(Units::NM,0.8),  // SL 6
+    Units::from(Units::NM,1.1),  // SL 7
+    Units::from(Units::NM,1.1)   // SL 8
+  };
+  static const std::vector<double> RA_DMOD_(values,values+8);
   return RA_DMOD_;
 }
 
 /* TA ZTHR in internal units (0 if N/A) */
 const std::vector<double>& TCASTable::TA_ZTHR() {
-  static std::vector<double> TA_ZTHR_;
-  if (TA_ZTHR_.empty()) {
-    TA_ZTHR_.resize(8); // use resize since we are then using subscript assignment
-    TA_ZTHR_[0] = 0;                               // SL 1                                          // 1
-    TA_ZTHR_[1] = Units::from(Units::ft,850);      // SL 2
-    TA_ZTHR_[2] = Units::from(Units::ft,850);      // SL 3
-    TA_ZTHR_[3] = Units::from(Units::ft,850);      // SL 4
-    TA_ZTHR_[4] = Units::from(Units::ft,850);      // SL 5
-    TA_ZTHR_[5] = Units::from(Units::ft,850);      // SL 6
-    TA_ZTHR_[6] = Units::from(Units::ft,850);      // SL 7
-    TA_ZTHR_[7] = Units::from(Units::ft,1200);     // SL 8
-  }
+  static const double values[8] = {
+    0,                           // SL 1
+    Units::from(Units::ft,850),  // SL 2
+    Units::from(Units::ft,850),  // SL 3
+    Units::from(Units::ft,850),  // SL 4
+    Units::from(Units::ft,850),  // SL 5
+    Units::from(Units::ft,850),  // SL 6
+    Units::from(Units::ft,850),  // SL 7
+    Units::from(Units::ft,1200)  // SL 8
+  };
+  static const std::vector<double> TA_ZTHR_(values,values+8);
   return TA_ZTHR_;
 }
 
 /* RA ZTHR in internal units (0 if N/A) */
 const std::vector<double>& TCASTable::RA_ZTHR() {
-  static std::vector<double> RA_ZTHR_;
-  if (RA_ZTHR_.empty()) {
-    RA_ZTHR_.resize(8); // use resize since we are then using subscript assignment
-    RA_ZTHR_[0] = 0;                             // SL1
-    RA_ZTHR_[1] = 0;                             // SL 2
-    RA_ZTHR_[2] = Units::from(Units::ft,600);    // SL 3
-    RA_ZTHR_[3] = Units::from(Units::ft,600);    // SL 4
-    RA_ZTHR_[4] = Units::from(Units::ft,600);    // SL 5
-    RA_ZTHR_[5] = Units::from(Units::ft,600);    // SL 6
-    RA_ZTHR_[6] = Units::from(Units::ft,700);    // SL 7
-    RA_ZTHR_[7] = Units::from(Units::ft,800);    // SL 8
-  }
+  static const double values[8] = {
+    0,                          // SL1
+    0,                          // SL 2
+    Units::from(Units::ft,600), // SL 3
+    Units::from(Units::ft,600), // SL 4
+    Units::from(Units::ft,600), // SL 5
+    Units::from(Units::ft,600), // SL 6
+    Units::from(Units::ft,700), // SL 7
+    Units::from(Units::ft,800)  // SL 8
+  };
+  static const std::vector<double> RA_ZTHR_(values,values+8);
   return RA_ZTHR_;
 }
 
 /* RA HMD in internal units (0 if N/A) */
 const std::vector<double>& TCASTable::RA_HMD() {
-  static std::vector<double> RA_HMD_;
-  if (RA_HMD_.empty()) {
-    RA_HMD_.resize(8); // use resize since we are then using subscript assignment
-    RA_HMD_[0] = 0;                                // SL 1
-    RA_HMD_[1] = 0;                                // SL 2
-    RA_HMD_[2] = Units::from(Units::ft,1215);      // SL 3
-    RA_HMD_[3] = Units::from(Units::ft,2126);      // SL 4
-    RA_HMD_[4] = Units::from(Units::ft,3342);      // SL 5
-    RA_HMD_[5] = Units::from(Units::ft,4861);      // SL 6
-    RA_HMD_[6] = Units::from(Units::ft,6683);      // SL 7
-    RA_HMD_[7] = Units::from(Units::ft,6683);      // SL 8
-  }
+  static const double values[8] = {
+    0,                           // SL 1
+    0,                           // SL 2
+    Units::from(Units::ft,1215), // SL 3
+    Units::from(Units::ft,2126), // SL 4
+    Units::from(Units::ft,3342), // SL 5
+    Units::from(Units::ft,4861), // SL 6
+    Units::from(Units::ft,6683), // SL 7
+    Units::from(Units::ft,6683)  // SL 8
+  };
+  static const std::vector<double> RA_HMD_(values,values+8);
   return RA_HMD_;
 }
 
@@ -178,19 +170,13 @@ TCASTable::TCASTable() {
 
 // TCASII RA Table
 const TCASTable& TCASTable::TCASII_RA() {
-  static TCASTable tab;
-  if (tab.levels_.empty()) {
-    tab.setDefaultTCASIIThresholds(true);
-  }
+  static const TCASTable tab = make_TCASII_Table(true);
   return tab;
 }
 
 // TCASII RA Table
 const TCASTable& TCASTable::TCASII_TA() {
-  static TCASTable tab;
-  if (tab.levels_.empty()) {
-    tab.setDefaultTCASIIThresholds(false);
-  }
+  static const TCASTable tab = make_TCASII_Table(false);
   return tab;
 }
 
@@ -64,6 +64,17 @@ TrafficState::TrafficState(const std::string& id, const Position& pos, const Vel
   }
 }
 
+TrafficState::TrafficState(const std::string& id, const Position& pos, const Velocity& vel, const Velocity& wind_vector,
+    EuclideanProjection eprj, int alerter) :
+                                    id_(id),
+                                    pos_(pos),
+                                    gvel_(vel),
+                                    avel_(Velocity(vel.Sub(wind_vector))),
+                                    eprj_(eprj),
+                                    alerter_(alerter) {
+  applyEuclideanProjection();
+}
+
 // Set air velocity to new_avel
 void TrafficState::setAirVelocity(const Velocity& new_avel) {
   Velocity wind = windVector();
@@ -125,6 +136,13 @@ TrafficState TrafficState::makeIntruder(const std::string& id, const Position& p
   return TrafficState(id, pos, vel, eprj_, 1);
 }
 
+TrafficState TrafficState::makeIntruder(const std::string& id, const Position& pos, const Velocity& vel, const Velocity& wind_vector) const {
+  if (pos_.isLatLon() != pos.isLatLon()) {
+    return INVALID();
+  }
+  return TrafficState(id, pos, vel, wind_vector, eprj_, 1);
+}
+
 void TrafficState::setAlerterIndex(int alerter) {
   alerter_ = std::max(0, alerter);
 }
@@ -438,6 +456,13 @@ void TrafficState::resetUncertainty() {
   sum_.resetUncertainty();
 }
 
+/**
+ * Set all uncertainties from SUM data
+ */
+void TrafficState::setUncertainty(const SUMData& sum) {
+  sum_.set(sum);
+}
+
 bool TrafficState::sameId(const TrafficState& ac) const {
   return isValid() && ac.isValid() && equals(id_, ac.id_);
 }
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2015-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+#include "TrafficTrack.h"
+#include <string>
+
+namespace larcfm {
+
+TrafficTrack::TrafficTrack() :
+    id("_NoAc_"),
+    pos(Position::INVALID()),
+    vel(Velocity::INVALIDV()),
+    time(0),
+    alerter(1),
+    sum() {}
+
+TrafficTrack::TrafficTrack(const std::string& id, const Position& pos, const Velocity& vel, double time) :
+    id(id),
+    pos(pos),
+    vel(vel),
+    time(time),
+    alerter(1),
+    sum() {}
+
+TrafficTrack::TrafficTrack(const std::string& id, const Position& pos, const Velocity& vel, double time,
+    int alerter, const SUMData& sum) :
+    id(id),
+    pos(pos),
+    vel(vel),
+    time(time),
+    alerter(alerter),
+    sum(sum) {}
+
+}
@@ -464,7 +464,71 @@ bool Util::is_double(const string& str) {
 }
 #endif
 
-double Util::parse_double(const string& str) {
+/**
+ * Parse decimal numbers of the form [+-]digits[.digits][(e|E)[+-]digits] whose value is exactly computed by
+ * a single floating point multiplication or division, i.e., an integer mantissa of at most 2^53 and a
+ * decimal exponent of at most 22 in absolute value. In that case, the result is the correctly rounded value, as
+ * computed by the standard library. Returns false if the characters in [begin,end) are not of that form.
+ */
+static bool parse_simple_double(const char* begin, const char* end, double& d) {
+	static const double pow10[] = {1e0,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,1e9,1e10,1e11,
+			1e12,1e13,1e14,1e15,1e16,1e17,1e18,1e19,1e20,1e21,1e22};
+	const char* p = begin;
+	bool neg = false;
+	if (p < end && (*p == '+' || *p == '-')) {
+		neg = *p == '-';
+		++p;
+	}
+	unsigned long long m = 0;
+	int digits = 0;      // Significant digits in m
+	int exp10 = 0;
+	bool some_digit = false;
+	for (; p < end && '0' <= *p && *p <= '9'; ++p) {
+		some_digit = true;
+		if (m != 0 || *p != '0') {
+			if (++digits > 19) return false;
+			m = 10*m+(*p-'0');
+		}
+	}
+	if (p < end && *p == '.') {
+		for (++p; p < end && '0' <= *p && *p <= '9'; ++p) {
+			some_digit = true;
+			if (m != 0 || *p != '0') {
+				if (++digits > 19) return false;
+				m = 10*m+(*p-'0');
+			}
+			--exp10;
+		}
+	}
+	if (!some_digit) return false;
+	if (p < end && (*p == 'e' || *p == 'E')) {
+		++p;
+		bool eneg = false;
+		if (p < end && (*p == '+' || *p == '-')) {
+			eneg = *p == '-';
+			++p;
+		}
+		if (p == end) return false;
+		int e = 0;
+		for (; p < end && '0' <= *p && *p <= '9'; ++p) {
+			if (e > 1000) return false;
+			e = 10*e+(*p-'0');
+		}
+		exp10 += eneg ? -e : e;
+	}
+	if (p != end || m > (1ULL << 53)) return false;
+	if (m == 0) {
+		d = neg ? -0.0 : 0.0;
+		return true;
+	}
+	if (exp10 < -22 || exp10 > 22) return false;
+	d = static_cast<double>(m);
+	d = exp10 < 0 ? d/pow10[-exp10] : d*pow10[exp10];
+	if (neg) d = -d;
+	return true;
+}
+
+static double parse_double_stream(const string& str) {
 	std::istringstream stream;
 	stream.str(str);
 	double d;
@@ -475,6 +539,25 @@ double Util::parse_double(const string& str) {
 	return d;
 }
 
+double Util::parse_double(const string& str) {
+	double d;
+	if (parse_simple_double(str.data(),str.data()+str.size(),d)) {
+		return d;
+	}
+	return parse_double_stream(str);
+}
+
+/**
+ * Same as parse_double(std::string(begin,end)), but most decimal numbers are parsed in place.
+ */
+double Util::parse_double(const char* begin, const char* end) {
+	double d;
+	if (parse_simple_double(begin,end,d)) {
+		return d;
+	}
+	return parse_double_stream(string(begin,end));
+}
+
 /**
  * Returns true if the stored value for key is likely a boolean
  * @param s name
@@ -31,6 +31,10 @@ const WCV_HZ& WCV_HZ::A_WCV_HZ() {
   return dwc;
 }
 
+bool WCV_HZ::criticalCylinder(double& D, double& H, double& TH, double& TV, bool& exact) const {
+  return false;
+}
+
 Detection3D* WCV_HZ::make() const {
   return new WCV_HZ();
 }
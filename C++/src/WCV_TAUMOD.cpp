@@ -133,6 +133,15 @@ LossData WCV_TAUMOD::horizontal_WCV_interval(double T, const Vect2& s, const Vec
   return LossData(time_in,time_out);
 }
 
+bool WCV_TAUMOD::criticalCylinder(double& D, double& H, double& TH, double& TV, bool& exact) const {
+  D = table.getDTHR();
+  H = table.getZTHR();
+  TH = table.getTTHR();
+  TV = table.getTCOA();
+  exact = false;
+  return true;
+}
+
 Detection3D* WCV_TAUMOD::make() const {
   return new WCV_TAUMOD();
 }
@@ -36,14 +36,13 @@ void WCV_TAUMOD_SUM::initSUM() {
 
 /** Constructor that a default instance of the WCV tables. */
 WCV_TAUMOD_SUM::WCV_TAUMOD_SUM() {
-  wcv_vertical = new WCV_TCOA();
+  // Vertical WCV is allocated by WCV_TAUMOD
   initSUM();
 }
 
 /** Constructor that specifies a particular instance of the WCV tables. */
 WCV_TAUMOD_SUM::WCV_TAUMOD_SUM(const WCVTable& tab) {
   table = tab;
-  wcv_vertical = new WCV_TCOA();
   initSUM();
 }
 
@@ -115,6 +114,7 @@ void WCV_TAUMOD_SUM::copyFrom(const WCV_TAUMOD_SUM& wcv) {
 }
 
 WCV_TAUMOD_SUM& WCV_TAUMOD_SUM::operator=(const WCV_TAUMOD_SUM& wcv) {
+  Detection3D::operator=(wcv);
   copyFrom(wcv);
   return *this;
 }
@@ -357,35 +357,23 @@ bool WCV_TAUMOD_SUM::WCV_taumod_uncertain_detection(double B, double T, const Ve
 
 /**
  * This functional call returns a ConflictData object detailing the conflict between times B and T from now (relative), if any.
- * @param ownship   ownship state
- * @param intruder  intruder state
- * @param D   horizontal separation
- * @param H   vertical separation
+ * @param so  ownship position
+ * @param vo  ownship velocity
+ * @param si  intruder position
+ * @param vi  intruder velocity
  * @param B   beginning of detection time (>=0)
  * @param T   end of detection time (if T < 0 then use an "infinite" lookahead time)
+ * @param own_sum  ownship's SUM data
+ * @param ac_sum   intruder's SUM data
  * @return a ConflictData object detailing the conflict
  */
-ConflictData WCV_TAUMOD_SUM::conflictDetectionWithTrafficState(const TrafficState& ownship, const TrafficState& intruder,
-    double B, double T) const {
-  double s_err = relativeHorizontalPositionError(ownship,intruder);
-  double sz_err = relativeVerticalPositionError(ownship,intruder);
-  double v_err = relativeHorizontalSpeedError(ownship,intruder,s_err);
-  double vz_err = relativeVerticalSpeedError(ownship,intruder);
-
-  Vect3 so = ownship.get_s();
-  Velocity vo = ownship.get_v();
-  Vect3 si = intruder.get_s();
-  Velocity vi = intruder.get_v();
-
-  if (s_err == 0.0 && sz_err == 0.0 && v_err == 0.0 && vz_err == 0.0) {
+ConflictData WCV_TAUMOD_SUM::conflictDetectionSUM(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi,
+    double B, double T, const SUMData& own_sum, const SUMData& ac_sum) const {
+  double s_err, sz_err, v_err, vz_err;
+  if (!relative_errors(s_err,sz_err,v_err,vz_err,so,si,own_sum,ac_sum)) {
     return conflictDetection(so,vo,si,vi,B,T);
   }
 
-  s_err = Util::max(s_err, MinError);
-  sz_err = Util::max(sz_err, MinError);
-  v_err = Util::max(v_err, MinError);
-  vz_err = Util::max(vz_err, MinError);
-
   Vect3 s = so.Sub(si);
   Vect3 v = vo.Sub(vi);
   LossData ld = WCV_taumod_uncertain_interval(B,T,s,v,s_err,sz_err,v_err,vz_err);
@@ -394,6 +382,73 @@ ConflictData WCV_TAUMOD_SUM::conflictDetectionWithTrafficState(const TrafficStat
   return ConflictData(ld,t_tca,dist_tca,s,v);
 }
 
+/**
+ * This functional call returns the conflict interval between times B and T from now (relative), if any.
+ * This is the interval of conflictDetectionSUM, but critical time and distance are not computed.
+ */
+LossData WCV_TAUMOD_SUM::conflictIntervalSUM(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi,
+    double B, double T, const SUMData& own_sum, const SUMData& ac_sum) const {
+  double s_err, sz_err, v_err, vz_err;
+  if (!relative_errors(s_err,sz_err,v_err,vz_err,so,si,own_sum,ac_sum)) {
+    return WCV3D(so,vo,si,vi,B,T);
+  }
+  return WCV_taumod_uncertain_interval(B,T,so.Sub(si),vo.Sub(vi),s_err,sz_err,v_err,vz_err);
+}
+
+/**
+ * Computes the conflicts of a batch with conflictIntervalSUM in a single loop. Relative errors are computed for
+ * every element, since the horizontal speed error depends on ownship's position.
+ */
+void WCV_TAUMOD_SUM::conflictBatchSUM(std::vector<bool>& conflicts, const DetectionBatch& batch, const Vect3& si, const Velocity& vi,
+    const SUMData& own_sum, const SUMData& ac_sum) const {
+  conflicts.resize(batch.size());
+  double end;
+  for (int i = 0; i < batch.size(); ++i) {
+    double B = batch.B(i);
+    double T = batch.T(i);
+    conflicts[i] = probeInterval(B,T,end) &&
+        probeConflict(WCV_TAUMOD_SUM::conflictIntervalSUM(batch.so(i),batch.vo(i),si,vi,B,end,own_sum,ac_sum),B,T);
+  }
+}
+
+/**
+ * Computes relative errors of ownship and intruder. Returns false if there are no errors. Otherwise, errors
+ * are at least MinError.
+ */
+bool WCV_TAUMOD_SUM::relative_errors(double& s_err, double& sz_err, double& v_err, double& vz_err,
+    const Vect3& so, const Vect3& si, const SUMData& own_sum, const SUMData& ac_sum) const {
+  s_err = relativeHorizontalPositionError(own_sum,ac_sum);
+  sz_err = relativeVerticalPositionError(own_sum,ac_sum);
+  v_err = relativeHorizontalSpeedError(so,si,own_sum,ac_sum,s_err);
+  vz_err = relativeVerticalSpeedError(own_sum,ac_sum);
+
+  if (s_err == 0.0 && sz_err == 0.0 && v_err == 0.0 && vz_err == 0.0) {
+    return false;
+  }
+
+  s_err = Util::max(s_err, MinError);
+  sz_err = Util::max(sz_err, MinError);
+  v_err = Util::max(v_err, MinError);
+  vz_err = Util::max(vz_err, MinError);
+  return true;
+}
+
+bool WCV_TAUMOD_SUM::criticalCylinder(double& D, double& H, double& TH, double& TV, bool& exact) const {
+  return false;
+}
+
+/**
+ * Uncertain conflicts are conflicts of some relative position within s_err of the actual one and some
+ * relative velocity within v_err of the actual one. The bound of WCV_TAUMOD is extended accordingly, using
+ * the largest z-score of the horizontal speed error.
+ */
+double WCV_TAUMOD_SUM::horizontalReachSUM(double T, double vh, const SUMData& own_sum, const SUMData& ac_sum) const {
+  double s_err = Util::max(relativeHorizontalPositionError(own_sum,ac_sum),MinError);
+  double v_err = Util::max(Util::max(h_vel_z_score_min_,h_vel_z_score_max_)*
+      (own_sum.getHorizontalSpeedError()+ac_sum.getHorizontalSpeedError()),MinError);
+  return table.getDTHR()+s_err+(vh+v_err)*(T+table.getTTHR());
+}
+
 Detection3D* WCV_TAUMOD_SUM::make() const {
   return new WCV_TAUMOD_SUM();
 }
@@ -434,14 +489,14 @@ bool WCV_TAUMOD_SUM::contains(const Detection3D* cd) const {
   return false;
 }
 
-double WCV_TAUMOD_SUM::relativeHorizontalPositionError(const TrafficState& own, const TrafficState& ac) const {
+double WCV_TAUMOD_SUM::relativeHorizontalPositionError(const SUMData& own_sum, const SUMData& ac_sum) const {
   return h_pos_z_score_*
-      (own.sum().getHorizontalPositionError()+ac.sum().getHorizontalPositionError());
+      (own_sum.getHorizontalPositionError()+ac_sum.getHorizontalPositionError());
 }
 
-double WCV_TAUMOD_SUM::relativeVerticalPositionError(const TrafficState& own, const TrafficState& ac) const {
+double WCV_TAUMOD_SUM::relativeVerticalPositionError(const SUMData& own_sum, const SUMData& ac_sum) const {
   return v_pos_z_score_*
-      (own.sum().getVerticalPositionError()+ac.sum().getVerticalPositionError());
+      (own_sum.getVerticalPositionError()+ac_sum.getVerticalPositionError());
 }
 
 double WCV_TAUMOD_SUM::weighted_z_score(double range) const {
@@ -453,16 +508,16 @@ double WCV_TAUMOD_SUM::weighted_z_score(double range) const {
   }
 }
 
-double WCV_TAUMOD_SUM::relativeHorizontalSpeedError(const TrafficState& own, const TrafficState& ac, double s_err) const {
-  double range = own.get_s().distanceH(ac.get_s());
+double WCV_TAUMOD_SUM::relativeHorizontalSpeedError(const Vect3& so, const Vect3& si, const SUMData& own_sum, const SUMData& ac_sum, double s_err) const {
+  double range = so.distanceH(si);
   double  z_score = weighted_z_score(Util::max(range-s_err,0.0));
   return z_score*
-      (own.sum().getHorizontalSpeedError()+ac.sum().getHorizontalSpeedError());
+      (own_sum.getHorizontalSpeedError()+ac_sum.getHorizontalSpeedError());
 }
 
-double WCV_TAUMOD_SUM::relativeVerticalSpeedError(const TrafficState& own, const TrafficState& ac) const {
+double WCV_TAUMOD_SUM::relativeVerticalSpeedError(const SUMData& own_sum, const SUMData& ac_sum) const {
   return v_vel_z_score_*
-      (own.sum().getVerticalSpeedError()+ac.sum().getVerticalSpeedError());
+      (own_sum.getVerticalSpeedError()+ac_sum.getVerticalSpeedError());
 }
 
 void WCV_TAUMOD_SUM::updateParameterData(ParameterData& p) const {
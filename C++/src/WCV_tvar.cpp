@@ -32,6 +32,7 @@ void WCV_tvar::copyFrom(const WCV_tvar& wcv) {
 }
 
 WCV_tvar& WCV_tvar::operator=(const WCV_tvar& wcv) {
+  Detection3D::operator=(wcv);
   copyFrom(wcv);
   return *this;
 }
@@ -119,6 +120,25 @@ ConflictData WCV_tvar::conflictDetection(const Vect3& so, const Velocity& vo, co
   return ConflictData(ret, t_tca,dist_tca,so.Sub(si),vo.Sub(vi));
 }
 
+LossData WCV_tvar::conflictIntervalSUM(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T,
+    const SUMData& own_sum, const SUMData& ac_sum) const {
+  return WCV3D(so,vo,si,vi,B,T);
+}
+
+/**
+ * Computes the conflicts of a batch with WCV3D in a single loop (SUM data is ignored).
+ */
+void WCV_tvar::conflictBatchSUM(std::vector<bool>& conflicts, const DetectionBatch& batch, const Vect3& si, const Velocity& vi,
+    const SUMData& own_sum, const SUMData& ac_sum) const {
+  conflicts.resize(batch.size());
+  double end;
+  for (int i = 0; i < batch.size(); ++i) {
+    double B = batch.B(i);
+    double T = batch.T(i);
+    conflicts[i] = probeInterval(B,T,end) && probeConflict(WCV3D(batch.so(i),batch.vo(i),si,vi,B,end),B,T);
+  }
+}
+
 LossData WCV_tvar::WCV3D(const Vect3& so, const Velocity& vo, const Vect3& si, const Velocity& vi, double B, double T) const {
   return WCV_interval(so,vo,si,vi,B,T);
 }
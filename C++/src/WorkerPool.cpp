@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2015-2020 United States Government as represented by
+ * the National Aeronautics and Space Administration.  No copyright
+ * is claimed in the United States under Title 17, U.S.Code. All Other
+ * Rights Reserved.
+ */
+
+#include "WorkerPool.h"
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+
+namespace larcfm {
+
+struct WorkerPool::Impl {
+  std::vector<std::thread> workers;
+  std::mutex mtx;
+  std::condition_variable work_cv;
+  std::condition_variable done_cv;
+  std::atomic<bool> busy;
+  std::atomic<int> next;
+  WorkerTask* task;
+  int jobs;
+  int active;
+  unsigned long generation;
+  bool stop;
+  // First exception thrown by a job of the current task, which is rethrown by run
+  std::exception_ptr error;
+
+  Impl() : busy(false), next(0), task(NULL), jobs(0), active(0), generation(0), stop(false) {}
+
+  // Execute jobs of the current task until there are no more. If a job throws an exception,
+  // no further jobs are started and the exception is kept for the thread calling run.
+  void drain(WorkerTask* t, int n) {
+    try {
+      for (int i = next.fetch_add(1); i < n; i = next.fetch_add(1)) {
+        t->execute(i);
+      }
+    } catch (...) {
+      next = n;
+      std::lock_guard<std::mutex> lock(mtx);
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  }
+
+  void loop() {
+    unsigned long seen = 0;
+    std::unique_lock<std::mutex> lock(mtx);
+    while (true) {
+      while (!stop && generation == seen) {
+        work_cv.wait(lock);
+      }
+      if (stop) {
+        return;
+      }
+      seen = generation;
+      WorkerTask* t = task;
+      int n = jobs;
+      lock.unlock();
+      drain(t,n);
+      lock.lock();
+      if (--active == 0) {
+        done_cv.notify_one();
+      }
+    }
+  }
+};
+
+WorkerPool::WorkerPool() : impl_(NULL), threads_(1) {}
+
+WorkerPool::WorkerPool(int threads) : impl_(NULL), threads_(threads < 1 ? 1 : threads) {}
+
+WorkerPool::WorkerPool(const WorkerPool& pool) : impl_(NULL), threads_(pool.threads_) {}
+
+WorkerPool& WorkerPool::operator=(const WorkerPool& pool) {
+  if (&pool != this) {
+    setNumberOfThreads(pool.threads_);
+  }
+  return *this;
+}
+
+WorkerPool::~WorkerPool() {
+  shutdown();
+}
+
+void WorkerPool::shutdown() {
+  if (impl_ != NULL) {
+    {
+      std::lock_guard<std::mutex> lock(impl_->mtx);
+      impl_->stop = true;
+    }
+    impl_->work_cv.notify_all();
+    for (std::vector<std::thread>::iterator it = impl_->workers.begin(); it != impl_->workers.end(); ++it) {
+      it->join();
+    }
+    delete impl_;
+    impl_ = NULL;
+  }
+}
+
+void WorkerPool::setNumberOfThreads(int threads) {
+  if (threads < 1) {
+    threads = 1;
+  }
+  if (threads != threads_) {
+    shutdown();
+    threads_ = threads;
+  }
+}
+
+int WorkerPool::getNumberOfThreads() const {
+  return threads_;
+}
+
+bool WorkerPool::isParallel() const {
+  return threads_ > 1;
+}
+
+bool WorkerPool::isRunning() const {
+  return impl_ != NULL && impl_->busy;
+}
+
+void WorkerPool::run(WorkerTask& task, int n) {
+  bool expected = false;
+  if (threads_ <= 1 || n <= 1 ||
+      (impl_ != NULL && !impl_->busy.compare_exchange_strong(expected,true))) {
+    for (int i = 0; i < n; ++i) {
+      task.execute(i);
+    }
+    return;
+  }
+  if (impl_ == NULL) {
+    impl_ = new Impl();
+    impl_->busy = true;
+    for (int i = 1; i < threads_; ++i) {
+      impl_->workers.push_back(std::thread(&Impl::loop,impl_));
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lock(impl_->mtx);
+    impl_->task = &task;
+    impl_->jobs = n;
+    impl_->next = 0;
+    impl_->active = static_cast<int>(impl_->workers.size());
+    ++impl_->generation;
+  }
+  impl_->work_cv.notify_all();
+  impl_->drain(&task,n);
+  {
+    std::unique_lock<std::mutex> lock(impl_->mtx);
+    while (impl_->active > 0) {
+      impl_->done_cv.wait(lock);
+    }
+    impl_->task = NULL;
+  }
+  std::exception_ptr error = impl_->error;
+  impl_->error = std::exception_ptr();
+  impl_->busy = false;
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+}
@@ -22,11 +22,14 @@ done
 cp ./ScenarioFiles/* ./autoTestFiles
 
 testDir="./autoTestFiles"
-for file in $testDir/*
-do
-    prefix=(${file//./ }) 
-    ./daa-algorithm/C++/DaidalusAlerting --conf ./ConfigFiles/DO_365B_no_SUM.conf "."${prefix[0]}".daa"
-done
+# Optimizations of bands and alerting must not change the results of any scenario
+./daa-algorithm/C++/DaidalusUnitTest || exit 1
+./daa-algorithm/C++/DaidalusEquivalenceTest --conf ./ConfigFiles/DO_365B_no_SUM.conf $testDir/*.daa || exit 1
+# Binary files of all scenarios must have the same time steps as the text files
+./daa-algorithm/C++/DaidalusBinaryTest --conf ./ConfigFiles/DO_365B_no_SUM.conf $testDir/*.daa || exit 1
+
+# All scenarios are processed by a single run, with one job per processor
+./daa-algorithm/C++/DaidalusAlerting --conf ./ConfigFiles/DO_365B_no_SUM.conf --jobs "$(getconf _NPROCESSORS_ONLN)" $testDir/*.daa
 
 mkdir -p TestResults
 mv *.csv ./TestResults